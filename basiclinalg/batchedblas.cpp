@@ -0,0 +1,540 @@
+/* ************************************************************************/
+/* File:   batchedblas.cpp                                                */
+/* Date:   Oct. 2026                                                      */
+/* ************************************************************************/
+
+#include <bla.hpp>
+
+namespace ngbla
+{
+
+  /* ********************* kernels for double and SIMD<double> ******************* */
+
+  // with SIMD<double> every lane is an independent matrix,
+  // pivot rows are lane-wise, and row exchanges are done by blending
+
+  INLINE bool AnyZero (double a) { return a == 0; }
+  INLINE bool AnyNonPositive (double a) { return a <= 0; }
+
+  INLINE bool AnyZero (SIMD<double> a)
+  {
+    double tmp[SIMD<double>::Size()];
+    a.Store (tmp);
+    for (auto v : tmp)
+      if (v == 0) return true;
+    return false;
+  }
+
+  INLINE bool AnyNonPositive (SIMD<double> a)
+  {
+    double tmp[SIMD<double>::Size()];
+    a.Store (tmp);
+    for (auto v : tmp)
+      if (v <= 0) return true;
+    return false;
+  }
+
+  // exchange row j with row p, p >= j
+  INLINE void SwapRows (size_t n, size_t w, double * a, size_t da, size_t j, double p)
+  {
+    size_t r = size_t(p);
+    if (r != j)
+      for (size_t k = 0; k < w; k++)
+        Swap (a[j*da+k], a[r*da+k]);
+  }
+
+  INLINE void SwapRows (size_t n, size_t w, SIMD<double> * a, size_t da, size_t j, SIMD<double> p)
+  {
+    for (size_t i = j+1; i < n; i++)
+      {
+        SIMD<double> d = p - SIMD<double>(double(i));
+        if (!AnyZero(d)) continue;
+        for (size_t k = 0; k < w; k++)
+          {
+            SIMD<double> aj = a[j*da+k], ai = a[i*da+k];
+            a[j*da+k] = IfZero (d, ai, aj);
+            a[i*da+k] = IfZero (d, aj, ai);
+          }
+      }
+  }
+
+  template <typename T>
+  void MultMatMatKernel (size_t ha, size_t wa, size_t wb,
+                         T * pa, size_t da, T * pb, size_t db, T * pc, size_t dc, bool add)
+  {
+    for (size_t i = 0; i < ha; i++)
+      for (size_t j = 0; j < wb; j++)
+        {
+          T sum = add ? pc[i*dc+j] : T(0.0);
+          for (size_t k = 0; k < wa; k++)
+            sum += pa[i*da+k] * pb[k*db+j];
+          pc[i*dc+j] = sum;
+        }
+  }
+
+  template <typename T>
+  void LUFactorKernel (size_t n, T * a, size_t da, T * piv)
+  {
+    for (size_t j = 0; j < n; j++)
+      {
+        T maxval = fabs(a[j*da+j]);
+        T p = T(double(j));
+        for (size_t i = j+1; i < n; i++)
+          {
+            T v = fabs(a[i*da+j]);
+            p = IfPos (v-maxval, T(double(i)), p);
+            maxval = IfPos (v-maxval, v, maxval);
+          }
+        if (AnyZero (maxval))
+          throw Exception ("BatchedLUFactor: matrix singular");
+        piv[j] = p;
+        SwapRows (n, n, a, da, j, p);
+
+        T inv = 1.0 / a[j*da+j];
+        for (size_t i = j+1; i < n; i++)
+          {
+            T lij = a[i*da+j] * inv;
+            a[i*da+j] = lij;
+            for (size_t k = j+1; k < n; k++)
+              a[i*da+k] -= lij * a[j*da+k];
+          }
+      }
+  }
+
+  template <typename T>
+  void LUSolveKernel (size_t n, T * a, size_t da, T * piv, size_t w, T * b, size_t db)
+  {
+    for (size_t j = 0; j < n; j++)
+      SwapRows (n, w, b, db, j, piv[j]);
+
+    for (size_t i = 0; i < n; i++)
+      for (size_t k = 0; k < i; k++)
+        {
+          T lik = a[i*da+k];
+          for (size_t l = 0; l < w; l++)
+            b[i*db+l] -= lik * b[k*db+l];
+        }
+
+    for (size_t i = n; i-- > 0; )
+      {
+        for (size_t k = i+1; k < n; k++)
+          {
+            T uik = a[i*da+k];
+            for (size_t l = 0; l < w; l++)
+              b[i*db+l] -= uik * b[k*db+l];
+          }
+        T inv = 1.0 / a[i*da+i];
+        for (size_t l = 0; l < w; l++)
+          b[i*db+l] *= inv;
+      }
+  }
+
+  template <typename T>
+  void CholeskyFactorKernel (size_t n, T * a, size_t da)
+  {
+    for (size_t j = 0; j < n; j++)
+      {
+        T d = a[j*da+j];
+        for (size_t k = 0; k < j; k++)
+          d -= a[j*da+k] * a[j*da+k];
+        if (AnyNonPositive (d))
+          throw Exception ("BatchedCholeskyFactor: matrix not positive definite");
+        T ljj = sqrt(d);
+        a[j*da+j] = ljj;
+        T inv = 1.0 / ljj;
+        for (size_t i = j+1; i < n; i++)
+          {
+            T sum = a[i*da+j];
+            for (size_t k = 0; k < j; k++)
+              sum -= a[i*da+k] * a[j*da+k];
+            a[i*da+j] = sum * inv;
+          }
+      }
+  }
+
+  template <typename T>
+  void CholeskySolveKernel (size_t n, T * a, size_t da, size_t w, T * b, size_t db)
+  {
+    for (size_t i = 0; i < n; i++)
+      {
+        for (size_t k = 0; k < i; k++)
+          {
+            T lik = a[i*da+k];
+            for (size_t l = 0; l < w; l++)
+              b[i*db+l] -= lik * b[k*db+l];
+          }
+        T inv = 1.0 / a[i*da+i];
+        for (size_t l = 0; l < w; l++)
+          b[i*db+l] *= inv;
+      }
+    for (size_t i = n; i-- > 0; )
+      {
+        T inv = 1.0 / a[i*da+i];
+        for (size_t l = 0; l < w; l++)
+          b[i*db+l] *= inv;
+        for (size_t k = 0; k < i; k++)
+          {
+            T lik = a[i*da+k];
+            for (size_t l = 0; l < w; l++)
+              b[k*db+l] -= lik * b[i*db+l];
+          }
+      }
+  }
+
+
+
+  /* ************************** packing SIMD lanes ************************ */
+
+  constexpr size_t SW = SIMD<double>::Size();
+
+  template <typename TBATCH>
+  class SIMDBatchPack
+  {
+    const TBATCH & mats;
+    size_t h, w;
+    double * ptr[SW];
+    size_t dist[SW];
+    bool valid[SW];
+  public:
+    SIMDBatchPack (const TBATCH & amats, size_t k0)
+      : mats(amats)
+    {
+      h = mats.Size() ? mats[0].Height() : 0;
+      w = mats.Size() ? mats[0].Width() : 0;
+      for (size_t l = 0; l < SW; l++)
+        {
+          valid[l] = k0+l < mats.Size();
+          if (valid[l])
+            {
+              ptr[l] = mats[k0+l].Data();
+              dist[l] = mats[k0+l].Dist();
+            }
+        }
+    }
+
+    // lanes without a matrix get the identity, or zero
+    void Pack (SIMD<double> * p, bool identity = true) const
+    {
+      double tmp[SW];
+      for (size_t i = 0; i < h; i++)
+        for (size_t j = 0; j < w; j++)
+          {
+            for (size_t l = 0; l < SW; l++)
+              tmp[l] = valid[l] ? ptr[l][i*dist[l]+j] : ((identity && i == j) ? 1.0 : 0.0);
+            p[i*w+j] = SIMD<double>(&tmp[0]);
+          }
+    }
+
+    void Unpack (SIMD<double> * p) const
+    {
+      double tmp[SW];
+      for (size_t i = 0; i < h; i++)
+        for (size_t j = 0; j < w; j++)
+          {
+            p[i*w+j].Store (tmp);
+            for (size_t l = 0; l < SW; l++)
+              if (valid[l])
+                ptr[l][i*dist[l]+j] = tmp[l];
+          }
+    }
+  };
+
+  template <typename TBATCH>
+  void CheckBatch (const TBATCH & mats, size_t n, const char * name)
+  {
+    if (mats.Size() != n)
+      throw Exception (string(name) + ": batches of different sizes");
+    for (size_t k = 1; k < n; k++)
+      if (mats[k].Height() != mats[0].Height() || mats[k].Width() != mats[0].Width())
+        throw Exception (string(name) + ": matrices of different sizes");
+  }
+
+  INLINE bool UseSIMD (size_t h, size_t w)
+  {
+    return h < batched_simd_size && w < batched_simd_size;
+  }
+
+
+
+  /* *************************** batched operations *********************** */
+
+  template <typename TBATCH>
+  void T_BatchedMultMatMat (const TBATCH & a, const TBATCH & b, const TBATCH & c, bool add)
+  {
+    size_t n = a.Size();
+    CheckBatch (a, n, "BatchedMultMatMat");
+    CheckBatch (b, n, "BatchedMultMatMat");
+    CheckBatch (c, n, "BatchedMultMatMat");
+    if (n == 0) return;
+    size_t ha = a[0].Height(), wa = a[0].Width(), wb = b[0].Width();
+    if (b[0].Height() != wa || c[0].Height() != ha || c[0].Width() != wb)
+      throw Exception ("BatchedMultMatMat: matrix sizes don't fit");
+
+    if (UseSIMD (ha, wa) && UseSIMD (wa, wb))
+      {
+        SIMD<double> ma[batched_simd_size*batched_simd_size];
+        SIMD<double> mb[batched_simd_size*batched_simd_size];
+        SIMD<double> mc[batched_simd_size*batched_simd_size];
+        for (size_t k = 0; k < n; k += SW)
+          {
+            SIMDBatchPack<TBATCH> pa(a, k), pb(b, k), pc(c, k);
+            pa.Pack (ma, false);
+            pb.Pack (mb, false);
+            if (add) pc.Pack (mc, false);
+            MultMatMatKernel (ha, wa, wb, ma, wa, mb, wb, mc, wb, add);
+            pc.Unpack (mc);
+          }
+        return;
+      }
+
+    for (size_t k = 0; k < n; k++)
+      if (add)
+        AddAB (a[k], b[k], c[k]);
+      else
+        MultMatMat (a[k], b[k], c[k]);
+  }
+
+  template <typename TBATCH>
+  void T_BatchedAddABt (const TBATCH & a, const TBATCH & b, const TBATCH & c)
+  {
+    size_t n = a.Size();
+    CheckBatch (a, n, "BatchedAddABt");
+    CheckBatch (b, n, "BatchedAddABt");
+    CheckBatch (c, n, "BatchedAddABt");
+    if (n == 0) return;
+    size_t ha = a[0].Height(), wa = a[0].Width(), hb = b[0].Height();
+    if (b[0].Width() != wa || c[0].Height() != ha || c[0].Width() != hb)
+      throw Exception ("BatchedAddABt: matrix sizes don't fit");
+
+    if (UseSIMD (ha, wa) && UseSIMD (hb, wa))
+      {
+        SIMD<double> ma[batched_simd_size*batched_simd_size];
+        SIMD<double> mb[batched_simd_size*batched_simd_size];
+        SIMD<double> mc[batched_simd_size*batched_simd_size];
+        for (size_t k = 0; k < n; k += SW)
+          {
+            SIMDBatchPack<TBATCH> pa(a, k), pb(b, k), pc(c, k);
+            pa.Pack (ma, false);
+            pb.Pack (mb, false);
+            pc.Pack (mc, false);
+            for (size_t i = 0; i < ha; i++)
+              for (size_t j = 0; j < hb; j++)
+                {
+                  SIMD<double> sum = mc[i*hb+j];
+                  for (size_t l = 0; l < wa; l++)
+                    sum += ma[i*wa+l] * mb[j*wa+l];
+                  mc[i*hb+j] = sum;
+                }
+            pc.Unpack (mc);
+          }
+        return;
+      }
+
+    for (size_t k = 0; k < n; k++)
+      AddABt (a[k], b[k], c[k]);
+  }
+
+  template <typename TBATCH>
+  void T_BatchedLUFactor (const TBATCH & a, FlatArray<int> pivots)
+  {
+    size_t n = a.Size();
+    CheckBatch (a, n, "BatchedLUFactor");
+    if (n == 0) return;
+    size_t h = a[0].Height();
+    if (a[0].Width() != h)
+      throw Exception ("BatchedLUFactor: matrices must be square");
+    if (pivots.Size() < n*h)
+      throw Exception ("BatchedLUFactor: need Height() pivots per matrix");
+
+    if (UseSIMD (h, h))
+      {
+        SIMD<double> ma[batched_simd_size*batched_simd_size];
+        SIMD<double> piv[batched_simd_size];
+        double tmp[SW];
+        for (size_t k = 0; k < n; k += SW)
+          {
+            SIMDBatchPack<TBATCH> pa(a, k);
+            pa.Pack (ma);
+            LUFactorKernel (h, ma, h, piv);
+            pa.Unpack (ma);
+            for (size_t j = 0; j < h; j++)
+              {
+                piv[j].Store (tmp);
+                for (size_t l = 0; l < SW && k+l < n; l++)
+                  pivots[(k+l)*h+j] = int(tmp[l]);
+              }
+          }
+        return;
+      }
+
+    // larger matrices: blocked factorization one by one
+    for (size_t k = 0; k < n; k++)
+      LUFactor (a[k], pivots.Range(k*h, (k+1)*h));
+  }
+
+  template <typename TBATCH>
+  void T_BatchedLUSolve (const TBATCH & lu, FlatArray<int> pivots, const TBATCH & b)
+  {
+    size_t n = lu.Size();
+    CheckBatch (lu, n, "BatchedLUSolve");
+    CheckBatch (b, n, "BatchedLUSolve");
+    if (n == 0) return;
+    size_t h = lu[0].Height(), w = b[0].Width();
+    if (b[0].Height() != h)
+      throw Exception ("BatchedLUSolve: matrix sizes don't fit");
+
+    if (UseSIMD (h, h) && UseSIMD (h, w))
+      {
+        SIMD<double> ma[batched_simd_size*batched_simd_size];
+        SIMD<double> mb[batched_simd_size*batched_simd_size];
+        SIMD<double> piv[batched_simd_size];
+        double tmp[SW];
+        for (size_t k = 0; k < n; k += SW)
+          {
+            SIMDBatchPack<TBATCH> pa(lu, k), pb(b, k);
+            pa.Pack (ma);
+            pb.Pack (mb, false);
+            for (size_t j = 0; j < h; j++)
+              {
+                for (size_t l = 0; l < SW; l++)
+                  tmp[l] = (k+l < n) ? pivots[(k+l)*h+j] : j;
+                piv[j] = SIMD<double> (&tmp[0]);
+              }
+            LUSolveKernel (h, ma, h, piv, w, mb, w);
+            pb.Unpack (mb);
+          }
+        return;
+      }
+
+    for (size_t k = 0; k < n; k++)
+      LUSolve (lu[k], pivots.Range(k*h, (k+1)*h), b[k]);
+  }
+
+  template <typename TBATCH>
+  void T_BatchedCholeskyFactor (const TBATCH & a)
+  {
+    size_t n = a.Size();
+    CheckBatch (a, n, "BatchedCholeskyFactor");
+    if (n == 0) return;
+    size_t h = a[0].Height();
+    if (a[0].Width() != h)
+      throw Exception ("BatchedCholeskyFactor: matrices must be square");
+
+    if (UseSIMD (h, h))
+      {
+        SIMD<double> ma[batched_simd_size*batched_simd_size];
+        for (size_t k = 0; k < n; k += SW)
+          {
+            SIMDBatchPack<TBATCH> pa(a, k);
+            pa.Pack (ma);
+            CholeskyFactorKernel (h, ma, h);
+            pa.Unpack (ma);
+          }
+        return;
+      }
+
+    // larger matrices: blocked factorization one by one
+    for (size_t k = 0; k < n; k++)
+      CholeskyFactor (a[k]);
+  }
+
+  template <typename TBATCH>
+  void T_BatchedCholeskySolve (const TBATCH & l, const TBATCH & b)
+  {
+    size_t n = l.Size();
+    CheckBatch (l, n, "BatchedCholeskySolve");
+    CheckBatch (b, n, "BatchedCholeskySolve");
+    if (n == 0) return;
+    size_t h = l[0].Height(), w = b[0].Width();
+    if (b[0].Height() != h)
+      throw Exception ("BatchedCholeskySolve: matrix sizes don't fit");
+
+    if (UseSIMD (h, h) && UseSIMD (h, w))
+      {
+        SIMD<double> ma[batched_simd_size*batched_simd_size];
+        SIMD<double> mb[batched_simd_size*batched_simd_size];
+        for (size_t k = 0; k < n; k += SW)
+          {
+            SIMDBatchPack<TBATCH> pa(l, k), pb(b, k);
+            pa.Pack (ma);
+            pb.Pack (mb, false);
+            CholeskySolveKernel (h, ma, h, w, mb, w);
+            pb.Unpack (mb);
+          }
+        return;
+      }
+
+    for (size_t k = 0; k < n; k++)
+      CholeskySolve (l[k], b[k]);
+  }
+
+  template <typename TBATCH>
+  void T_BatchedCalcInverse (const TBATCH & a)
+  {
+    size_t n = a.Size();
+    CheckBatch (a, n, "BatchedCalcInverse");
+    if (n == 0) return;
+    size_t h = a[0].Height();
+    if (a[0].Width() != h)
+      throw Exception ("BatchedCalcInverse: matrices must be square");
+
+    if (UseSIMD (h, h))
+      {
+        SIMD<double> ma[batched_simd_size*batched_simd_size];
+        SIMD<double> minv[batched_simd_size*batched_simd_size];
+        SIMD<double> piv[batched_simd_size];
+        for (size_t k = 0; k < n; k += SW)
+          {
+            SIMDBatchPack<TBATCH> pa(a, k);
+            pa.Pack (ma);
+            LUFactorKernel (h, ma, h, piv);
+            for (size_t i = 0; i < h; i++)
+              for (size_t j = 0; j < h; j++)
+                minv[i*h+j] = (i == j) ? 1.0 : 0.0;
+            LUSolveKernel (h, ma, h, piv, h, minv, h);
+            pa.Unpack (minv);
+          }
+        return;
+      }
+
+    for (size_t k = 0; k < n; k++)
+      LUInverse (a[k]);
+  }
+
+
+
+  void BatchedMultMatMat (BatchedSliceMatrix<> a, BatchedSliceMatrix<> b, BatchedSliceMatrix<> c)
+  { T_BatchedMultMatMat (a, b, c, false); }
+  void BatchedMultMatMat (FlatArray<SliceMatrix<>> a, FlatArray<SliceMatrix<>> b, FlatArray<SliceMatrix<>> c)
+  { T_BatchedMultMatMat (a, b, c, false); }
+
+  void BatchedAddABt (BatchedSliceMatrix<> a, BatchedSliceMatrix<> b, BatchedSliceMatrix<> c)
+  { T_BatchedAddABt (a, b, c); }
+  void BatchedAddABt (FlatArray<SliceMatrix<>> a, FlatArray<SliceMatrix<>> b, FlatArray<SliceMatrix<>> c)
+  { T_BatchedAddABt (a, b, c); }
+
+  void BatchedLUFactor (BatchedSliceMatrix<> a, FlatArray<int> pivots)
+  { T_BatchedLUFactor (a, pivots); }
+  void BatchedLUFactor (FlatArray<SliceMatrix<>> a, FlatArray<int> pivots)
+  { T_BatchedLUFactor (a, pivots); }
+
+  void BatchedLUSolve (BatchedSliceMatrix<> lu, FlatArray<int> pivots, BatchedSliceMatrix<> b)
+  { T_BatchedLUSolve (lu, pivots, b); }
+  void BatchedLUSolve (FlatArray<SliceMatrix<>> lu, FlatArray<int> pivots, FlatArray<SliceMatrix<>> b)
+  { T_BatchedLUSolve (lu, pivots, b); }
+
+  void BatchedCholeskyFactor (BatchedSliceMatrix<> a)
+  { T_BatchedCholeskyFactor (a); }
+  void BatchedCholeskyFactor (FlatArray<SliceMatrix<>> a)
+  { T_BatchedCholeskyFactor (a); }
+
+  void BatchedCholeskySolve (BatchedSliceMatrix<> l, BatchedSliceMatrix<> b)
+  { T_BatchedCholeskySolve (l, b); }
+  void BatchedCholeskySolve (FlatArray<SliceMatrix<>> l, FlatArray<SliceMatrix<>> b)
+  { T_BatchedCholeskySolve (l, b); }
+
+  void BatchedCalcInverse (BatchedSliceMatrix<> a)
+  { T_BatchedCalcInverse (a); }
+  void BatchedCalcInverse (FlatArray<SliceMatrix<>> a)
+  { T_BatchedCalcInverse (a); }
+}
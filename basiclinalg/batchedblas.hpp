@@ -0,0 +1,83 @@
+#ifndef FILE_BATCHEDBLAS
+#define FILE_BATCHEDBLAS
+
+/* ************************************************************************/
+/* File:   batchedblas.hpp                                                */
+/* Date:   Oct. 2026                                                      */
+/* ************************************************************************/
+
+/*
+  Batches of many equally sized small matrices.
+
+  Below batched_simd_size, SIMD<double>::Size() matrices are packed into
+  one matrix of SIMD<double> and processed together, one matrix per lane.
+  Larger matrices go through the usual ngblas kernels one by one.
+
+  A batch is either strided (BatchedSliceMatrix), or an array of
+  SliceMatrix of the same dimensions.
+ */
+
+namespace ngbla
+{
+
+  /// matrices are packed across SIMD lanes if all dimensions are below
+  constexpr size_t batched_simd_size = 16;
+
+  /// nbatch matrices of equal size, matrix k starts at data + k*stride
+  template <typename T = double>
+  class BatchedSliceMatrix
+  {
+    size_t n, h, w, dist, stride;
+    T * data;
+  public:
+    BatchedSliceMatrix (size_t an, size_t ah, size_t aw, size_t adist, size_t astride, T * adata)
+      : n(an), h(ah), w(aw), dist(adist), stride(astride), data(adata) { ; }
+    /// consecutive, row-major matrices
+    BatchedSliceMatrix (size_t an, size_t ah, size_t aw, T * adata)
+      : n(an), h(ah), w(aw), dist(aw), stride(ah*aw), data(adata) { ; }
+
+    size_t Size() const { return n; }
+    size_t Height() const { return h; }
+    size_t Width() const { return w; }
+    size_t Dist() const { return dist; }
+    size_t Stride() const { return stride; }
+    T * Data() const { return data; }
+
+    SliceMatrix<T> operator[] (size_t k) const
+    { return SliceMatrix<T> (h, w, dist, data+k*stride); }
+  };
+
+
+  /// c[k] = a[k] * b[k]
+  extern NGS_DLL_HEADER void BatchedMultMatMat (BatchedSliceMatrix<> a, BatchedSliceMatrix<> b, BatchedSliceMatrix<> c);
+  extern NGS_DLL_HEADER void BatchedMultMatMat (FlatArray<SliceMatrix<>> a, FlatArray<SliceMatrix<>> b, FlatArray<SliceMatrix<>> c);
+
+  /// c[k] += a[k] * b[k]^T
+  extern NGS_DLL_HEADER void BatchedAddABt (BatchedSliceMatrix<> a, BatchedSliceMatrix<> b, BatchedSliceMatrix<> c);
+  extern NGS_DLL_HEADER void BatchedAddABt (FlatArray<SliceMatrix<>> a, FlatArray<SliceMatrix<>> b, FlatArray<SliceMatrix<>> c);
+
+  /**
+     LU factorization with partial pivoting, in place.
+     L is unit lower triangular, row j was exchanged with row pivots[k*n+j]
+   */
+  extern NGS_DLL_HEADER void BatchedLUFactor (BatchedSliceMatrix<> a, FlatArray<int> pivots);
+  extern NGS_DLL_HEADER void BatchedLUFactor (FlatArray<SliceMatrix<>> a, FlatArray<int> pivots);
+
+  /// solves a[k] x = b[k] with factors from BatchedLUFactor, b is overwritten
+  extern NGS_DLL_HEADER void BatchedLUSolve (BatchedSliceMatrix<> lu, FlatArray<int> pivots, BatchedSliceMatrix<> b);
+  extern NGS_DLL_HEADER void BatchedLUSolve (FlatArray<SliceMatrix<>> lu, FlatArray<int> pivots, FlatArray<SliceMatrix<>> b);
+
+  /// Cholesky factor L in the lower triangle, the upper triangle is not touched
+  extern NGS_DLL_HEADER void BatchedCholeskyFactor (BatchedSliceMatrix<> a);
+  extern NGS_DLL_HEADER void BatchedCholeskyFactor (FlatArray<SliceMatrix<>> a);
+
+  /// solves L L^T x = b[k], b is overwritten
+  extern NGS_DLL_HEADER void BatchedCholeskySolve (BatchedSliceMatrix<> l, BatchedSliceMatrix<> b);
+  extern NGS_DLL_HEADER void BatchedCholeskySolve (FlatArray<SliceMatrix<>> l, FlatArray<SliceMatrix<>> b);
+
+  /// in place inverse
+  extern NGS_DLL_HEADER void BatchedCalcInverse (BatchedSliceMatrix<> a);
+  extern NGS_DLL_HEADER void BatchedCalcInverse (FlatArray<SliceMatrix<>> a);
+}
+
+#endif
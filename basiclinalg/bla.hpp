@@ -76,6 +76,7 @@ namespace ngcore
 #include "matrix.hpp"
 #include "avector.hpp"
 #include "ngblas.hpp"
+#include "batchedblas.hpp"
 #include "cholesky.hpp"
 #include "symmetricmatrix.hpp"
 #include "bandmatrix.hpp"
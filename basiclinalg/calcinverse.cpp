@@ -196,10 +196,11 @@ namespace ngbla
 #ifdef LAPACK
     if (il == INVERSE_LIB::INV_LAPACK)
       LapackInverse(inv);
-    else if (il == INVERSE_LIB::INV_CHOOSE && inv.Height() >= 50)
-      LapackInverse(inv);        
     else
 #endif
+    if (il == INVERSE_LIB::INV_CHOOSE && inv.Height() >= 50)
+      LUInverse(inv);
+    else
       T_CalcInverse (inv);
   }
 
@@ -0,0 +1,573 @@
+/* ************************************************************************/
+/* File:   denseeigen.cpp                                                 */
+/* Date:   Oct. 2026                                                      */
+/* ************************************************************************/
+
+/*
+  Eigenvalues and eigenvectors of dense symmetric matrices.
+
+  Blocked Householder reduction to tridiagonal form: the reflectors of
+  a panel are accumulated, the trailing matrix is updated by two SubABt.
+  The tridiagonal problem is solved by divide and conquer, the merged
+  eigenvectors come from MultMatMat. The back transformation applies
+  blocks of reflectors by MultAtB / SubAB.
+
+  The generalized problem A x = lam B x is reduced by the Cholesky
+  factor of B.
+ */
+
+#include <bla.hpp>
+
+namespace ngbla
+{
+  // columns per panel of the tridiagonal reduction
+  constexpr size_t tridiag_block_size = 32;
+  // below that, implicit QL
+  constexpr size_t tridiag_base_size = 32;
+  // divide and conquer subproblems above that run in parallel
+  constexpr size_t tridiag_par_size = 128;
+
+
+  /*
+    a = Q T Q^T, T = tridiag(e, d, e), Q = H_0 ... H_{n-2}.
+    The reflector H_c = I - tau(c) v v^T of column c is stored below the
+    diagonal, a(c+1,c) = 1.
+   */
+  static void Tridiagonalize (SliceMatrix<> a, FlatVector<> d, FlatVector<> e, FlatVector<> tau)
+  {
+    size_t n = a.Height();
+    Vector<> vc(n), y(n), hvw(tridiag_block_size), hwv(tridiag_block_size);
+
+    for (size_t k = 0; k+1 < n; k += tridiag_block_size)
+      {
+        size_t nb = min2(tridiag_block_size, n-1-k);
+        // the panel's updates a <- a - v w^T - w v^T are delayed
+        Matrix<> v(n, nb), w(n, nb);
+        v = 0.0;
+        w = 0.0;
+
+        for (size_t i = 0; i < nb; i++)
+          {
+            size_t c = k+i;
+
+            // pending updates of column c
+            for (size_t r = c; r < n; r++)
+              {
+                double sum = 0;
+                for (size_t j = 0; j < i; j++)
+                  sum += v(r,j) * w(c,j) + w(r,j) * v(c,j);
+                a(r,c) -= sum;
+              }
+            d(c) = a(c,c);
+
+            // reflector for a(c+1:n, c)
+            double alpha = a(c+1,c);
+            double xnorm = 0;
+            for (size_t r = c+2; r < n; r++)
+              xnorm += sqr(a(r,c));
+            xnorm = sqrt(xnorm);
+
+            size_t n2 = n-c-1;
+            FlatVector<> vi = vc.Range(0, n2);
+            if (xnorm == 0)
+              {
+                tau(c) = 0;
+                e(c) = alpha;
+                vi = 0.0;
+                vi(0) = 1;
+              }
+            else
+              {
+                double beta = (alpha >= 0) ? -hypot(alpha, xnorm) : hypot(alpha, xnorm);
+                tau(c) = (beta-alpha) / beta;
+                e(c) = beta;
+                double scal = 1.0 / (alpha-beta);
+                vi(0) = 1;
+                for (size_t r = 1; r < n2; r++)
+                  vi(r) = scal * a(c+1+r,c);
+              }
+            for (size_t r = 0; r < n2; r++)
+              a(c+1+r,c) = v(c+1+r,i) = vi(r);
+            if (tau(c) == 0) continue;
+
+            // w = tau (A22 - v w^T - w v^T) vi,  w -= tau/2 (w,vi) vi
+            FlatVector<> yi = y.Range(0, n2);
+            MultMatVec (a.Rows(c+1, n).Cols(c+1, n), vi, yi);
+            for (size_t j = 0; j < i; j++)
+              {
+                double sw = 0, sv = 0;
+                for (size_t r = 0; r < n2; r++)
+                  {
+                    sw += w(c+1+r,j) * vi(r);
+                    sv += v(c+1+r,j) * vi(r);
+                  }
+                hvw(j) = sw;
+                hwv(j) = sv;
+              }
+            for (size_t r = 0; r < n2; r++)
+              {
+                double sum = 0;
+                for (size_t j = 0; j < i; j++)
+                  sum += v(c+1+r,j) * hvw(j) + w(c+1+r,j) * hwv(j);
+                yi(r) -= sum;
+              }
+            yi *= tau(c);
+            double gamma = -0.5 * tau(c) * InnerProduct (yi, vi);
+            for (size_t r = 0; r < n2; r++)
+              w(c+1+r,i) = yi(r) + gamma * vi(r);
+          }
+
+        // rank-2nb update of the trailing matrix
+        size_t next = k+nb;
+        SubABt (v.Rows(next, n), w.Rows(next, n), a.Rows(next, n).Cols(next, n));
+        SubABt (w.Rows(next, n), v.Rows(next, n), a.Rows(next, n).Cols(next, n));
+      }
+    d(n-1) = a(n-1,n-1);
+  }
+
+
+  // q <- H_0 H_1 ... H_{n-2} q, by blocks I - V T V^T of reflectors
+  static void ApplyReflectors (SliceMatrix<> a, FlatVector<> tau, SliceMatrix<> q)
+  {
+    size_t n = a.Height();
+    size_t nblocks = (n-1 + tridiag_block_size-1) / tridiag_block_size;
+    Vector<> hv(tridiag_block_size);
+
+    for (size_t bl = nblocks; bl-- > 0; )
+      {
+        size_t k = bl * tridiag_block_size;
+        size_t nb = min2(tridiag_block_size, n-1-k);
+        size_t h = n-k-1;
+
+        Matrix<> v(h, nb);
+        v = 0.0;
+        for (size_t i = 0; i < nb; i++)
+          for (size_t r = i; r < h; r++)
+            v(r,i) = a(k+1+r, k+i);
+
+        // upper triangular T, columnwise: T(0:i,i) = -tau_i T(0:i,0:i) V(:,0:i)^T v_i
+        Matrix<> t(nb, nb);
+        t = 0.0;
+        for (size_t i = 0; i < nb; i++)
+          {
+            for (size_t j = 0; j < i; j++)
+              {
+                double sum = 0;
+                for (size_t r = i; r < h; r++)
+                  sum += v(r,j) * v(r,i);
+                hv(j) = -tau(k+i) * sum;
+              }
+            for (size_t j = 0; j < i; j++)
+              {
+                double sum = 0;
+                for (size_t l = j; l < i; l++)
+                  sum += t(j,l) * hv(l);
+                t(j,i) = sum;
+              }
+            t(i,i) = tau(k+i);
+          }
+
+        SliceMatrix<> qk = q.Rows(k+1, n);
+        Matrix<> vtq(nb, q.Width()), tvtq(nb, q.Width());
+        MultAtB (v, qk, vtq);
+        MultMatMat (t, vtq, tvtq);
+        SubAB (v, tvtq, qk);
+      }
+  }
+
+
+  // sort eigenvalues ascending, together with the columns of q
+  static void SortEigenPairs (FlatVector<> d, SliceMatrix<> q)
+  {
+    size_t n = d.Size();
+    for (size_t i = 0; i < n; i++)
+      {
+        size_t imin = i;
+        for (size_t j = i+1; j < n; j++)
+          if (d(j) < d(imin)) imin = j;
+        if (imin != i)
+          {
+            Swap (d(i), d(imin));
+            for (size_t r = 0; r < q.Height(); r++)
+              Swap (q(r,i), q(r,imin));
+          }
+      }
+  }
+
+  // implicit QL with Wilkinson shifts, q = eigenvectors
+  static void TridiagonalQL (FlatVector<> d, FlatVector<> e, SliceMatrix<> q)
+  {
+    int n = d.Size();
+    ArrayMem<double,tridiag_base_size> ee(n);
+    for (int i = 0; i+1 < n; i++)
+      ee[i] = e(i);
+    if (n > 0) ee[n-1] = 0;
+
+    q = 0.0;
+    for (int i = 0; i < n; i++)
+      q(i,i) = 1;
+
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+    for (int l = 0; l < n; l++)
+      for (int iter = 0; ; iter++)
+        {
+          int m = l;
+          for ( ; m < n-1; m++)
+            if (fabs(ee[m]) <= eps * (fabs(d(m)) + fabs(d(m+1))))
+              break;
+          if (m == l) break;
+          if (iter == 60)
+            throw Exception ("SymmetricEigenSystem: QL iteration did not converge");
+
+          double g = (d(l+1)-d(l)) / (2*ee[l]);
+          double r = hypot(g, 1.0);
+          g = d(m)-d(l) + ee[l] / (g + (g >= 0 ? r : -r));
+          double s = 1, c = 1, p = 0;
+          int i = m-1;
+          for ( ; i >= l; i--)
+            {
+              double f = s*ee[i], b = c*ee[i];
+              r = hypot(f, g);
+              ee[i+1] = r;
+              if (r == 0)
+                {
+                  d(i+1) -= p;
+                  ee[m] = 0;
+                  break;
+                }
+              s = f/r;
+              c = g/r;
+              g = d(i+1)-p;
+              r = (d(i)-g)*s + 2*c*b;
+              p = s*r;
+              d(i+1) = g+p;
+              g = c*r-b;
+              for (int k = 0; k < n; k++)
+                {
+                  double qk1 = q(k,i+1);
+                  q(k,i+1) = s*q(k,i) + c*qk1;
+                  q(k,i) = c*q(k,i) - s*qk1;
+                }
+            }
+          if (r == 0 && i >= l) continue;
+          d(l) -= p;
+          ee[l] = g;
+          ee[m] = 0;
+        }
+
+    SortEigenPairs (d, q);
+  }
+
+
+  /*
+    root of the secular equation  1 + rho sum_j z_j^2 / (d_j - lam) = 0
+    in (d_i, d_{i+1}), or above d_{k-1} for i = k-1.
+    lam = d_orig + mu, with orig = i or i+1 the closer pole, such that
+    d_j - lam = (d_j - d_orig) - mu is accurate.
+   */
+  static void SolveSecular (FlatVector<> d, FlatVector<> z, double rho, size_t i,
+                            size_t & orig, double & mu)
+  {
+    size_t k = d.Size();
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+
+    auto secular = [&] (double lam0, double mu)
+      {
+        double f = 1;
+        for (size_t j = 0; j < k; j++)
+          f += rho * sqr(z(j)) / ((d(j)-lam0) - mu);
+        return f;
+      };
+
+    double lo, hi;
+    if (i+1 < k)
+      {
+        double gap = d(i+1)-d(i);
+        if (secular (d(i), gap/2) >= 0)
+          { orig = i; lo = 0; hi = gap/2; }
+        else
+          { orig = i+1; lo = -gap/2; hi = 0; }
+      }
+    else
+      {
+        double zz = 0;
+        for (size_t j = 0; j < k; j++)
+          zz += sqr(z(j));
+        orig = i; lo = 0; hi = rho*zz;
+      }
+
+    double dorig = d(orig);
+    mu = (lo+hi)/2;
+    for (int iter = 0; iter < 200; iter++)
+      {
+        // psi: poles up to i, phi: poles above i
+        double psi = 0, dpsi = 0, phi = 0, dphi = 0;
+        for (size_t j = 0; j < k; j++)
+          {
+            double delta = (d(j)-dorig) - mu;
+            double t = rho * sqr(z(j)) / delta;
+            if (j <= i)
+              { psi += t; dpsi += t/delta; }
+            else
+              { phi += t; dphi += t/delta; }
+          }
+        double f = 1 + psi + phi;
+        if (f < 0) lo = mu; else hi = mu;
+        if (fabs(f) <= 8*eps*k * (1 + fabs(psi) + fabs(phi)))
+          break;
+
+        // f is approximated by c + s / (di - x) + S / (di1 - x)
+        double di = (d(i)-dorig) - mu;
+        double x;
+        bool ok;
+        if (i+1 < k)
+          {
+            double di1 = (d(i+1)-dorig) - mu;
+            double s = di*di*dpsi, S = di1*di1*dphi;
+            double c = f - s/di - S/di1;
+            double bq = -(c*(di+di1) + s + S);
+            double cq = di*di1*f;
+            double disc = bq*bq - 4*c*cq;
+            ok = disc >= 0;
+            if (ok)
+              {
+                double qq = -0.5 * (bq + (bq >= 0 ? sqrt(disc) : -sqrt(disc)));
+                double x1 = (c != 0) ? qq/c : hi-mu+1;
+                double x2 = (qq != 0) ? cq/qq : hi-mu+1;
+                x = (mu+x1 > lo && mu+x1 < hi) ? x1 : x2;
+              }
+          }
+        else
+          {
+            double s = di*di*dpsi;
+            double c = f - s/di;
+            ok = c != 0;
+            if (ok) x = di + s/c;
+          }
+
+        double munew = (lo+hi)/2;
+        if (ok && mu+x > lo && mu+x < hi)
+          munew = mu+x;
+        if (munew == mu || hi-lo <= 2*eps*max2(fabs(lo), fabs(hi)))
+          break;
+        mu = munew;
+      }
+  }
+
+
+  /*
+    d, q hold the eigensystems of the two halves [0,m) and [m,n),
+    merge with the coupling  beta (e_{m-1}+s e_m)(e_{m-1}+s e_m)^T
+   */
+  static void MergeRankOne (FlatVector<> d, SliceMatrix<> q, size_t m, double beta)
+  {
+    size_t n = d.Size();
+    constexpr double eps = std::numeric_limits<double>::epsilon();
+
+    double rho = fabs(beta);
+    Vector<> z(n);
+    for (size_t i = 0; i < m; i++)
+      z(i) = q(m-1,i);
+    for (size_t i = m; i < n; i++)
+      z(i) = (beta >= 0) ? q(m,i) : -q(m,i);
+    double znorm = L2Norm(z);
+    rho *= znorm*znorm;
+    z /= znorm;
+
+    // ascending order of the poles
+    Array<int> order(n);
+    for (size_t i = 0; i < n; i++)
+      order[i] = i;
+    QuickSort (order, [&] (int i, int j) { return d(i) < d(j); });
+
+    double dmax = 0, zmax = 0;
+    for (size_t i = 0; i < n; i++)
+      {
+        dmax = max2(dmax, fabs(d(i)));
+        zmax = max2(zmax, fabs(z(i)));
+      }
+    double tol = 8*eps*max2(dmax, zmax);
+
+    // deflation: negligible z, or a Givens rotation zeroes z of a close pole
+    Array<int> kept, deflated;
+    int p = -1;
+    for (int j : order)
+      {
+        if (rho*fabs(z(j)) <= tol)
+          {
+            deflated.Append(j);
+            continue;
+          }
+        if (p >= 0)
+          {
+            double r = hypot(z(p), z(j));
+            double c = z(j)/r, s = z(p)/r;
+            if (fabs((d(j)-d(p))*c*s) <= tol)
+              {
+                z(p) = 0;
+                z(j) = r;
+                for (size_t l = 0; l < n; l++)
+                  {
+                    double qp = q(l,p), qj = q(l,j);
+                    q(l,p) = c*qp - s*qj;
+                    q(l,j) = s*qp + c*qj;
+                  }
+                double dp = c*c*d(p) + s*s*d(j);
+                d(j) = s*s*d(p) + c*c*d(j);
+                d(p) = dp;
+                deflated.Append(p);
+                p = j;
+                continue;
+              }
+            kept.Append(p);
+          }
+        p = j;
+      }
+    if (p >= 0) kept.Append(p);
+
+    size_t k = kept.Size();
+    Vector<> dk(k), zk(k), lam(k);
+    for (size_t i = 0; i < k; i++)
+      {
+        dk(i) = d(kept[i]);
+        zk(i) = z(kept[i]);
+      }
+
+    // delta(j,i) = dk(j) - lam(i)
+    Array<size_t> orig(k);
+    Vector<> mu(k);
+    Matrix<> delta(k, k);
+    ParallelFor (k, [&] (size_t i)
+                 {
+                   SolveSecular (dk, zk, rho, i, orig[i], mu(i));
+                   lam(i) = dk(orig[i]) + mu(i);
+                   for (size_t j = 0; j < k; j++)
+                     delta(j,i) = (dk(j)-dk(orig[i])) - mu(i);
+                 });
+
+    // z from the computed roots (Gu-Eisenstat), the eigenvectors are then
+    // orthogonal to working precision
+    Vector<> zhat(k);
+    ParallelFor (k, [&] (size_t j)
+                 {
+                   double prod = -delta(j,j);
+                   for (size_t i = 0; i < k; i++)
+                     if (i != j)
+                       prod *= delta(j,i) / (dk(j)-dk(i));
+                   zhat(j) = (zk(j) >= 0) ? sqrt(fabs(prod)) : -sqrt(fabs(prod));
+                 });
+
+    Matrix<> u(k, k);
+    ParallelFor (k, [&] (size_t i)
+                 {
+                   double sum = 0;
+                   for (size_t j = 0; j < k; j++)
+                     {
+                       u(j,i) = zhat(j) / delta(j,i);
+                       sum += sqr(u(j,i));
+                     }
+                   double scal = 1.0 / sqrt(sum);
+                   for (size_t j = 0; j < k; j++)
+                     u(j,i) *= scal;
+                 });
+
+    // q(:,kept) * u, the deflated columns stay
+    Matrix<> qk(n, k), qku(n, k);
+    for (size_t l = 0; l < n; l++)
+      for (size_t i = 0; i < k; i++)
+        qk(l,i) = q(l,kept[i]);
+    MultMatMat (qk, u, qku);
+
+    Vector<> dnew(n);
+    Matrix<> qnew(n, n);
+    for (size_t i = 0; i < k; i++)
+      {
+        dnew(i) = lam(i);
+        for (size_t l = 0; l < n; l++)
+          qnew(l,i) = qku(l,i);
+      }
+    for (size_t i = 0; i < deflated.Size(); i++)
+      {
+        dnew(k+i) = d(deflated[i]);
+        for (size_t l = 0; l < n; l++)
+          qnew(l,k+i) = q(l,deflated[i]);
+      }
+    SortEigenPairs (dnew, qnew);
+    d = dnew;
+    q = qnew;
+  }
+
+
+  // eigenvalues d, eigenvectors q of tridiag(e, d, e), by divide and conquer
+  static void TridiagonalEigenSystem (FlatVector<> d, FlatVector<> e, SliceMatrix<> q)
+  {
+    size_t n = d.Size();
+    if (n <= tridiag_base_size)
+      {
+        TridiagonalQL (d, e, q);
+        return;
+      }
+
+    size_t m = n/2;
+    double beta = e(m-1);
+    d(m-1) -= fabs(beta);
+    d(m) -= fabs(beta);
+
+    q.Rows(0, m).Cols(m, n) = 0.0;
+    q.Rows(m, n).Cols(0, m) = 0.0;
+    auto half = [&] (size_t i)
+      {
+        if (i == 0)
+          TridiagonalEigenSystem (d.Range(0, m), e.Range(0, m-1), q.Rows(0, m).Cols(0, m));
+        else
+          TridiagonalEigenSystem (d.Range(m, n), e.Range(m, n-1), q.Rows(m, n).Cols(m, n));
+      };
+    if (n >= tridiag_par_size)
+      ParallelFor (2, half);
+    else
+      {
+        half(0);
+        half(1);
+      }
+
+    MergeRankOne (d, q, m, beta);
+  }
+
+
+  void SymmetricEigenSystem (SliceMatrix<double> a, FlatVector<double> lami, SliceMatrix<double> evecs)
+  {
+    static Timer t("SymmetricEigenSystem"); RegionTimer reg(t);
+    size_t n = a.Height();
+    if (a.Width() != n || lami.Size() != n || evecs.Height() != n || evecs.Width() != n)
+      throw Exception ("SymmetricEigenSystem: matrix sizes don't fit");
+    if (n == 0) return;
+
+    Vector<> e(n), tau(n);
+    Tridiagonalize (a, lami, e, tau);
+    TridiagonalEigenSystem (lami, e.Range(0, n-1), evecs);
+    ApplyReflectors (a, tau, evecs);
+  }
+
+  void SymmetricEigenSystem (SliceMatrix<double> a, SliceMatrix<double> b,
+                             FlatVector<double> lami, SliceMatrix<double> evecs)
+  {
+    size_t n = a.Height();
+    if (b.Height() != n || b.Width() != n)
+      throw Exception ("SymmetricEigenSystem: matrix sizes don't fit");
+
+    // L^{-1} A L^{-T} y = lam y,  x = L^{-T} y
+    CholeskyFactor (b);
+    TriangularSolveLower (b, a);
+    Matrix<> c(n, n);
+    for (size_t i = 0; i < n; i++)
+      for (size_t j = 0; j < n; j++)
+        c(i,j) = a(j,i);
+    TriangularSolveLower (b, c);
+    for (size_t i = 0; i < n; i++)
+      for (size_t j = 0; j < i; j++)
+        c(i,j) = c(j,i) = 0.5 * (c(i,j)+c(j,i));
+
+    SymmetricEigenSystem (c, lami, evecs);
+    TriangularSolveLowerTrans (b, evecs);
+  }
+}
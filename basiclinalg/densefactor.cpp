@@ -0,0 +1,343 @@
+/* ************************************************************************/
+/* File:   densefactor.cpp                                                */
+/* Date:   Oct. 2026                                                      */
+/* ************************************************************************/
+
+/*
+  Recursive LU and Cholesky factorization of dense matrices.
+
+  The column range is split in halves, all work beyond the small
+  diagonal blocks goes into the ngblas SubAB / SubABt kernels.
+  Large trailing updates are split into row blocks and done in parallel.
+ */
+
+#include <bla.hpp>
+
+namespace ngbla
+{
+  // below that, unblocked elimination
+  constexpr size_t factor_base_size = 16;
+  // trailing updates with more flops run in parallel
+  constexpr double factor_par_flops = 1e7;
+  constexpr size_t factor_par_rows = 64;
+
+
+  // c -= a * b, in parallel over row blocks of c
+  static void ParallelSubAB (SliceMatrix<> a, SliceMatrix<> b, SliceMatrix<> c)
+  {
+    size_t h = c.Height();
+    if (double(h)*a.Width()*b.Width() < factor_par_flops)
+      {
+        SubAB (a, b, c);
+        return;
+      }
+    size_t nblocks = (h+factor_par_rows-1) / factor_par_rows;
+    ParallelFor (nblocks, [&] (size_t i)
+                 {
+                   IntRange r(i*factor_par_rows, min2(h, (i+1)*factor_par_rows));
+                   SubAB (a.Rows(r), b, c.Rows(r));
+                 });
+  }
+
+  // c -= a a^T, only the lower triangle of c is touched
+  static void ParallelSubAAtLower (SliceMatrix<> a, SliceMatrix<> c)
+  {
+    size_t h = c.Height(), w = a.Width();
+    auto block = [&] (size_t i)
+      {
+        size_t first = i*factor_par_rows, next = min2(h, first+factor_par_rows);
+        if (first > 0)
+          SubABt (a.Rows(first, next), a.Rows(0, first), c.Rows(first, next).Cols(0, first));
+        for (size_t j = first; j < next; j++)
+          {
+            double * aj = &a(j,0);
+            for (size_t k = first; k <= j; k++)
+              {
+                double * ak = &a(k,0);
+                double sum = 0;
+                for (size_t l = 0; l < w; l++)
+                  sum += aj[l] * ak[l];
+                c(j,k) -= sum;
+              }
+          }
+      };
+
+    size_t nblocks = (h+factor_par_rows-1) / factor_par_rows;
+    if (0.5*double(h)*h*w < factor_par_flops)
+      for (size_t i = 0; i < nblocks; i++)
+        block (i);
+    else
+      ParallelFor (nblocks, block);
+  }
+
+  // b.Row(i) -= fac * b.Row(j)
+  INLINE void SubRow (SliceMatrix<> b, size_t i, double fac, size_t j)
+  {
+    double * bi = &b(i,0);
+    double * bj = &b(j,0);
+    for (size_t k = 0; k < b.Width(); k++)
+      bi[k] -= fac * bj[k];
+  }
+
+  INLINE void ScaleRow (SliceMatrix<> b, size_t i, double fac)
+  {
+    double * bi = &b(i,0);
+    for (size_t k = 0; k < b.Width(); k++)
+      bi[k] *= fac;
+  }
+
+
+  // b = L^{-1} b, L unit lower triangular
+  static void TrsmUnitLower (SliceMatrix<> l, SliceMatrix<> b)
+  {
+    size_t n = l.Height();
+    if (n <= factor_base_size)
+      {
+        for (size_t i = 0; i < n; i++)
+          for (size_t j = 0; j < i; j++)
+            SubRow (b, i, l(i,j), j);
+        return;
+      }
+    size_t n1 = n/2;
+    TrsmUnitLower (l.Rows(0,n1).Cols(0,n1), b.Rows(0,n1));
+    ParallelSubAB (l.Rows(n1,n).Cols(0,n1), b.Rows(0,n1), b.Rows(n1,n));
+    TrsmUnitLower (l.Rows(n1,n).Cols(n1,n), b.Rows(n1,n));
+  }
+
+  // b = U^{-1} b, U upper triangular
+  static void TrsmUpper (SliceMatrix<> u, SliceMatrix<> b)
+  {
+    size_t n = u.Height();
+    if (n <= factor_base_size)
+      {
+        for (size_t i = n; i-- > 0; )
+          {
+            for (size_t j = i+1; j < n; j++)
+              SubRow (b, i, u(i,j), j);
+            ScaleRow (b, i, 1.0/u(i,i));
+          }
+        return;
+      }
+    size_t n1 = n/2;
+    TrsmUpper (u.Rows(n1,n).Cols(n1,n), b.Rows(n1,n));
+    ParallelSubAB (u.Rows(0,n1).Cols(n1,n), b.Rows(n1,n), b.Rows(0,n1));
+    TrsmUpper (u.Rows(0,n1).Cols(0,n1), b.Rows(0,n1));
+  }
+
+  // b = L^{-1} b, L lower triangular
+  static void TrsmLower (SliceMatrix<> l, SliceMatrix<> b)
+  {
+    size_t n = l.Height();
+    if (n <= factor_base_size)
+      {
+        for (size_t i = 0; i < n; i++)
+          {
+            for (size_t j = 0; j < i; j++)
+              SubRow (b, i, l(i,j), j);
+            ScaleRow (b, i, 1.0/l(i,i));
+          }
+        return;
+      }
+    size_t n1 = n/2;
+    TrsmLower (l.Rows(0,n1).Cols(0,n1), b.Rows(0,n1));
+    ParallelSubAB (l.Rows(n1,n).Cols(0,n1), b.Rows(0,n1), b.Rows(n1,n));
+    TrsmLower (l.Rows(n1,n).Cols(n1,n), b.Rows(n1,n));
+  }
+
+  // b = L^{-T} b, L lower triangular
+  static void TrsmLowerTrans (SliceMatrix<> l, SliceMatrix<> b)
+  {
+    size_t n = l.Height();
+    if (n <= factor_base_size)
+      {
+        for (size_t i = n; i-- > 0; )
+          {
+            ScaleRow (b, i, 1.0/l(i,i));
+            for (size_t j = 0; j < i; j++)
+              SubRow (b, j, l(i,j), i);
+          }
+        return;
+      }
+    size_t n1 = n/2;
+    TrsmLowerTrans (l.Rows(n1,n).Cols(n1,n), b.Rows(n1,n));
+    Matrix<> hb(n1, b.Width());
+    MultAtB (l.Rows(n1,n).Cols(0,n1), b.Rows(n1,n), hb);
+    b.Rows(0,n1) -= hb;
+    TrsmLowerTrans (l.Rows(0,n1).Cols(0,n1), b.Rows(0,n1));
+  }
+
+  // x = b L^{-T}, L lower triangular, in place
+  static void TrsmRightLowerTrans (SliceMatrix<> l, SliceMatrix<> b)
+  {
+    size_t n = l.Height();
+    if (n <= factor_base_size)
+      {
+        for (size_t i = 0; i < b.Height(); i++)
+          {
+            double * bi = &b(i,0);
+            for (size_t j = 0; j < n; j++)
+              {
+                double sum = bi[j];
+                for (size_t k = 0; k < j; k++)
+                  sum -= bi[k] * l(j,k);
+                bi[j] = sum / l(j,j);
+              }
+          }
+        return;
+      }
+    size_t n1 = n/2;
+    TrsmRightLowerTrans (l.Rows(0,n1).Cols(0,n1), b.Cols(0,n1));
+    SubABt (b.Cols(0,n1), l.Rows(n1,n).Cols(0,n1), b.Cols(n1,n));
+    TrsmRightLowerTrans (l.Rows(n1,n).Cols(n1,n), b.Cols(n1,n));
+  }
+
+
+  // factor columns [c0,c1), rows are exchanged over the full width of a
+  static void LUFactorRec (SliceMatrix<> a, size_t c0, size_t c1, FlatArray<int> p)
+  {
+    size_t n = a.Height();
+    if (c1-c0 <= factor_base_size)
+      {
+        for (size_t j = c0; j < c1; j++)
+          {
+            size_t r = j;
+            double maxval = fabs(a(j,j));
+            for (size_t i = j+1; i < n; i++)
+              if (fabs(a(i,j)) > maxval)
+                {
+                  r = i;
+                  maxval = fabs(a(i,j));
+                }
+            if (maxval == 0)
+              throw Exception ("LUFactor: matrix singular");
+
+            p[j] = r;
+            if (r != j)
+              {
+                double * aj = &a(j,0);
+                double * ar = &a(r,0);
+                for (size_t k = 0; k < a.Width(); k++)
+                  Swap (aj[k], ar[k]);
+              }
+
+            double inv = 1.0 / a(j,j);
+            double * aj = &a(j,0);
+            for (size_t i = j+1; i < n; i++)
+              {
+                double * ai = &a(i,0);
+                double lij = ai[j] * inv;
+                ai[j] = lij;
+                for (size_t k = j+1; k < c1; k++)
+                  ai[k] -= lij * aj[k];
+              }
+          }
+        return;
+      }
+
+    size_t cm = c0 + (c1-c0)/2;
+    LUFactorRec (a, c0, cm, p);
+    TrsmUnitLower (a.Rows(c0,cm).Cols(c0,cm), a.Rows(c0,cm).Cols(cm,c1));
+    ParallelSubAB (a.Rows(cm,n).Cols(c0,cm), a.Rows(c0,cm).Cols(cm,c1), a.Rows(cm,n).Cols(cm,c1));
+    LUFactorRec (a, cm, c1, p);
+  }
+
+  void LUFactor (SliceMatrix<double> a, FlatArray<int> p)
+  {
+    size_t n = a.Height();
+    if (a.Width() != n)
+      throw Exception ("LUFactor: matrix must be square");
+    if (p.Size() < n)
+      throw Exception ("LUFactor: pivot array too small");
+    LUFactorRec (a, 0, n, p);
+  }
+
+  void LUSolve (SliceMatrix<double> lu, FlatArray<int> p, SliceMatrix<double> b)
+  {
+    size_t n = lu.Height();
+    if (b.Height() != n)
+      throw Exception ("LUSolve: matrix sizes don't fit");
+    for (size_t i = 0; i < n; i++)
+      if (p[i] != int(i))
+        {
+          double * bi = &b(i,0);
+          double * bp = &b(p[i],0);
+          for (size_t k = 0; k < b.Width(); k++)
+            Swap (bi[k], bp[k]);
+        }
+    TrsmUnitLower (lu, b);
+    TrsmUpper (lu, b);
+  }
+
+  void LUInverse (SliceMatrix<double> a)
+  {
+    size_t n = a.Height();
+    ArrayMem<int,100> p(n);
+    LUFactor (a, p);
+
+    Matrix<> inv(n);
+    inv = Identity(n);
+    LUSolve (a, p, inv);
+    a = inv;
+  }
+
+
+  void CholeskyFactor (SliceMatrix<double> a)
+  {
+    size_t n = a.Height();
+    if (a.Width() != n)
+      throw Exception ("CholeskyFactor: matrix must be square");
+
+    if (n <= factor_base_size)
+      {
+        for (size_t j = 0; j < n; j++)
+          {
+            double * aj = &a(j,0);
+            double d = aj[j];
+            for (size_t k = 0; k < j; k++)
+              d -= aj[k]*aj[k];
+            if (d <= 0)
+              throw Exception ("CholeskyFactor: matrix not positive definite");
+            aj[j] = sqrt(d);
+            double inv = 1.0 / aj[j];
+            for (size_t i = j+1; i < n; i++)
+              {
+                double * ai = &a(i,0);
+                double sum = ai[j];
+                for (size_t k = 0; k < j; k++)
+                  sum -= ai[k]*aj[k];
+                ai[j] = sum * inv;
+              }
+          }
+        return;
+      }
+
+    size_t n1 = n/2;
+    CholeskyFactor (a.Rows(0,n1).Cols(0,n1));
+    TrsmRightLowerTrans (a.Rows(0,n1).Cols(0,n1), a.Rows(n1,n).Cols(0,n1));
+    ParallelSubAAtLower (a.Rows(n1,n).Cols(0,n1), a.Rows(n1,n).Cols(n1,n));
+    CholeskyFactor (a.Rows(n1,n).Cols(n1,n));
+  }
+
+  void CholeskySolve (SliceMatrix<double> l, SliceMatrix<double> b)
+  {
+    size_t n = l.Height();
+    if (b.Height() != n)
+      throw Exception ("CholeskySolve: matrix sizes don't fit");
+    TrsmLower (l, b);
+    TrsmLowerTrans (l, b);
+  }
+
+  void TriangularSolveLower (SliceMatrix<double> l, SliceMatrix<double> b)
+  {
+    if (b.Height() != l.Height())
+      throw Exception ("TriangularSolveLower: matrix sizes don't fit");
+    TrsmLower (l, b);
+  }
+
+  void TriangularSolveLowerTrans (SliceMatrix<double> l, SliceMatrix<double> b)
+  {
+    if (b.Height() != l.Height())
+      throw Exception ("TriangularSolveLowerTrans: matrix sizes don't fit");
+    TrsmLowerTrans (l, b);
+  }
+}
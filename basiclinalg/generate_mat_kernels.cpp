@@ -10,6 +10,9 @@ using namespace ngstd;
 
 enum OP { ADD, SUB, SET, SETNEG };
 
+// SIMD width of the target, may differ from the host for runtime dispatched builds
+int simd_width = SIMD<double>::Size();
+
 string ToString (OP op)
 {
   switch (op)
@@ -340,6 +343,108 @@ void GenerateScalAB (ostream & out, int h, int w)
 }
 
 
+/*
+  C += A * B^t,  complex or mixed real/complex
+
+  A ... h x n,  SIMD<Complex> or SIMD<double>
+  B ... w x n,  SIMD<Complex> or SIMD<double>
+  C ... h x w,  Complex
+
+  real and imaginary parts are accumulated in separate registers,
+  the products with -Im(b) avoid a negated fma
+*/
+void GenerateAddABtC (ostream & out, int h, int w, bool complex_a, bool complex_b)
+{
+  string ta = complex_a ? "SIMD<Complex>" : "SIMD<double>";
+  string tb = complex_b ? "SIMD<Complex>" : "SIMD<double>";
+  out << "template <> INLINE void MatKernelAddABtC<" << h << ", " << w << ">" << endl
+      << "    (size_t n," << endl
+      << "     " << ta << " * pa, size_t da," << endl
+      << "     " << tb << " * pb, size_t db," << endl
+      << "     Complex * pc, size_t dc)" << endl
+      << "{" << endl;
+
+  for (int i = 0; i < h; i++)
+    for (int j = 0; j < w; j++)
+      out << "SIMD<double> sr" << i << j << "(0), si" << i << j << "(0);" << endl;
+
+  out << "for (size_t i = 0; i < n; i++) {" << endl;
+  for (int i = 0; i < h; i++)
+    if (complex_a)
+      out << "SIMD<double> ar" << i << " = pa[" << i << "*da+i].real(), ai" << i
+          << " = pa[" << i << "*da+i].imag();" << endl;
+    else
+      out << "SIMD<double> a" << i << " = pa[" << i << "*da+i];" << endl;
+
+  auto fma = [&] (string a, string b, string sum)
+    {
+      if (2*h*w < 12)
+        out << sum << " += " << a << " * " << b << ";" << endl;
+      else
+        out << "FMAasm(" << a << "," << b << "," << sum << ");" << endl;
+    };
+  
+  for (int j = 0; j < w; j++)
+    {
+      string sj = to_string(j);
+      if (complex_b)
+        {
+          out << "SIMD<double> br" << j << " = pb[" << j << "*db+i].real(), bi" << j
+              << " = pb[" << j << "*db+i].imag();" << endl;
+          if (complex_a)
+            out << "SIMD<double> nbi" << j << " = -bi" << j << ";" << endl;
+        }
+      else
+        out << "SIMD<double> b" << j << " = pb[" << j << "*db+i];" << endl;
+          
+      for (int i = 0; i < h; i++)
+        {
+          string si = to_string(i), ij = si+sj;
+          if (complex_a && complex_b)
+            {
+              fma ("ar"+si, "br"+sj, "sr"+ij);
+              fma ("ai"+si, "nbi"+sj, "sr"+ij);
+              fma ("ar"+si, "bi"+sj, "si"+ij);
+              fma ("ai"+si, "br"+sj, "si"+ij);
+            }
+          else if (complex_b)
+            {
+              fma ("a"+si, "br"+sj, "sr"+ij);
+              fma ("a"+si, "bi"+sj, "si"+ij);
+            }
+          else
+            {
+              fma ("ar"+si, "b"+sj, "sr"+ij);
+              fma ("ai"+si, "b"+sj, "si"+ij);
+            }
+        }
+    }
+  out << "}" << endl;
+
+  for (int i = 0; i < h; i++)
+    {
+      int j = 0;
+      for ( ; j+2 <= w; j += 2)
+        {
+          out << "{ auto [c0,c1] = HSum(SIMD<Complex>(sr" << i << j << ",si" << i << j
+              << "), SIMD<Complex>(sr" << i << j+1 << ",si" << i << j+1 << "));" << endl;
+          out << "pc[" << i << "*dc+" << j << "] += c0; pc[" << i << "*dc+" << j+1 << "] += c1; }" << endl;
+        }
+      for ( ; j < w; j++)
+        out << "pc[" << i << "*dc+" << j << "] += HSum(SIMD<Complex>(sr" << i << j
+            << ",si" << i << j << "));" << endl;
+    }
+  out << "}" << endl;
+}
+
+void GenerateAddABtC (ostream & out, int h, int w)
+{
+  GenerateAddABtC(out, h, w, true, true);
+  GenerateAddABtC(out, h, w, false, true);
+  GenerateAddABtC(out, h, w, true, false);
+}
+
+
 void GenKernel (ofstream & out, int h, int w)
 {
   out << "template <> inline void MyScalTrans<" << h << ", " << w << ">" << endl
@@ -861,7 +966,7 @@ void  GenerateMatVec (ostream & out, int wa, OP op)
   out << "template <> INLINE void KernelMatVec<" << wa << ", " << ToString(op) << ">" << endl
       << "(size_t ha, double * pa, size_t da, double * x, double * y) {" << endl;
 
-  int SW = SIMD<double>::Size();  // generate optimal code for my host
+  int SW = simd_width;  // generate optimal code for the target
   // out << "constexpr int SW = SIMD<double>::Size();" << endl;
   int i = 0;
   for ( ; SW*(i+1) <= wa; i++)
@@ -991,7 +1096,7 @@ void GenerateAddMatVec (ostream & out, int wa)
   out << "template <> INLINE void KernelAddMatVec<" << wa << ">" << endl
       << "(double s, size_t ha, double * pa, size_t da, double * x, double * y) {" << endl;
 
-  int SW = SIMD<double>::Size();  // generate optimal code for my host
+  int SW = simd_width;  // generate optimal code for the target
   int i = 0;
   for ( ; SW*(i+1) <= wa; i++)
     out << "SIMD<double," << SW << "> x" << i << "(x+" << i*SW << ");" << endl;
@@ -1126,7 +1231,7 @@ void GenerateAddMatTransVecI (ostream & out, int wa)
       << "inline void KernelAddMatTransVecI<" << wa << ">" << endl
       << "(double s, size_t ha, double * pa, size_t da, double * x, double * y, int * ind) {" << endl;
 
-  int SW = SIMD<double>::Size();  // generate optimal code for my host
+  int SW = simd_width;  // generate optimal code for the target
 
   int nfull = wa / SW;
   int rest = wa % SW;
@@ -1247,11 +1352,15 @@ void GenerateAddMatTransVecI (ostream & out, int wa)
 
 
 
-int main ()
+int main (int argc, char ** argv)
 {
+  // optional argument: SIMD width of the target
+  if (argc > 1)
+    simd_width = atoi(argv[1]);
+  
   ofstream out("matkernel.hpp");
 
-  out << "static_assert(SIMD<double>::Size() == " << SIMD<double>::Size() << ", \"inconsistent compile flags for generate_mat_kernels.cpp and matkernel.hpp\");" << endl;
+  out << "static_assert(SIMD<double>::Size() == " << simd_width << ", \"inconsistent compile flags for generate_mat_kernels.cpp and matkernel.hpp\");" << endl;
   out << "enum OPERATION { ADD, SUB, SET, SETNEG };" << endl;
 
   out << "template <size_t H, size_t W, OPERATION OP>" << endl
@@ -1324,6 +1433,20 @@ int main ()
   GenerateScalAB (out, 1, 1);  
 
 
+  out << "template <size_t H, size_t W> inline void MatKernelAddABtC" << endl
+      << "    (size_t n, SIMD<Complex> * pa, size_t da, SIMD<Complex> * pb, size_t db, Complex * pc, size_t dc);" << endl;
+  out << "template <size_t H, size_t W> inline void MatKernelAddABtC" << endl
+      << "    (size_t n, SIMD<double> * pa, size_t da, SIMD<Complex> * pb, size_t db, Complex * pc, size_t dc);" << endl;
+  out << "template <size_t H, size_t W> inline void MatKernelAddABtC" << endl
+      << "    (size_t n, SIMD<Complex> * pa, size_t da, SIMD<double> * pb, size_t db, Complex * pc, size_t dc);" << endl;
+
+  GenerateAddABtC (out, 3, 2);
+  GenerateAddABtC (out, 3, 1);
+  GenerateAddABtC (out, 2, 2);
+  GenerateAddABtC (out, 2, 1);
+  GenerateAddABtC (out, 1, 2);
+  GenerateAddABtC (out, 1, 1);
+
   
   out << "template <size_t H, size_t W>" << endl
       << "inline void MyScalTrans" << endl
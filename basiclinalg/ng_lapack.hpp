@@ -1421,16 +1421,24 @@ namespace ngbla
 
 
   inline void LapackEigenValuesSymmetric (ngbla::FlatMatrix<double> a,
-                                          ngbla::FlatVector<double> lami)
+                                          ngbla::FlatVector<double> lami,
+                                          ngbla::FlatMatrix<double> evecs = ngbla::FlatMatrix<double>(0,0))
   { 
-    std::cerr << "sorry, EVP not available without LAPACK" << std::endl;
+    ngbla::Matrix<double> hevecs(a.Height());
+    ngbla::SymmetricEigenSystem (a, lami, hevecs);
+    if (evecs.Height())
+      evecs = hevecs;
   }
 
   inline void LapackEigenValuesSymmetric (ngbla::FlatMatrix<double> a,
                                           ngbla::FlatMatrix<double> b,
-                                          ngbla::FlatVector<double> lami)
+                                          ngbla::FlatVector<double> lami,
+                                          ngbla::FlatMatrix<double> evecs = ngbla::FlatMatrix<double>(0,0))
   { 
-    std::cerr << "sorry, EVP not available without LAPACK" << std::endl;
+    ngbla::Matrix<double> hevecs(a.Height());
+    ngbla::SymmetricEigenSystem (a, b, lami, hevecs);
+    if (evecs.Height())
+      evecs = hevecs;
   }
 
 
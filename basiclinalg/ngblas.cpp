@@ -41,6 +41,31 @@ namespace ngbla
 #include "matkernel.hpp"
 
 
+  /*
+    Kernels called directly for large matrices. In the core library they
+    are redirected to an ISA specific build of this file (see the end of
+    the file), the small kernels go through the dispatch tables.
+  */
+  typedef void REGCALL (*pmultAB_large)(size_t, size_t, size_t, BareSliceMatrix<>, BareSliceMatrix<>, BareSliceMatrix<>);
+  typedef void (*pfunc_abt_large)(SliceMatrix<double>, SliceMatrix<double>, BareSliceMatrix<double>);
+  
+  struct ArchKernels
+  {
+    pmult_mattransvec multmattransvec = nullptr;
+    pmultadd_mattransvec multaddmattransvec = nullptr;
+    pmultAB_large multmatmat = nullptr;
+    pmultAB_large minusmultab = nullptr;
+    pmultAB_large addab = nullptr;
+    pmultAB_large subab = nullptr;
+    pfunc_abt_large multatb = nullptr;
+    pfunc_abt_large multabt = nullptr;
+    pfunc_abt_large minusmultabt = nullptr;
+    pfunc_abt_large addabt = nullptr;
+    pfunc_abt_large subabt = nullptr;
+  };
+  static ArchKernels arch_kernels;
+
+
   /* ***************************** Copy Matrix *********************** */
   // copy matrix
   /*
@@ -81,7 +106,30 @@ namespace ngbla
   }
 
 
+  static void MultMatVec_intern_seq (BareSliceMatrix<> a, FlatVector<> x, FlatVector<> y);
+
+  // larger matrix-vector products run in parallel over row blocks
+  constexpr double matvec_par_size = 1e6;
+  constexpr size_t matvec_par_rows = 256;
+  
   NGS_DLL_HEADER void MultMatVec_intern (BareSliceMatrix<> a, FlatVector<> x, FlatVector<> y)
+  {
+    size_t h = y.Size();
+    if (double(h)*x.Size() < matvec_par_size || h < 2*matvec_par_rows || TaskManager::GetNumThreads() == 1)
+      {
+        MultMatVec_intern_seq (a, x, y);
+        return;
+      }
+
+    size_t nblocks = (h+matvec_par_rows-1) / matvec_par_rows;
+    ParallelFor (nblocks, [&] (size_t i)
+                 {
+                   IntRange r(i*matvec_par_rows, min2(h, (i+1)*matvec_par_rows));
+                   MultMatVec_intern_seq (a.Rows(r), x, y.Range(r));
+                 });
+  }
+  
+  static void MultMatVec_intern_seq (BareSliceMatrix<> a, FlatVector<> x, FlatVector<> y)
   {
     // constexpr int SW = SIMD<double>::Size();
     size_t h = y.Size();
@@ -196,6 +244,9 @@ namespace ngbla
 
   NGS_DLL_HEADER void MultMatTransVec_intern (BareSliceMatrix<> a, FlatVector<> x, FlatVector<> y)
   {
+    if (arch_kernels.multmattransvec)
+      return (*arch_kernels.multmattransvec) (a, x, y);
+    
     constexpr int SW = SIMD<double>::Size();
     size_t h = x.Size();
     size_t w = y.Size();
@@ -291,6 +342,9 @@ namespace ngbla
 
   NGS_DLL_HEADER void MultAddMatTransVec_intern (double s, BareSliceMatrix<> a, FlatVector<> x, FlatVector<> y)
   {
+    if (arch_kernels.multaddmattransvec)
+      return (*arch_kernels.multaddmattransvec) (s, a, x, y);
+    
     constexpr int SW = SIMD<double>::Size();
     size_t h = x.Size();
     size_t w = y.Size();
@@ -829,8 +883,44 @@ namespace ngbla
 
 
   
+  static void MultMatMat_intern_seq (size_t ha, size_t wa, size_t wb,
+                                     BareSliceMatrix<> a, BareSliceMatrix<> b, BareSliceMatrix<> c);
+
+  /*
+    larger products are split into tiles of c, one task per tile.
+    A tile is a multiple of the micro kernel heights (4 and 6) and of
+    the width of the L2-blocks of b (96), a task reads a row block of a
+    and a column block of b.
+  */
+  constexpr double gemm_par_flops = 1e7;
+  constexpr size_t gemm_par_rows = 96;
+  constexpr size_t gemm_par_cols = 384;
+  
   void MultMatMat_intern (size_t ha, size_t wa, size_t wb,
                           BareSliceMatrix<> a, BareSliceMatrix<> b, BareSliceMatrix<> c)
+  {
+    if (arch_kernels.multmatmat)
+      return (*arch_kernels.multmatmat) (ha, wa, wb, a, b, c);
+
+    if (double(ha)*wa*wb < gemm_par_flops || TaskManager::GetNumThreads() == 1)
+      {
+        MultMatMat_intern_seq (ha, wa, wb, a, b, c);
+        return;
+      }
+
+    size_t nr = (ha+gemm_par_rows-1) / gemm_par_rows;
+    size_t nc = (wb+gemm_par_cols-1) / gemm_par_cols;
+    ParallelFor (nr*nc, [&] (size_t t)
+                 {
+                   IntRange r(t/nc*gemm_par_rows, min2(ha, (t/nc+1)*gemm_par_rows));
+                   IntRange cols(t%nc*gemm_par_cols, min2(wb, (t%nc+1)*gemm_par_cols));
+                   MultMatMat_intern_seq (r.Size(), wa, cols.Size(),
+                                          a.Rows(r), b.Cols(cols), c.Rows(r).Cols(cols));
+                 });
+  }
+  
+  static void MultMatMat_intern_seq (size_t ha, size_t wa, size_t wb,
+                                     BareSliceMatrix<> a, BareSliceMatrix<> b, BareSliceMatrix<> c)
   {
     constexpr size_t BBH = 128;
     if (wa <= BBH)
@@ -857,6 +947,9 @@ namespace ngbla
   void MinusMultAB_intern (size_t ha, size_t wa, size_t wb,
                            BareSliceMatrix<> a, BareSliceMatrix<> b, BareSliceMatrix<> c)
   {
+    if (arch_kernels.minusmultab)
+      return (*arch_kernels.minusmultab) (ha, wa, wb, a, b, c);
+    
     constexpr size_t BBH = 128;
     if (wa <= BBH)
       {
@@ -904,6 +997,9 @@ namespace ngbla
   void AddAB_intern (size_t ha, size_t wa, size_t wb,
                      BareSliceMatrix<> a, BareSliceMatrix<> b, BareSliceMatrix<> c)
   {
+    if (arch_kernels.addab)
+      return (*arch_kernels.addab) (ha, wa, wb, a, b, c);
+    
     switch (wa)
       {
       case 0: return;
@@ -931,6 +1027,9 @@ namespace ngbla
   void SubAB_intern (size_t ha, size_t wa, size_t wb,
                      BareSliceMatrix<> a, BareSliceMatrix<> b, BareSliceMatrix<> c)
   {
+    if (arch_kernels.subab)
+      return (*arch_kernels.subab) (ha, wa, wb, a, b, c);
+    
     constexpr size_t BBH = 128;
     if (wa <= BBH && wb < 3*SIMD<double>::Size())
       MultMatMat_intern2_SlimB<BBH,SUB> (ha, wa, wb, a, b, c);
@@ -1163,6 +1262,9 @@ namespace ngbla
 
   void MultAtB_intern (SliceMatrix<double> a, SliceMatrix<double> b, BareSliceMatrix<double> c)
   {
+    if (arch_kernels.multatb)
+      return (*arch_kernels.multatb) (a, b, c);
+    
     // c.AddSize(a.Width(), b.Width()) = 1.0 * Trans(a) * b;  // avoid recursion
     
     constexpr size_t bs = 8;
@@ -1302,6 +1404,9 @@ namespace ngbla
 
   void MultABt_intern (SliceMatrix<double> a, SliceMatrix<double> b, BareSliceMatrix<double> c)
   {
+    if (arch_kernels.multabt)
+      return (*arch_kernels.multabt) (a, b, c);
+    
     // c = a * Trans(b);
 
     constexpr size_t bs = 256;
@@ -1317,6 +1422,9 @@ namespace ngbla
 
   void MinusMultABt (SliceMatrix<double> a, SliceMatrix<double> b, BareSliceMatrix<double> c)
   {
+    if (arch_kernels.minusmultabt)
+      return (*arch_kernels.minusmultabt) (a, b, c);
+    
     // c = -a * Trans(b);
     
     constexpr size_t bs = 256;
@@ -1333,12 +1441,18 @@ namespace ngbla
   
   void AddABt (SliceMatrix<double> a, SliceMatrix<double> b, BareSliceMatrix<double> c)
   {
+    if (arch_kernels.addabt)
+      return (*arch_kernels.addabt) (a, b, c);
+    
     // c += a * Trans(b);
     TAddABt1 (a, b, c, [] (auto c, auto ab) { return c+ab; });
   }
 
   void SubABt (SliceMatrix<double> a, SliceMatrix<double> b, BareSliceMatrix<double> c)
   {
+    if (arch_kernels.subabt)
+      return (*arch_kernels.subabt) (a, b, c);
+    
     // c -= a * Trans(b);
     TAddABt1 (a, b, c, [] (auto c, auto ab) { return c-ab; });
   }
@@ -1471,149 +1585,90 @@ namespace ngbla
 
   
 
-  void AddABt (FlatMatrix<SIMD<Complex>> a,
-               FlatMatrix<SIMD<Complex>> b,
-               SliceMatrix<Complex> c)
-  {
-    for (size_t i = 0; i < c.Height(); i++)
-      for (size_t j = 0; j < c.Width(); j++)
-        {
-          SIMD<Complex> sum(0.0);
-          for (size_t k = 0; k < a.Width(); k++)
-            sum += a(i,k) * b(j,k);
-          c(i,j) += HSum(sum);
-        }
-  }
-  
-  void AddABtSym (FlatMatrix<SIMD<Complex>> a,
-                  FlatMatrix<SIMD<Complex>> b,
-                  SliceMatrix<Complex> c)
-  {
-    AddABt (a, b, c);
-  }
-  /*
-  void AddABt (FlatMatrix<SIMD<double>> a,
-               FlatMatrix<SIMD<Complex>> b,
-               SliceMatrix<Complex> c)
-  {
-    size_t i = 0;
-    for ( ; i < c.Height()-1; i+=2)
-      for (size_t j = 0; j < c.Width(); j++)
-        {
-          SIMD<Complex> sum1(0.0);
-          SIMD<Complex> sum2(0.0);
-          for (size_t k = 0; k < a.Width(); k++)
-            {
-              sum1 += a(i,k) * b(j,k);
-              sum2 += a(i+1,k) * b(j,k);
-            }
-          c(i,j) += HSum(sum1);
-          c(i+1,j) += HSum(sum2);
-        }
-    
-    if (i < c.Height())
-      for (size_t j = 0; j < c.Width(); j++)
-        {
-          SIMD<Complex> sum(0.0);
-          for (size_t k = 0; k < a.Width(); k++)
-            sum += a(i,k) * b(j,k);
-          c(i,j) += HSum(sum);
-        }
-  }
-  */
-
+  /* ********************* complex and mixed AddABt ******************** */
 
-      
-  void AddABt1 (SliceMatrix<SIMD<double>> a,
-                SliceMatrix<SIMD<Complex>> b,
-                SliceMatrix<Complex> c)
+  // C += A B^t by the generated MatKernelAddABtC kernels,
+  // with symmetric only the lower triangle (plus the diagonal blocks)
+  template <typename TA, typename TB>
+  INLINE void TAddABtC4 (size_t wa, size_t hc, size_t wc, ptrdiff_t jc,
+                         TA * pa, size_t da, TB * pb, size_t db, Complex * pc, size_t dc,
+                         bool symmetric)
   {
-    size_t i = 0;
-    size_t wa = a.Width();
-    size_t da = a.Dist();
-    size_t db = b.Dist();
-    if (wa == 0) return;
+#ifdef __AVX512F__
+    constexpr size_t HA = 3;
+#else
+    constexpr size_t HA = 2;
+#endif
     
-    for ( ; i+1 < c.Height(); i+=2)
+    TB * pb0 = pb;
+    size_t i = 0;
+    for ( ; i+HA <= hc; i += HA, pa += HA*da, pc += HA*dc)
       {
-        auto pa1 = &a(i,0);
-        auto pa2 = pa1 + da;
-        auto pb1 = &b(0,0);
+        size_t w = symmetric ? max2(ptrdiff_t(0), min2(ptrdiff_t(wc), jc+ptrdiff_t(i+HA))) : wc;
+        TB * pb = pb0;
         size_t j = 0;
-        for ( ; j+1 < c.Width(); j+=2, pb1 += 2*db)
-          // for ( ; j+1 < c.Width(); j+=1, pb1 += db)
-          {
-            auto pb2 = pb1 + db;
-            
-            SIMD<Complex> sum11(0.0);
-            SIMD<Complex> sum21(0.0);
-            SIMD<Complex> sum12(0.0);
-            SIMD<Complex> sum22(0.0);
-            __assume (wa > 0);
-            for (size_t k = 0; k < wa; k++)
-              {
-                sum11 += pa1[k] * pb1[k];
-                sum21 += pa2[k] * pb1[k];
-                sum12 += pa1[k] * pb2[k];
-                sum22 += pa2[k] * pb2[k];
-              }
-
-            Complex s11, s21, s12, s22;
-            std::tie(s11,s21) = HSum(sum11, sum21);
-            std::tie(s12,s22) = HSum(sum12, sum22);
-            c(i,j) += s11;
-            c(i,j+1) += s12;
-            c(i+1,j) += s21;
-            c(i+1,j+1) += s22;
-          }
-        if (j < c.Width())
-          {
-            SIMD<Complex> sum1(0.0);
-            SIMD<Complex> sum2(0.0);
-            __assume (wa > 0);
-            for (size_t k = 0; k < wa; k++)
-              {
-                sum1 += pa1[k] * pb1[k];
-                sum2 += pa2[k] * pb1[k];
-              }
+        for ( ; j+2 <= w; j += 2, pb += 2*db)
+          MatKernelAddABtC<HA,2> (wa, pa, da, pb, db, pc+j, dc);
+        for ( ; j < w; j++, pb += db)
+          MatKernelAddABtC<HA,1> (wa, pa, da, pb, db, pc+j, dc);
+      }
+    for ( ; i < hc; i++, pa += da, pc += dc)
+      {
+        size_t w = symmetric ? max2(ptrdiff_t(0), min2(ptrdiff_t(wc), jc+ptrdiff_t(i+1))) : wc;
+        TB * pb = pb0;
+        size_t j = 0;
+        for ( ; j+2 <= w; j += 2, pb += 2*db)
+          MatKernelAddABtC<1,2> (wa, pa, da, pb, db, pc+j, dc);
+        for ( ; j < w; j++, pb += db)
+          MatKernelAddABtC<1,1> (wa, pa, da, pb, db, pc+j, dc);
+      }
+  }
 
-            Complex s1, s2;
-            std::tie(s1,s2) = HSum(sum1, sum2);
-            c(i,j) += s1;
-            c(i+1,j) += s2;
-          }
+  // blocks of A and B rows staying in cache
+  template <typename TA, typename TB>
+  void TAddABtC (size_t wa, size_t ha, size_t hb,
+                 TA * pa, size_t da, TB * pb, size_t db, Complex * pc, size_t dc,
+                 bool symmetric = false)
+  {
+    constexpr size_t bsa = 48; // height a
+    constexpr size_t bsb = 16; // height b
+    for (size_t i = 0; i < ha; i += bsa, pa += bsa*da, pc += bsa*dc)
+      {
+        size_t hha = min2(bsa, ha-i);
+        TB * hpb = pb;
+        size_t hhb = symmetric ? min2(hb, i+hha) : hb;
+        for (size_t j = 0; j < hhb; j += bsb, hpb += bsb*db)
+          TAddABtC4 (wa, hha, min2(bsb, hhb-j), ptrdiff_t(i)-ptrdiff_t(j),
+                     pa, da, hpb, db, pc+j, dc, symmetric && j+bsb > i);
       }
-    
-    if (i < c.Height())
-      for (size_t j = 0; j < c.Width(); j++)
-        {
-          SIMD<Complex> sum(0.0);
-          for (size_t k = 0; k < wa; k++)
-            sum += a(i,k) * b(j,k);
-          c(i,j) += HSum(sum);
-        }
   }
 
+  Timer timer_addabtcc ("AddABt-complex-complex");
   Timer timer_addabtdc ("AddABt-double-complex");
   Timer timer_addabtcd ("AddABt-complex-double");
+  Timer timer_addabtccsym ("AddABt-complex-complex, sym");
   Timer timer_addabtdcsym ("AddABt-double-complex, sym");
 
-  // block and pack B
-  template <size_t K>
-  void AddABt2 (SliceMatrix<SIMD<double>> a,
-                SliceMatrix<SIMD<Complex>> b,
-                SliceMatrix<Complex> c)
+  void AddABt (FlatMatrix<SIMD<Complex>> a,
+               FlatMatrix<SIMD<Complex>> b,
+               SliceMatrix<Complex> c)
   {
-    constexpr size_t bs = 32;
-    SIMD<Complex> memb[bs*K];
-    // M * K * sizeof(SIMD<Complex>) = 32 * 64 * 64 = 128 KB
-    for (size_t k = 0; k < b.Height(); k+= bs)
-      {
-        size_t k2 = min2(k+bs, b.Height());
-        FlatMatrix<SIMD<Complex>> tempb(k2-k, b.Width(), &memb[0]);
-        tempb = b.Rows(k,k2);
-        AddABt1 (a, tempb, c.Cols(k,k2));
-      }
+    ThreadRegionTimer reg(timer_addabtcc, TaskManager::GetThreadId());
+    NgProfiler::AddThreadFlops(timer_addabtcc, TaskManager::GetThreadId(),
+                               a.Height()*b.Height()*a.Width()*8*SIMD<double>::Size());
+    TAddABtC (a.Width(), a.Height(), b.Height(),
+              a.Data(), a.Width(), b.Data(), b.Width(), c.Data(), c.Dist());
+  }
+  
+  void AddABtSym (FlatMatrix<SIMD<Complex>> a,
+                  FlatMatrix<SIMD<Complex>> b,
+                  SliceMatrix<Complex> c)
+  {
+    ThreadRegionTimer reg(timer_addabtccsym, TaskManager::GetThreadId());
+    NgProfiler::AddThreadFlops(timer_addabtccsym, TaskManager::GetThreadId(),
+                               a.Height()*(b.Height()+1)*a.Width()*4*SIMD<double>::Size());
+    TAddABtC (a.Width(), a.Height(), b.Height(),
+              a.Data(), a.Width(), b.Data(), b.Width(), c.Data(), c.Dist(), true);
   }
   
   void AddABt (SliceMatrix<SIMD<double>> a,
@@ -1622,135 +1677,29 @@ namespace ngbla
   {
     ThreadRegionTimer reg(timer_addabtdc, TaskManager::GetThreadId());
     NgProfiler::AddThreadFlops(timer_addabtdc, TaskManager::GetThreadId(),
-                               a.Height()*b.Height()*a.Width()*2*SIMD<double>::Size());
-    constexpr size_t bs = 64;
-    for (size_t k = 0; k < a.Width(); k+=bs)
-      {
-        size_t k2 = min2(k+bs, a.Width());
-        AddABt2<bs> (a.Cols(k,k2), b.Cols(k,k2), c);
-      }
+                               a.Height()*b.Height()*a.Width()*4*SIMD<double>::Size());
+    TAddABtC (a.Width(), a.Height(), b.Height(),
+              a.Data(), a.Dist(), b.Data(), b.Dist(), c.Data(), c.Dist());
   }
 
-
-
   void AddABt (SliceMatrix<SIMD<Complex>> a, SliceMatrix<SIMD<double>> b, SliceMatrix<Complex> c)
   {
     ThreadRegionTimer reg(timer_addabtcd, TaskManager::GetThreadId());
     NgProfiler::AddThreadFlops(timer_addabtcd, TaskManager::GetThreadId(),
-                               a.Height()*b.Height()*a.Width()*2*SIMD<double>::Size());
-
-    for (size_t i = 0; i < c.Height(); i++)
-      for (size_t j = 0; j < c.Width(); j++)
-        {
-          SIMD<Complex> sum = 0.0;
-          auto rowa = a.Row(i);
-          auto rowb = b.Row(j);
-          for (size_t k = 0; k < a.Width(); k++)
-            sum += rowa(k)*rowb(k);
-          c(i,j) += HSum(sum);
-        }
+                               a.Height()*b.Height()*a.Width()*4*SIMD<double>::Size());
+    TAddABtC (a.Width(), a.Height(), b.Height(),
+              a.Data(), a.Dist(), b.Data(), b.Dist(), c.Data(), c.Dist());
   }
-
-  
   
   void AddABtSym (FlatMatrix<SIMD<double>> a,
                   FlatMatrix<SIMD<Complex>> b,
                   SliceMatrix<Complex> c)
   {
-    size_t ha = a.Height();
-    size_t bs = 192;
-    if (ha > bs)
-      {
-        AddABtSym(a.Rows(0,bs), b.Rows(0,bs), c.Rows(0,bs).Cols(0,bs));
-        AddABt(a.Rows(bs,ha), b.Rows(0,bs), c.Rows(bs,ha).Cols(0,bs));
-        AddABtSym(a.Rows(bs,ha), b.Rows(bs,ha), c.Rows(bs,ha).Cols(bs,ha));
-        return;
-      }
-    
-    bs = 96;
-    if (ha > bs)
-      {
-        AddABtSym(a.Rows(0,bs), b.Rows(0,bs), c.Rows(0,bs).Cols(0,bs));
-        AddABt(a.Rows(bs,ha), b.Rows(0,bs), c.Rows(bs,ha).Cols(0,bs));
-        AddABtSym(a.Rows(bs,ha), b.Rows(bs,ha), c.Rows(bs,ha).Cols(bs,ha));
-        return;
-      }
-
-    bs = 48;
-    if (ha > bs)
-      {
-        AddABtSym(a.Rows(0,bs), b.Rows(0,bs), c.Rows(0,bs).Cols(0,bs));
-        AddABt(a.Rows(bs,ha), b.Rows(0,bs), c.Rows(bs,ha).Cols(0,bs));
-        AddABtSym(a.Rows(bs,ha), b.Rows(bs,ha), c.Rows(bs,ha).Cols(bs,ha));
-        return;
-      }
-    bs = 24;
-    if (ha > bs)
-      {
-        AddABtSym(a.Rows(0,bs), b.Rows(0,bs), c.Rows(0,bs).Cols(0,bs));
-        AddABt(a.Rows(bs,ha), b.Rows(0,bs), c.Rows(bs,ha).Cols(0,bs));
-        AddABtSym(a.Rows(bs,ha), b.Rows(bs,ha), c.Rows(bs,ha).Cols(bs,ha));
-        return;
-      }
-    
     ThreadRegionTimer reg(timer_addabtdcsym, TaskManager::GetThreadId());
     NgProfiler::AddThreadFlops(timer_addabtdcsym, TaskManager::GetThreadId(),
-                               a.Height()*b.Height()*a.Width()*8);
-    
-    // AddABt (a, b, c);
-    size_t da = a.Width();
-    size_t db = b.Width();
-    size_t wa = a.Width();
-    // size_t ha = a.Height();
-    size_t hb = b.Height();
-    size_t dc = c.Dist();
-    if (wa == 0) return;
-    
-    size_t i = 0;
-    for ( ; i+1 < ha; i+=2)
-      {
-        auto pa1 = &a(i,0);
-        auto pa2 = pa1 + da;
-        auto pb1 = &b(0,0);
-        auto pc = &c(i,0);
-
-        for (size_t j = 0; j <= i; j+=2, pb1 += 2*db)
-          {
-            auto pb2 = pb1 + db;
-            
-            SIMD<Complex> sum11(0.0);
-            SIMD<Complex> sum21(0.0);
-            SIMD<Complex> sum12(0.0);
-            SIMD<Complex> sum22(0.0);
-
-            __assume (wa > 0);
-            for (size_t k = 0; k < wa; k++)
-              {
-                sum11 += pa1[k] * pb1[k];
-                sum21 += pa2[k] * pb1[k];
-                sum12 += pa1[k] * pb2[k];
-                sum22 += pa2[k] * pb2[k];
-              }
-
-            Complex s11, s21, s12, s22;
-            std::tie(s11,s12) = HSum(sum11, sum12);
-            std::tie(s21,s22) = HSum(sum21, sum22);
-
-            pc[j] += s11;
-            pc[j+1] += s12;            
-            pc[j+dc] += s21;
-            pc[j+dc+1] += s22;            
-          }
-      }
-    
-    if (i < ha)
-      for (size_t j = 0; j < hb; j++)
-        {
-          SIMD<Complex> sum(0.0);
-          for (size_t k = 0; k < wa; k++)
-            sum += a(i,k) * b(j,k);
-          c(i,j) += HSum(sum);
-        }
+                               a.Height()*(b.Height()+1)*a.Width()*2*SIMD<double>::Size());
+    TAddABtC (a.Width(), a.Height(), b.Height(),
+              a.Data(), a.Width(), b.Data(), b.Width(), c.Data(), c.Dist(), true);
   }
   
   void AddABt (FlatMatrix<SIMD<double>> a,
@@ -1846,6 +1795,45 @@ namespace ngbla
   }
 
 
+  void AddABtSym (SliceMatrix<SIMD<double>> a,
+                  SliceMatrix<SIMD<double>> b,
+                  FlatSymmetricMatrix<double> c, size_t first)
+  {
+    constexpr size_t N = 92;
+    double mem[N*N];
+    // add the lower triangle of the tile to the packed rows
+    auto add_tile = [&] (size_t i, size_t j, FlatMatrix<double> tempc)
+      {
+        for (size_t k = 0; k < tempc.Height(); k++)
+          {
+            size_t row = first+i+k;
+            size_t nj = min2(tempc.Width(), i+k+1-j);
+            double * crow = c.Data() + row*(row+1)/2 + first+j;
+            for (size_t l = 0; l < nj; l++)
+              crow[l] += tempc(k,l);
+          }
+      };
+    
+    for (size_t i = 0; i < a.Height(); i += N)
+      {
+        size_t i2 = min2(a.Height(), i+N);
+        for (size_t j = 0; j < i; j += N)
+          {
+            size_t j2 = min2(i, j+N);
+            FlatMatrix<double> tempc(i2-i, j2-j, &mem[0]);
+            tempc = 0.0;
+            AddABt (a.Rows(i,i2), b.Rows(j,j2), tempc);
+            add_tile (i, j, tempc);
+          }
+        // j == i
+        FlatMatrix<double> tempc(i2-i, i2-i, &mem[0]);
+        tempc = 0.0;
+        AddABtSym (a.Rows(i,i2), b.Rows(i,i2), tempc);
+        add_tile (i, i, tempc);
+      }
+  }
+
+
   /* ************************** SubAtDB ***************************** */
 
   static constexpr size_t NA = 128;
@@ -2405,15 +2393,20 @@ namespace ngbla
           "1 ... A = B,   A,B = n*m,   A = aligned, fixed dist\n"
           "2 ... A = 0,   A = n*m,     but sliced\n"
           "3 ... A = B^t, A = n*m, \n"
+          "4 ... peak fma throughput, register resident\n"
           "5 ... y = A*x,   A = n*m\n"
           "6 ... y = A^t*x,   A = n*m\n"
           "7 ... y += A^t*x(ind),   A = n*m\n"
           "10 .. C = A * B,   A=n*m, B=m*k, C=n*k\n"
           "11 .. C += A * B,   A=n*m, B=m*k, C=n*k\n"
+          "12 .. C = A * B,   A=n*m, B=m*k, C=n*k, complex\n"
+          "13 .. C = A * B,   A=n*m, B=m*k, C=n*k, column major\n"
           // "20 .. C = A * B    A=n*m, B=n*k', C=n*k', k'=round(k), B aligned\n"
           "50 .. C += A * B^t,   A=n*k, B=m*k, C=n*m\n"
           "51 .. C += A * B^t,   A=n*k, B=m*k, C=n*m,  A,B aligned\n"
           "52 .. C = A * B^t,   A=n*k, B=m*k, C=n*m\n"
+          "53 .. C += A * B^t,   A=n*k, B=m*k, C=n*m, A,B complex SIMD\n"
+          "54 .. C += A * B^t,   A=n*k, B=m*k, C=n*m, A real SIMD, B complex SIMD\n"
           "60 .. C -= A^t * D B,  A=n*k, B=n*m, C = k*m, D=diag\n"
           "61 .. C = A^t B,  A=n*k, B=n*m, C = k*m\n"
           "70 .. C += A B^t,  A=n*k, B=m*k, C = n*m, A,B SIMD\n"
@@ -2426,6 +2419,11 @@ namespace ngbla
           "200.. CalcInverse        A = nxn\n"
           "205.. LDL                A = nxn\n"
           "210.. CalcInverseLapack  A = nxn\n"
+          "220.. LUFactor           A = nxn\n"
+          "221.. CholeskyFactor     A = nxn\n"
+          "222.. LUInverse          A = nxn\n"
+          "230.. BatchedMultMatMat  m products of nxn\n"
+          "231.. BatchedLUFactor    m matrices nxn\n"
              << endl;
         return list<tuple<string,double>>();
       }
@@ -2495,6 +2493,27 @@ namespace ngbla
       }
 
 
+    if (what == 0 || what == 4)
+      {
+        // independent fma chains, enough to hide the fma latency
+        constexpr int NA = 12;
+        SIMD<double> acc[NA];
+        Iterate<NA> ([&] (auto i) { acc[i] = double(i.value); });
+        SIMD<double> x(1-1e-12), y(1e-12);
+        size_t its = 1e9 / (NA*SW) + 1;
+        {
+          Timer t("fma peak");
+          t.Start();
+          for (size_t j = 0; j < its; j++)
+            Iterate<NA> ([&] (auto i) { acc[i] = FMA(acc[i], x, y); });
+          t.Stop();
+          double sum = 0;
+          for (int i = 0; i < NA; i++)
+            sum += HSum(acc[i]);
+          cout << "FMA peak GFlops = " << 1e-9 * NA*SW*its / t.GetTime() << ", sum = " << sum << endl;
+          timings.push_back(make_tuple("FMA peak", 1e-9 * NA*SW*its / t.GetTime()));
+        }
+      }
     
     if (what == 0 || what == 5)
       {
@@ -2990,10 +3009,366 @@ namespace ngbla
         }
       }
 
+
+    if (what == 0 || what == 12)
+      {
+        // C=A*B, complex
+        Matrix<Complex> a(n,m), b(m,k), c(n,k);
+        a = Complex(1,1); b = Complex(2,-1);
+        double tot = 4*double(n)*m*k;
+        int its = 1e10 / tot + 1;
+        {
+          Timer t("C = A*B, complex");
+          t.Start();
+          if (!lapack)
+            for (int j = 0; j < its; j++)
+              c = a*b;
+          else
+            for (int j = 0; j < its; j++)
+              c = a*b | Lapack;
+          t.Stop();
+          cout << "MultMatMat complex GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("MultMatMat complex", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
+    if (what == 0 || what == 13)
+      {
+        // C=A*B, column major
+        Matrix<double,ColMajor> a(n,m), b(m,k), c(n,k);
+        a = 1; b = 2;
+        double tot = double(n)*m*k;
+        int its = 1e10 / tot + 1;
+        {
+          Timer t("C = A*B, colmajor");
+          t.Start();
+          for (int j = 0; j < its; j++)
+            c = a*b;
+          t.Stop();
+          cout << "MultMatMat colmajor GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("MultMatMat colmajor", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
+    if (what == 0 || what == 53)
+      {
+        // C += A*B^t, complex SIMD
+        if (k % SW != 0)
+          cout << "k should be a multiple of " << SW << endl;
+        size_t ks = k/SW;
+        Matrix<SIMD<Complex>> a(n,ks), b(m,ks);
+        Matrix<Complex> c(n,m);
+        a = SIMD<Complex>(Complex(1,1)); b = SIMD<Complex>(Complex(2,-1));
+        c = 0.0;
+        double tot = 4*double(n)*m*k;
+        int its = 1e10 / tot + 1;
+        {
+          Timer t("C += A*Bt, complex");
+          t.Start();
+          for (int j = 0; j < its; j++)
+            AddABt(a, b, c);
+          t.Stop();
+          cout << "AddABt complex GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("AddABt complex", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
+    if (what == 0 || what == 54)
+      {
+        // C += A*B^t, A real, B complex SIMD
+        if (k % SW != 0)
+          cout << "k should be a multiple of " << SW << endl;
+        size_t ks = k/SW;
+        Matrix<SIMD<double>> a(n,ks);
+        Matrix<SIMD<Complex>> b(m,ks);
+        Matrix<Complex> c(n,m);
+        a = SIMD<double>(1); b = SIMD<Complex>(Complex(2,-1));
+        c = 0.0;
+        double tot = 2*double(n)*m*k;
+        int its = 1e10 / tot + 1;
+        {
+          Timer t("C += A*Bt, real-complex");
+          t.Start();
+          for (int j = 0; j < its; j++)
+            AddABt(SliceMatrix<SIMD<double>>(a), SliceMatrix<SIMD<Complex>>(b), c);
+          t.Stop();
+          cout << "AddABt real-complex GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("AddABt real-complex", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
+    if (what == 0 || what == 220)
+      {
+        // LU factorization
+        Matrix<> a(n,n), lu(n,n);
+        Array<int> p(n);
+        a = 1;
+        a.Diag() = 10000;
+        double tot = double(n)*n*n/3;
+        int its = 1e9 / tot + 1;
+        {
+          Timer t("LUFactor");
+          t.Start();
+          for (int j = 0; j < its; j++)
+            {
+              lu = a;
+              LUFactor (lu, p);
+            }
+          t.Stop();
+          cout << "LUFactor GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("LUFactor", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
+    if (what == 0 || what == 221)
+      {
+        // Cholesky factorization
+        Matrix<> a(n,n), l(n,n);
+        a = 1;
+        a.Diag() = 10000;
+        double tot = double(n)*n*n/6;
+        int its = 1e9 / tot + 1;
+        {
+          Timer t("CholeskyFactor");
+          t.Start();
+          for (int j = 0; j < its; j++)
+            {
+              l = a;
+              CholeskyFactor (l);
+            }
+          t.Stop();
+          cout << "CholeskyFactor GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("CholeskyFactor", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
+    if (what == 0 || what == 222)
+      {
+        // LU based inverse
+        Matrix<> a(n,n);
+        a = 1;
+        a.Diag() = 10000;
+        double tot = double(n)*n*n;
+        int its = 1e9 / tot + 1;
+        {
+          Timer t("LUInverse");
+          t.Start();
+          for (int j = 0; j < its; j++)
+            LUInverse (a);
+          t.Stop();
+          cout << "LUInverse GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("LUInverse", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
+    if (what == 0 || what == 230)
+      {
+        // m products of n*n matrices
+        Matrix<> a(m*n,n), b(m*n,n), c(m*n,n);
+        a = 1; b = 2;
+        double tot = double(m)*n*n*n;
+        int its = 1e9 / tot + 1;
+        {
+          Timer t("BatchedMultMatMat");
+          t.Start();
+          for (int j = 0; j < its; j++)
+            BatchedMultMatMat (BatchedSliceMatrix<>(m, n, n, a.Data()),
+                               BatchedSliceMatrix<>(m, n, n, b.Data()),
+                               BatchedSliceMatrix<>(m, n, n, c.Data()));
+          t.Stop();
+          cout << "BatchedMultMatMat GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("BatchedMultMatMat", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
+    if (what == 0 || what == 231)
+      {
+        // m LU factorizations of n*n matrices
+        Matrix<> a(m*n,n), lu(m*n,n);
+        Array<int> p(m*n);
+        a = 1;
+        for (size_t i = 0; i < m*n; i++)
+          a(i, i%n) = 10000;
+        double tot = double(m)*n*n*n/3;
+        int its = 1e9 / tot + 1;
+        {
+          Timer t("BatchedLUFactor");
+          t.Start();
+          for (int j = 0; j < its; j++)
+            {
+              lu = a;
+              BatchedLUFactor (BatchedSliceMatrix<>(m, n, n, lu.Data()), p);
+            }
+          t.Stop();
+          cout << "BatchedLUFactor GFlops = " << 1e-9 * tot*its / t.GetTime() << endl;
+          timings.push_back(make_tuple("BatchedLUFactor", 1e-9 * tot*its / t.GetTime()));
+        }
+      }
+
     
     return timings;
   }
 
   
+
+  
+  /* ************************** sparse matrix-vector ********************** */
+
+  void MultAddCSR_intern (double s, size_t first, size_t next,
+                          const size_t * firsti, const int * colnr, const double * val,
+                          const double * x, double * y)
+  {
+    constexpr size_t SW = SIMD<double>::Size();
+    for (size_t i = first; i < next; i++)
+      {
+        size_t j = firsti[i], last = firsti[i+1];
+        SIMD<double> sum(0.0);
+        for ( ; j+SW <= last; j += SW)
+          {
+            SIMD<double> xj([x,colnr,j] (int k) { return x[colnr[j+k]]; });
+            sum += SIMD<double>(val+j) * xj;
+          }
+        double hsum = HSum(sum);
+        for ( ; j < last; j++)
+          hsum += val[j] * x[colnr[j]];
+        y[i] += s * hsum;
+      }
+  }
+
+  pmultadd_csr dispatch_multadd_csr = &MultAddCSR_intern;
+
+
+  
+  /* **************************** runtime ISA dispatch ********************** */
+
+  template <typename FUNC>
+  void ForEachDispatchTable (FUNC f)
+  {
+    auto table = [f] (const char * name, auto & tab)
+      { f (name, reinterpret_cast<void**>(&tab[0]), std::size(tab)); };
+    table ("matvec", dispatch_matvec);
+    table ("addmatvec", dispatch_addmatvec);
+    table ("mattransvec", dispatch_mattransvec);
+    table ("addmattransvec", dispatch_addmattransvec);
+    table ("addmattransvecI", dispatch_addmattransvecI);
+    table ("multAB", dispatch_multAB);
+    table ("addAB", dispatch_addAB);
+    table ("subAB", dispatch_subAB);
+    table ("atb", dispatch_atb);
+    table ("abt", dispatch_abt);
+    f ("multadd_csr", reinterpret_cast<void**>(&dispatch_multadd_csr), 1);
+  }
+
+  typedef void (*pset_dispatch_table)(const char * name, void ** table, size_t size);
+
+#ifdef NGS_ARCH_MODULE
+
+  // entry point of the ISA specific build, hands out its kernels
+  extern "C" NGS_DLL_HEADER void ngblas_arch_kernels (ArchKernels & kernels, pset_dispatch_table set_table)
+  {
+    kernels.multmattransvec = &MultMatTransVec_intern;
+    kernels.multaddmattransvec = &MultAddMatTransVec_intern;
+    kernels.multmatmat = &MultMatMat_intern;
+    kernels.minusmultab = &MinusMultAB_intern;
+    kernels.addab = &AddAB_intern;
+    kernels.subab = &SubAB_intern;
+    kernels.multatb = &MultAtB_intern;
+    kernels.multabt = &MultABt_intern;
+    kernels.minusmultabt = &MinusMultABt;
+    kernels.addabt = &AddABt;
+    kernels.subabt = &SubABt;
+    ForEachDispatchTable (set_table);
+  }
+  
+#else // NGS_ARCH_MODULE
+  
+  static string kernel_arch = "default";
+  string GetKernelArch() { return kernel_arch; }
+
+#ifndef WIN32
+  static const char * arch_names[] = { "default", "avx2", "avx512" };
+  
+  // highest level in arch_names supported by the CPU
+  static int CPUArchLevel ()
+  {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if (avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw"))
+      return 2;
+    if (avx2) return 1;
+#endif
+    return 0;
+  }
+
+  // level of the core library
+  static int CompiledArchLevel ()
+  {
+#if defined(__AVX512F__)
+    return 2;
+#elif defined(__AVX2__)
+    return 1;
+#else
+    return 0;
+#endif
+  }
+
+  static void CopyDispatchTable (const char * name, void ** table, size_t size)
+  {
+    ForEachDispatchTable ([&] (const char * myname, void ** mytable, size_t mysize)
+      {
+        if (strcmp (name, myname) == 0 && size == mysize)
+          for (size_t i = 0; i < size; i++)
+            mytable[i] = table[i];
+      });
+  }
+
+  // after the tables of this file are initialized
+  static int load_arch_kernels = [] ()
+  {
+    int level = CPUArchLevel();
+    if (const char * env = getenv ("NGS_BLAS_ARCH"))
+      {
+        auto pos = find (begin(arch_names), end(arch_names), string(env));
+        if (pos == end(arch_names))
+          {
+            cerr << "NGS_BLAS_ARCH = " << env << " unknown, use one of default, avx2, avx512" << endl;
+            return 0;
+          }
+        int requested = pos - begin(arch_names);
+        if (requested > level)
+          cerr << "NGS_BLAS_ARCH = " << env << " not supported by this CPU, using "
+               << arch_names[level] << endl;
+        level = min(requested, level);
+      }
+
+    // the ISA specific builds are next to this library
+    Dl_info info;
+    if (!dladdr (reinterpret_cast<void*>(&GetKernelArch), &info) || !info.dli_fname)
+      return 0;
+    string dir = info.dli_fname;
+    dir = dir.substr (0, dir.rfind('/')+1);
+    
+    for ( ; level > CompiledArchLevel(); level--)
+      try
+        {
+          auto lib = make_unique<SharedLibrary> (dir + "libngblas_" + arch_names[level] + ".so");
+          auto init = lib->GetFunction<void(*)(ArchKernels&, pset_dispatch_table)> ("ngblas_arch_kernels");
+          (*init) (arch_kernels, &CopyDispatchTable);
+          kernel_arch = arch_names[level];
+          lib.release();   // never unloaded, the kernel tables point into it
+          return 1;
+        }
+      catch (std::exception &)
+        {
+          ; // not built for this level, try the next one
+        }
+    return 0;
+  }();
+#endif // WIN32
+  
+#endif // NGS_ARCH_MODULE
+
 }
 
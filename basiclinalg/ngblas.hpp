@@ -11,6 +11,7 @@
 
 namespace ngbla
 {
+  template <class T> class FlatSymmetricMatrix;
 
   extern NGS_DLL_HEADER void MultMatVec_intern (BareSliceMatrix<> a, FlatVector<> x, FlatVector<> y);
   typedef void (*pmult_matvec)(BareSliceMatrix<>, FlatVector<>, FlatVector<>);
@@ -211,6 +212,9 @@ namespace ngbla
   //  copied from symbolicintegrator, needs some rework 
   extern NGS_DLL_HEADER void AddABtSym (SliceMatrix<double> a, SliceMatrix<double> b, BareSliceMatrix<double> c);    
   extern NGS_DLL_HEADER void AddABtSym (SliceMatrix<SIMD<double>> a, SliceMatrix<SIMD<double>> b, BareSliceMatrix<double> c);
+  /// lower triangle of a b^T is added to the diagonal block of c starting at row/col first
+  extern NGS_DLL_HEADER void AddABtSym (SliceMatrix<SIMD<double>> a, SliceMatrix<SIMD<double>> b,
+                                        FlatSymmetricMatrix<double> c, size_t first = 0);
   
   extern NGS_DLL_HEADER void AddABt (FlatMatrix<SIMD<Complex>> a, FlatMatrix<SIMD<Complex>> b, SliceMatrix<Complex> c);
   extern NGS_DLL_HEADER void AddABtSym (FlatMatrix<SIMD<Complex>> a, FlatMatrix<SIMD<Complex>> b, SliceMatrix<Complex> c);
@@ -253,6 +257,39 @@ namespace ngbla
 
   
 
+  // recursive dense factorizations on top of SubAB / SubABt (densefactor.cpp)
+
+  /// P A = L U in place, row i was exchanged with row p[i] in step i
+  extern NGS_DLL_HEADER void LUFactor (SliceMatrix<double> a, FlatArray<int> p);
+  /// solves A x = b with factors from LUFactor, b is overwritten
+  extern NGS_DLL_HEADER void LUSolve (SliceMatrix<double> lu, FlatArray<int> p, SliceMatrix<double> b);
+  /// in place inverse via LUFactor
+  extern NGS_DLL_HEADER void LUInverse (SliceMatrix<double> a);
+  /// A = L L^T, L in the lower triangle, the upper triangle is not touched
+  extern NGS_DLL_HEADER void CholeskyFactor (SliceMatrix<double> a);
+  /// solves L L^T x = b, b is overwritten
+  extern NGS_DLL_HEADER void CholeskySolve (SliceMatrix<double> l, SliceMatrix<double> b);
+  /// b = L^{-1} b, L lower triangular
+  extern NGS_DLL_HEADER void TriangularSolveLower (SliceMatrix<double> l, SliceMatrix<double> b);
+  /// b = L^{-T} b, L lower triangular
+  extern NGS_DLL_HEADER void TriangularSolveLowerTrans (SliceMatrix<double> l, SliceMatrix<double> b);
+
+  // dense symmetric eigenvalue problems (denseeigen.cpp)
+
+  /**
+     eigenvalues (ascending) and orthonormal eigenvectors (columns of evecs)
+     of the symmetric matrix a, a is overwritten
+   */
+  extern NGS_DLL_HEADER void SymmetricEigenSystem (SliceMatrix<double> a, FlatVector<double> lami,
+                                                   SliceMatrix<double> evecs);
+  /**
+     generalized problem a x = lam b x, b symmetric positive definite.
+     Eigenvectors are b-orthonormal, a and b are overwritten
+   */
+  extern NGS_DLL_HEADER void SymmetricEigenSystem (SliceMatrix<double> a, SliceMatrix<double> b,
+                                                   FlatVector<double> lami, SliceMatrix<double> evecs);
+
+
   // for Cholesky and SparseCholesky
   extern NGS_DLL_HEADER
   void SubADBt (SliceMatrix<double> a,
@@ -501,6 +538,28 @@ namespace ngbla
     MultAddMatTransVec (-1,Trans(a),x,y);
   }
 
+
+
+  /// y(rows) += s * A(rows,:) x, A in compressed row storage
+  typedef void (*pmultadd_csr)(double s, size_t first, size_t next,
+                               const size_t * firsti, const int * colnr, const double * val,
+                               const double * x, double * y);
+  extern NGS_DLL_HEADER pmultadd_csr dispatch_multadd_csr;
+  INLINE void MultAddCSR (double s, IntRange rows,
+                          const size_t * firsti, const int * colnr, const double * val,
+                          const double * x, double * y)
+  {
+    (*dispatch_multadd_csr) (s, rows.First(), rows.Next(), firsti, colnr, val, x, y);
+  }
+
+
+  /**
+     ISA level of the dispatched kernels ("default", "avx2", "avx512").
+     The kernel tables are filled from an ISA specific build of ngblas
+     if the CPU supports more than the core library was compiled for.
+     The environment variable NGS_BLAS_ARCH selects the level.
+  */
+  extern NGS_DLL_HEADER string GetKernelArch();
   
   extern list<tuple<string,double>> Timing (int what, size_t n, size_t m, size_t k, bool lapack);
 
@@ -529,6 +529,23 @@ vals : tuple
 	    CalcInverse(self,inv); return;
 	  });
         class_FMD.def_property_readonly("I", py::cpp_function([](FMD &self) { return Inv(self); } ) );        
+        class_FMD.def("SymmetricEigenSystem", [](FMD & self)
+                      {
+                        size_t n = self.Height();
+                        Matrix<double> a = self, evecs(n,n);
+                        Vector<double> lami(n);
+                        SymmetricEigenSystem (a, lami, evecs);
+                        return py::make_tuple (lami, evecs);
+                      }, "eigenvalues (ascending) and eigenvectors (columns) of the symmetric matrix");
+        class_FMD.def("SymmetricEigenSystem", [](FMD & self, FMD & b)
+                      {
+                        size_t n = self.Height();
+                        Matrix<double> a = self, hb = b, evecs(n,n);
+                        Vector<double> lami(n);
+                        SymmetricEigenSystem (a, hb, lami, evecs);
+                        return py::make_tuple (lami, evecs);
+                      }, py::arg("b"),
+                      "eigenvalues (ascending) and b-orthonormal eigenvectors of self x = lam b x, b positive definite");
         class_FMD.def("__str__", &ToString<FMD>);
         class_FMD.def("__repr__", &ToString<FMD>);
         PyDefMatBuffer<FMD>(class_FMD);
@@ -659,6 +676,7 @@ complex : bool
           { return py::object(x.attr("Norm")) (); }, py::arg("x"),"Compute Norm");
 
     m.def("__timing__", &ngbla::Timing, py::arg("what"), py::arg("n"), py::arg("m"), py::arg("k"), py::arg("lapack")=false);
+    m.def("__kernel_arch__", &ngbla::GetKernelArch, "instruction set of the ngblas kernels selected at runtime");
     m.def("CheckPerformance",
              [] (size_t n, size_t m, size_t k)
                               {
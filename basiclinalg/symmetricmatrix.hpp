@@ -13,13 +13,16 @@ namespace ngbla
 
 
 
-  /// A symmetric band-matrix
+  /**
+     A symmetric matrix, the lower triangle is stored row by row:
+     entry (i,j), j <= i, is at position i*(i+1)/2+j
+  */
   template <class T>
   class FlatSymmetricMatrix
   {
   protected:
     ///
-    int n;
+    size_t n;
     ///
     T *data;
   public:
@@ -29,27 +32,34 @@ namespace ngbla
     FlatSymmetricMatrix () { ; }
 
     ///
-    FlatSymmetricMatrix (int an, T * adata)
+    FlatSymmetricMatrix (size_t an, T * adata)
       : n(an), data(adata)
     { ; }
 
+    /// allocate memory from local heap
+    FlatSymmetricMatrix (size_t an, LocalHeap & lh)
+      : n(an), data(lh.Alloc<T>(PackedSize(an)))
+    { ; }
+
     /// set size, and assign mem
-    void AssignMemory (int an, T * mem) throw()
+    void AssignMemory (size_t an, T * mem) throw()
     {
       n = an;
       data = mem;
     }
-  
+
+    /// number of stored entries of a n x n matrix
+    static constexpr size_t PackedSize (size_t size) { return size*(size+1)/2; }
 
 
     ///
     void Mult (const FlatVector<TV> & x, FlatVector<TV> & y) const
     {
-      for (int i = 0; i < n; i++)
+      for (size_t i = 0; i < n; i++)
         {
           TV xi = x(i);
           TV sum = (*this)(i,i) * xi;
-          for (int j = 0; j < i; j++)
+          for (size_t j = 0; j < i; j++)
             {
               sum += (*this)(i,j) * x(j);
               y(j) += Trans((*this)(i,j)) * xi;
@@ -61,39 +71,68 @@ namespace ngbla
     ///
     ostream & Print (ostream & ost) const
     {
-      for (int i = 0; i < n; i++)
+      for (size_t i = 0; i < n; i++)
         {
-          for (int j = 0; j < n; j++)
+          for (size_t j = 0; j < n; j++)
             if (j <= i)
               ost << setw(8) << (*this)(i,j) << " ";
             else 
               ost << setw(8) << "sym" << " ";
           ost << endl;
         }
-      return *this;
+      return ost;
     }
 
     ///
-    int Height() const { return n; }
-
-  
+    size_t Height() const { return n; }
     ///
-    const T & operator() (int i, int j) const
+    size_t Width() const { return n; }
+    ///
+    T * Data() const { return data; }
+  
+    /// j <= i
+    const T & operator() (size_t i, size_t j) const
     { return data[ i * (i+1) / 2 + j ]; }
 
-    ///
-    T & operator() (int i, int j) 
+    /// j <= i
+    T & operator() (size_t i, size_t j) 
     { return data[ i * (i+1) / 2 + j ]; }
 
+    /// the stored part of row i, columns 0 ... i
+    FlatVector<T> Row (size_t i) const
+    { return FlatVector<T> (i+1, data + i*(i+1)/2); }
   
     ///
     FlatSymmetricMatrix & operator= (const T & val)
     {
-      int nel = n * (n+1) / 2;
-      for (int i = 0; i < nel; i++)
+      size_t nel = PackedSize(n);
+      for (size_t i = 0; i < nel; i++)
         data[i] = val;
       return *this;
     }
+
+    /// add the lower triangle of the n x n matrix m
+    void AddLower (BareSliceMatrix<T> m)
+    {
+      for (size_t i = 0; i < n; i++)
+        {
+          T * rowi = data + i*(i+1)/2;
+          for (size_t j = 0; j <= i; j++)
+            rowi[j] += m(i,j);
+        }
+    }
+
+    /// copy to both triangles of the n x n matrix m
+    void Expand (BareSliceMatrix<T> m) const
+    {
+      for (size_t i = 0; i < n; i++)
+        {
+          T * rowi = data + i*(i+1)/2;
+          for (size_t j = 0; j < i; j++)
+            m(i,j) = m(j,i) = rowi[j];
+          m(i,i) = rowi[i];
+        }
+    }
   };
 
 
@@ -114,7 +153,7 @@ namespace ngbla
     typedef typename mat_traits<T>::TV_COL TV;
 
     ///
-    SymmetricMatrix (int an)
+    SymmetricMatrix (size_t an)
       : FlatSymmetricMatrix<T> (an, new T[an*(an+1)/2])
     { ; }
 
@@ -125,8 +164,8 @@ namespace ngbla
     ///
     SymmetricMatrix & operator= (const T & val)
     {
-      int nel = this->n * (this->n+1) / 2;
-      for (int i = 0; i < nel; i++)
+      size_t nel = this->PackedSize(this->n);
+      for (size_t i = 0; i < nel; i++)
         this->data[i] = val;
       return *this;
     }
@@ -138,6 +177,33 @@ namespace ngbla
 
 
 
+  /**
+     Block entries (i,j) of a packed symmetric scalar matrix,
+     the packed counterpart of Scalar2ElemMatrix
+  */
+  template <class TM, class TSCAL>
+  class PackedScalar2ElemMatrix
+  {
+  public:
+    const FlatSymmetricMatrix<TSCAL> mat;
+    PackedScalar2ElemMatrix (const FlatSymmetricMatrix<TSCAL> amat) : mat(amat) { ; }
+
+    enum { H = mat_traits<TM>::HEIGHT };
+    enum { W = mat_traits<TM>::WIDTH };
+
+    TM operator() (size_t i, size_t j) const
+    {
+      TM ret;
+      for (size_t k = 0; k < H; k++)
+	for (size_t l = 0; l < W; l++)
+          {
+            size_t r = i*H+k, c = j*W+l;
+            Access(ret, k,l) = (r >= c) ? mat(r,c) : mat(c,r);
+          }
+      return ret;
+    }
+  };
+
 }
 
 
@@ -100,6 +100,7 @@ namespace ngcomp
     checksum = flags.GetDefineFlag ("checksum");
     spd = flags.GetDefineFlag ("spd");
     geom_free = flags.GetDefineFlag("geom_free");    
+    geom_free_affine = flags.GetDefineFlag("geom_free_affine");
     if (spd) symmetric = true;
     SetCheckUnused (!flags.GetDefineFlagX("check_unused").IsFalse());
   }
@@ -154,6 +155,7 @@ namespace ngcomp
                      !flags.GetDefineFlag ("nokeep_internal"));
     if (flags.GetDefineFlag ("store_inner")) SetStoreInner (1);
     geom_free = flags.GetDefineFlag("geom_free");
+    geom_free_affine = flags.GetDefineFlag("geom_free_affine");
     
     precompute = flags.GetDefineFlag ("precompute");
     checksum = flags.GetDefineFlag ("checksum");
@@ -204,7 +206,7 @@ namespace ngcomp
 
     parts.Append (bfi);
 
-    if ((bfi->geom_free && nonassemble) || geom_free)
+    if ((bfi->geom_free && nonassemble) || geom_free || geom_free_affine)
       {
         geom_free_parts += bfi;
         return *this;
@@ -574,6 +576,11 @@ namespace ngcomp
     if (mats.Size() == ma->GetNLevels())
       return;
 
+    if (geom_free_affine)
+      {
+        AssembleAffineGF(lh);
+        return;
+      }
 
     if (nonassemble)
       {
@@ -813,6 +820,111 @@ namespace ngcomp
     mats.Last() = sum;
   }
 
+
+  void BilinearForm :: AssembleAffineGF (LocalHeap & clh)
+  {
+    static Timer t("BilinearForm::AssembleAffineGF");
+    RegionTimer reg(t);
+    
+    auto fesx = GetTrialSpace();
+    auto fesy = GetTestSpace();
+    if (fesx->IsComplex() || fesy->IsComplex())
+      throw Exception ("geom_free_affine is available for real-valued forms only");
+
+    Array<shared_ptr<SymbolicBilinearFormIntegrator>> affine_parts;
+    for (auto bfi : geom_free_parts)
+      {
+        auto sbfi = dynamic_pointer_cast<SymbolicBilinearFormIntegrator> (bfi);
+        if (!sbfi || !sbfi->SupportsAffineFactorization())
+          throw Exception ("geom_free_affine needs element-wise constant symbolic volume integrators, got "
+                           + bfi->Name());
+        affine_parts += sbfi;
+      }
+
+    shared_ptr<BaseMatrix> sum;
+    
+    for (auto elclass_inds : ma->GetElementsOfClass())
+      {
+        if (elclass_inds.Size() == 0) continue;
+        HeapReset hr(clh);
+        
+        ElementId ei(VOL, elclass_inds[0]);
+        ELEMENT_TYPE et = ma->GetElType(ei);
+        if (et != ET_TRIG && et != ET_TET)
+          throw Exception ("geom_free_affine is available for simplicial meshes only");
+        
+        auto & felx = fesx->GetFE (ei, clh);
+        auto & fely = fesy->GetFE (ei, clh);
+        MixedFiniteElement fel(felx, fely);
+        
+        for (auto bfi : affine_parts)
+          {
+            HeapReset hr(clh);
+            size_t nip = bfi->GetIntegrationRule(fel, clh).Size();
+            size_t dimx = bfi->GetAffineTrialDim();
+            size_t dimy = bfi->GetAffineTestDim();
+
+            Matrix<> bmatx(nip*dimx, felx.GetNDof());
+            Matrix<> bmaty(nip*dimy, fely.GetNDof());
+            bfi->CalcReferenceOperators (fel, bmatx, bmaty, clh);
+
+            Matrix<> coefs(elclass_inds.Size(), dimx*dimy);
+            ParallelForRange
+              (elclass_inds.Size(), [&] (IntRange r)
+               {
+                 LocalHeap lh = clh.Split();
+                 for (auto i : r)
+                   {
+                     HeapReset hr(lh);
+                     ElementId ei(VOL, elclass_inds[i]);
+                     if (ma->GetElType(ei) != et)
+                       throw Exception ("geom_free_affine: element types in one class differ");
+                     
+                     FlatMatrix<> elcoefs(dimx, dimy, &coefs(i,0));
+                     if (!bfi->DefinedOn (ma->GetElIndex (ei)))
+                       {
+                         elcoefs = 0.0;
+                         continue;
+                       }
+                     auto & felx = fesx->GetFE (ei, lh);
+                     auto & fely = fesy->GetFE (ei, lh);
+                     MixedFiniteElement fel(felx, fely);
+                     auto & trafo = ma->GetTrafo (ei, lh);
+                     bfi->CalcAffineCoefficients (fel, trafo, elcoefs, lh);
+                   }
+               });
+
+            Table<DofId> xdofs(elclass_inds.Size(), felx.GetNDof()),
+              ydofs(elclass_inds.Size(), fely.GetNDof());
+        
+            Array<DofId> dnumsx, dnumsy;
+            for (auto i : Range(elclass_inds))
+              {
+                ElementId ei(VOL, elclass_inds[i]);
+                fesx->GetDofNrs(ei, dnumsx);
+                fesy->GetDofNrs(ei, dnumsy);
+                if (dnumsx.Size() != felx.GetNDof() || dnumsy.Size() != fely.GetNDof())
+                  throw Exception ("geom_free_affine: elements of one class must have the same number of dofs");
+                xdofs[i] = dnumsx;
+                ydofs[i] = dnumsy;
+              }
+
+            auto mat = make_shared<FactorizedElementByElementMatrix>
+              (fesy->GetNDof(), fesx->GetNDof(), nip,
+               std::move(bmatx), std::move(bmaty), std::move(coefs),
+               std::move(ydofs), std::move(xdofs));
+            
+            if (sum)
+              sum = make_shared<SumMatrix>(sum, mat);
+            else
+              sum = mat;
+          }
+      }
+    
+    mats.SetSize (ma->GetNLevels());
+    mats.Last() = sum;
+  }
+
   
 
   void BilinearForm :: ReAssemble (LocalHeap & lh, bool reallocate)
@@ -823,6 +935,15 @@ namespace ngcomp
         return;
       }
 
+    if (geom_free_affine)
+      {
+        // element coefficients depend on the geometry, rebuild them
+        if (mats.Size() == ma->GetNLevels())
+          mats.DeleteLast();
+        Assemble(lh);
+        return;
+      }
+
     if (low_order_bilinear_form)
       low_order_bilinear_form->ReAssemble(lh);
 
@@ -1145,6 +1266,14 @@ namespace ngcomp
                 else // not diagonal
                   {
                     ProgressOutput progress(ma,string("assemble ") + ToString(vb) + string(" element"), ma->GetNE(vb));
+
+                    // symmetric element matrices are computed, condensed and added in packed
+                    // lower triangular storage, the full matrix is built only for
+                    // preconditioners and debug output
+                    bool packed_elmats = is_same<SCAL,double>::value &&
+                      SupportsPackedElementMatrices() &&
+                      !(eliminate_internal && keep_internal && store_inner);
+                    
                     /*
                     if ( (vb == VOL || (!VB_parts[VOL].Size() && vb==BND) ) && eliminate_internal && keep_internal)
                       {
@@ -1181,6 +1310,183 @@ namespace ngcomp
                            }
                          
                          int elmat_size = dnums.Size()*fespace->GetDimension();
+
+                         if constexpr (is_same<SCAL,double>::value)
+                           if (packed_elmats)
+                             {
+                               static Timer elmattimer("calc elmats packed", 2);
+                               FlatSymmetricMatrix<double> sum_elmat(elmat_size, lh);
+                               bool elem_has_integrator = false;
+                               {
+                                 ThreadRegionTimer reg (elmattimer, TaskManager::GetThreadId());
+                                 bool done = false;
+                                 while (!done)
+                                   {
+                                     done = true;
+                                     sum_elmat = 0;
+                                     for (auto & bfip : VB_parts[vb])
+                                       {
+                                         const BilinearFormIntegrator & bfi = *bfip;
+                                         if (!bfi.DefinedOn (el.GetIndex())) continue;                        
+                                         if (!bfi.DefinedOnElement (el.Nr())) continue;                        
+                                         
+                                         elem_has_integrator = true;
+                                         try
+                                           {
+                                             auto & mapped_trafo = eltrans.AddDeformation(bfi.GetDeformation().get(), lh);
+                                             bfi.CalcElementMatrixSymmetricAdd (fel, mapped_trafo, sum_elmat, lh);
+                                           }
+                                         catch (ExceptionNOSIMD & e)
+                                           {
+                                             done = false;
+                                           }
+                                       }
+                                   }
+                               }
+                               if (!elem_has_integrator) return;
+
+                               if (fespace->NeedsTransformVec())
+                                 {
+                                   HeapReset hr(lh);
+                                   FlatMatrix<double> full(elmat_size, lh);
+                                   sum_elmat.Expand (full);
+                                   fespace->TransformMat (el, full, TRANSFORM_MAT_LEFT_RIGHT);
+                                   sum_elmat = 0.0;
+                                   sum_elmat.AddLower (full);
+                                 }
+
+                               bool has_hidden = false;
+                               if (eliminate_hidden || eliminate_internal)
+                                 for (auto d : dnums)
+                                   if (fespace->GetDofCouplingType(d) & HIDDEN_DOF)
+                                     has_hidden = true;
+                               
+                               bool elim_only_hidden = (!eliminate_internal) && eliminate_hidden && has_hidden;
+                               if ((vb == VOL || (!VB_parts[VOL].Size() && vb==BND) ) && (elim_only_hidden || eliminate_internal))
+                                 {
+                                   static Timer statcondtimer("static condensation packed", 2);
+                                   ThreadRegionTimer regstat (statcondtimer, TaskManager::GetThreadId());
+                                   
+                                   Array<int> idofs1(dnums.Size(), lh), odofs1(dnums.Size(), lh);
+                                   idofs1.SetSize0(); odofs1.SetSize0();
+                                   
+                                   auto ctype = elim_only_hidden ? HIDDEN_DOF : CONDENSABLE_DOF;
+                                   for (auto i : Range(dnums))
+                                     {
+                                       auto ct = fespace->GetDofCouplingType(dnums[i]);
+                                       if (ct & ctype)
+                                         idofs1.AppendHaveMem(i);
+                                       else
+                                         if (ct != UNUSED_DOF)
+                                           odofs1.AppendHaveMem(i);
+                                     }
+                                   
+                                   if (idofs1.Size())
+                                     {
+                                       HeapReset hr (lh);
+                                       int dim = fespace->GetDimension();
+                                       int sizei = dim * idofs1.Size();
+                                       int sizeo = dim * odofs1.Size();
+                                       
+                                       FlatArray<int> idofs (sizei, lh);
+                                       FlatArray<int> odofs (sizeo, lh);
+                                       for (int j = 0, k = 0; j < idofs1.Size(); j++)
+                                         for (int jj = 0; jj < dim; jj++)
+                                           idofs[k++] = dim*idofs1[j]+jj;
+                                       for (int j = 0, k = 0; j < odofs1.Size(); j++)
+                                         for (int jj = 0; jj < dim; jj++)
+                                           odofs[k++] = dim*odofs1[j]+jj;
+
+                                       // entry (i,j) from the stored triangle
+                                       auto entry = [&] (int i, int j)
+                                         { return (i >= j) ? sum_elmat(i,j) : sum_elmat(j,i); };
+                                       
+                                       FlatMatrix<double> b(sizeo, sizei, lh), d(sizei, sizei, lh);
+                                       for (int k = 0; k < sizeo; k++)
+                                         for (int j = 0; j < sizei; j++)
+                                           b(k,j) = entry(odofs[k], idofs[j]);
+                                       for (int k = 0; k < sizei; k++)
+                                         for (int j = 0; j < sizei; j++)
+                                           d(k,j) = entry(idofs[k], idofs[j]);
+
+                                       // A := A - B D^{-1} B^T = A + B he,  he = -D^{-1} B^T
+                                       CalcInverse (d);
+                                       FlatMatrix<double> he (sizei, sizeo, lh);
+                                       he = -d * Trans(b);
+                                       
+                                       if (keep_internal && !elim_only_hidden)
+                                         {
+                                           Array<int> idnums(sizei, lh), ednums(sizeo, lh);
+                                           idnums.SetSize0(); 
+                                           ednums.SetSize0();
+                                           for (int i : idofs1)
+                                             {
+                                               DofId dof = dnums[i];
+                                               if (fespace->GetDofCouplingType(dof) == HIDDEN_DOF)
+                                                 for (int k = 0; k < dim; k++)
+                                                   idnums.AppendHaveMem(NO_DOF_NR_CONDENSE);
+                                               else
+                                                 idnums += dim*IntRange(dof, dof+1);
+                                             }
+                                           for (int i : odofs1)
+                                             ednums += dim*IntRange(dnums[i], dnums[i]+1);
+                                           
+                                           harmonicext ->AddElementMatrix(el.Nr(),idnums,ednums,he);
+                                           innersolve ->AddElementMatrix(el.Nr(),idnums,idnums,d);
+                                         }
+
+                                       FlatMatrix<double> bhe (sizeo, sizeo, lh);
+                                       bhe = b * he;
+                                       for (int k = 0; k < sizeo; k++)
+                                         for (int j = 0; j <= k; j++)
+                                           sum_elmat(odofs[k], odofs[j]) += bhe(k,j);
+                                       
+                                       if (linearform && (!keep_internal))
+                                         {
+                                           FlatVector<double> elvec (elmat_size, lh);
+                                           linearform -> GetVector().GetIndirect (dnums, elvec);
+                                           FlatVector<double> hfi(sizei, lh);
+                                           FlatVector<double> hfo(sizeo, lh);
+                                           
+                                           hfi = elvec(idofs);
+                                           hfo = Trans(he) * hfi;
+                                           elvec(odofs) += hfo;
+                                           
+                                           linearform->GetVector().SetIndirect (dnums, elvec);
+                                         }
+                                       
+                                       for (int k = 0; k < idofs1.Size(); k++)
+                                         dnums[idofs1[k]] = NO_DOF_NR;
+                                     }
+                                 }
+
+                               if (printelmat || elmat_ev || preconditioners.Size())
+                                 {
+                                   HeapReset hr(lh);
+                                   FlatMatrix<double> full(elmat_size, lh);
+                                   sum_elmat.Expand (full);
+                                   if (printelmat)
+                                     {
+                                       lock_guard<mutex> guard(printelmat_mutex);
+                                       *testout<< "elem " << el << ", elmat = " << endl << full << endl;
+                                     }
+                                   for (auto pre : preconditioners)
+                                     pre -> AddElementMatrix (dnums, full, el, lh);
+                                   if (elmat_ev)
+                                     {
+                                       (*testout) << "sum matrix:" << endl;
+                                       LapackEigenSystem(full, lh);
+                                     }
+                                 }
+                               
+                               AddElementMatrixSymmetric (dnums, sum_elmat, el, lh);
+                               
+                               if (check_unused)
+                                 for (auto d : dnums)
+                                   if (IsRegularDof(d)) useddof[d] = true;
+                               return;
+                             }
+                         
                          FlatMatrix<SCAL> sum_elmat(elmat_size, lh);
 			 bool elem_has_integrator = false;
 
@@ -5798,6 +6104,16 @@ namespace ngcomp
     mymatrix -> TMATRIX::AddElementMatrixSymmetric (dnums1, elmat, this->fespace->HasAtomicDofs());
   }
 
+  template <class TM, class TV>
+  void T_BilinearFormSymmetric<TM,TV> :: 
+  AddElementMatrixSymmetric (FlatArray<int> dnums,
+                             FlatSymmetricMatrix<TSCAL> elmat,
+                             ElementId id, 
+                             LocalHeap & lh) 
+  {
+    mymatrix -> TMATRIX::AddElementMatrixSymmetric (dnums, elmat, this->fespace->HasAtomicDofs());
+  }
+
 
 
 
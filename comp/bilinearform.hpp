@@ -34,6 +34,8 @@ namespace ngcomp
     bool diagonal;
     /// element-matrix for ref-elements
     bool geom_free;
+    /// reference operators and element-wise coefficients for affine elements
+    bool geom_free_affine;
     /// store matrices on mesh hierarchy
     bool multilevel;
     /// galerkin projection of coarse grid matrices
@@ -418,6 +420,7 @@ namespace ngcomp
     /// assemble matrix
     virtual void DoAssemble (LocalHeap & lh) = 0;
     void AssembleGF (LocalHeap & lh);
+    void AssembleAffineGF (LocalHeap & lh);
 
     /// allocates (sparse) matrix data-structure
     virtual void AllocateMatrix () = 0;
@@ -570,6 +573,17 @@ namespace ngcomp
 				   ElementId id, 
 				   LocalHeap & lh) = 0;
 
+    /// element matrix in packed lower triangular storage
+    virtual void AddElementMatrixSymmetric (FlatArray<int> dnums,
+                                            FlatSymmetricMatrix<SCAL> elmat,
+                                            ElementId id, 
+                                            LocalHeap & lh)
+    {
+      throw Exception ("AddElementMatrixSymmetric not available for this bilinear-form");
+    }
+    /// can element matrices be added by AddElementMatrixSymmetric ?
+    virtual bool SupportsPackedElementMatrices () const { return false; }
+
     /*
     virtual void ApplyElementMatrix(const BaseVector & x,
 				    BaseVector & y,
@@ -703,6 +717,12 @@ namespace ngcomp
                                    BareSliceMatrix<TSCAL> elmat,
 				   ElementId id, 
 				   LocalHeap & lh);
+
+    virtual void AddElementMatrixSymmetric (FlatArray<int> dnums,
+                                            FlatSymmetricMatrix<TSCAL> elmat,
+                                            ElementId id, 
+                                            LocalHeap & lh) override;
+    virtual bool SupportsPackedElementMatrices () const override { return true; }
     /*
     virtual void ApplyElementMatrix(const BaseVector & x,
 				    BaseVector & y,
@@ -120,9 +120,9 @@ namespace ngcomp
 	     ElementId eid(vb, i);
 	     Ngs_Element el = ma->GetElement(eid);
 	     if ( (!space_a->DefinedOn(vb, el.GetIndex())) || (!space_b->DefinedOn(vb, el.GetIndex())) )
-	       { return; }
+	       { continue; }
 	     if ( reg && !reg->Mask().Test(el.GetIndex()) )
-	       { return; }
+	       { continue; }
 	     space_a->GetDofNrs(eid, dnums_a, ANY_DOF); // get rid of UNUSED DOFs
 	     maxdsa = max2(maxdsa, int(dnums_a.Size()));
 	     for (auto da : dnums_a)
@@ -306,4 +306,218 @@ namespace ngcomp
     return op;
   } // ConvertOperator
 
+
+  shared_ptr<BaseMatrix> TransferOperator (shared_ptr<FESpace> space_a, shared_ptr<FESpace> space_b, LocalHeap & clh)
+  {
+    /** The matrix of gfb.Set(gfa): local L2-projection into space_b, averaged, where gfa may live on a different mesh **/
+    static Timer t("TransferOperator"), tloc("TransferOperator - locate points"), tfill("TransferOperator - fill");
+    RegionTimer reg(t);
+
+    if ( space_a->IsComplex() || space_b->IsComplex() )
+      { throw Exception("TransferOperator: only real spaces are supported!"); }
+    if ( space_a->IsParallel() || space_b->IsParallel() )
+      { throw Exception("TransferOperator: MPI-parallel spaces are not supported!"); }
+    if ( (space_a->GetDimension() != 1) || (space_b->GetDimension() != 1) )
+      { throw Exception("TransferOperator: spaces with dim > 1 are not supported, use VectorH1 etc. instead!"); }
+
+    auto ma_a = space_a->GetMeshAccess();
+    auto ma_b = space_b->GetMeshAccess();
+    bool same_mesh = (ma_a == ma_b);
+    if (ma_a->GetDimension() != ma_b->GetDimension())
+      { throw Exception("TransferOperator: meshes of different dimension!"); }
+
+    auto eval_a = space_a->GetEvaluator(VOL);
+    auto eval_b = space_b->GetEvaluator(VOL);
+    if ( !eval_a || !eval_b )
+      { throw Exception("TransferOperator: spaces need an evaluator on VOL!"); }
+    int dimflux = eval_b->Dim();
+    if ( eval_a->Dim() != dimflux )
+      { throw Exception(string("Cannot transfer from ") + space_a->GetClassName() + string(" to ") + space_b->GetClassName() +
+			string(" - dimensions mismatch: ") + to_string(eval_a->Dim()) +
+			string(" != ") + to_string(dimflux) + string("!")); }
+
+    /** Integration points of the elements of space_b, located in the mesh of space_a **/
+    size_t ne = ma_b->GetNE(VOL);
+    int dim = ma_b->GetDimension();
+    Array<size_t> firstpoint(ne+1);
+    firstpoint[0] = 0;
+    ParallelForRange
+      (ne, [&](IntRange r)
+       {
+	 LocalHeap lh = clh.Split();
+	 for (auto i : r) {
+	   HeapReset hr(lh);
+	   ElementId ei(VOL, i);
+	   firstpoint[i+1] = 0;
+	   if (space_b->DefinedOn(ei))
+	     firstpoint[i+1] = IntegrationRule(ma_b->GetElType(ei), 2*space_b->GetFE(ei, lh).Order()).Size();
+	 }
+       });
+    for (size_t i = 0; i < ne; i++)
+      firstpoint[i+1] += firstpoint[i];
+    size_t npoints = firstpoint[ne];
+
+    Matrix<> points(npoints, dim);
+    Array<int> srcel(npoints);
+    Array<IntegrationPoint> srcip(npoints);
+    ParallelForRange
+      (ne, [&](IntRange r)
+       {
+	 LocalHeap lh = clh.Split();
+	 for (auto i : r) {
+	   HeapReset hr(lh);
+	   ElementId ei(VOL, i);
+	   size_t first = firstpoint[i];
+	   if (firstpoint[i+1] == first)
+	     { continue; }
+	   IntegrationRule ir(ma_b->GetElType(ei), 2*space_b->GetFE(ei, lh).Order());
+	   auto & mir = ma_b->GetTrafo(ei, lh)(ir, lh);
+	   for (size_t q : Range(ir)) {
+	     points.Row(first+q) = mir[q].GetPoint();
+	     srcel[first+q] = same_mesh ? int(i) : -1;
+	     srcip[first+q] = ir[q];
+	   }
+	 }
+       });
+
+    if (!same_mesh)
+      {
+	RegionTimer rloc(tloc);
+	ma_a->FindElementsOfPoints(points, srcel, srcip);
+	size_t nlost = 0;
+	for (auto el : srcel)
+	  if (el < 0 || !space_a->DefinedOn(ElementId(VOL, el)))
+	    nlost++;
+	if (nlost)
+	  cout << IM(3) << "TransferOperator: " << nlost << " of " << npoints
+	       << " integration points not found in the mesh of spacea, treated as zero" << endl;
+      }
+
+    // distinct source elements hit by the points of target element i
+    auto source_elements = [&](size_t i, Array<int> & hit)
+      {
+	hit.SetSize0();
+	for (auto el : srcel.Range(firstpoint[i], firstpoint[i+1]))
+	  if (el >= 0 && !hit.Contains(el) && space_a->DefinedOn(ElementId(VOL, el)))
+	    hit.Append(el);
+      };
+
+    /** Matrix graph: rows are dofs of the target element, columns the dofs of all source elements hit **/
+    TableCreator<int> crnrs(ne), ccnrs(ne);
+    for (; !crnrs.Done(); crnrs++, ccnrs++ )
+      ParallelForRange
+	(ne, [&](IntRange r)
+	 {
+	   Array<DofId> dnums, cols;
+	   Array<int> hit;
+	   for (auto i : r) {
+	     source_elements(i, hit);
+	     if (hit.Size() == 0)
+	       { continue; }
+	     space_b->GetDofNrs(ElementId(VOL, i), dnums);
+	     for (auto d : dnums)
+	       if (IsRegularDof(d))
+		 { crnrs.Add(i, d); }
+	     cols.SetSize0();
+	     for (auto el : hit) {
+	       space_a->GetDofNrs(ElementId(VOL, el), dnums);
+	       for (auto d : dnums)
+		 if (IsRegularDof(d))
+		   { cols.Append(d); }
+	     }
+	     QuickSort(cols);
+	     for (auto k : Range(cols))
+	       if (k == 0 || cols[k] != cols[k-1])
+		 { ccnrs.Add(i, cols[k]); }
+	   }
+	 });
+
+    Table<int> rnrs = crnrs.MoveTable(), cnrs = ccnrs.MoveTable();
+    MatrixGraph graph (space_b->GetNDof(), space_a->GetNDof(), rnrs, cnrs, false);
+    auto spmat = make_shared<SparseMatrix<double>>(graph, true);
+    spmat->AsVector() = 0;
+
+    /** Fill, conflict free by the element coloring of space_b **/
+    Array<int> cnt_b(space_b->GetNDof()); cnt_b = 0;
+    {
+      RegionTimer rfill(tfill);
+      IterateElements
+	(*space_b, VOL, clh, [&](FESpace::Element fei, LocalHeap & lh)
+	 {
+	   size_t i = fei.Nr();
+	   Array<int> hit;
+	   source_elements(i, hit);
+	   if (hit.Size() == 0)
+	     { return; }
+	   
+	   const FiniteElement & felb = fei.GetFE();
+	   IntegrationRule ir(felb.ElementType(), 2*felb.Order());
+	   auto & mir = fei.GetTrafo()(ir, lh);
+	   size_t nip = ir.Size(), ndofb = felb.GetNDof();
+
+	   /** inverse mass matrix of the target element **/
+	   FlatMatrix<double,ColMajor> bmat(dimflux*nip, ndofb, lh), bwmat(dimflux*nip, ndofb, lh);
+	   eval_b->CalcMatrix(felb, mir, bmat, lh);
+	   for (size_t q : Range(nip))
+	     bwmat.Rows(q*dimflux, (q+1)*dimflux) = mir[q].GetWeight() * bmat.Rows(q*dimflux, (q+1)*dimflux);
+	   FlatMatrix<> minv(ndofb, ndofb, lh);
+	   minv = Trans(bwmat) * bmat;
+	   CalcInverse(minv);
+
+	   /** rhs of the source shape functions, one source element after the other **/
+	   size_t first = firstpoint[i];
+	   Array<int> dnums_a;
+	   for (auto el : hit) {
+	     HeapReset hr(lh);
+	     ArrayMem<int,100> qs;
+	     for (size_t q : Range(nip))
+	       if (srcel[first+q] == el)
+		 { qs.Append(q); }
+	     
+	     IntegrationRule ira(qs.Size(), lh);
+	     for (auto k : Range(qs))
+	       { ira[k] = srcip[first+qs[k]]; }
+	     ElementId eia(VOL, el);
+	     const FiniteElement & fela = space_a->GetFE(eia, lh);
+	     auto & mira = ma_a->GetTrafo(eia, lh)(ira, lh);
+	     size_t ndofa = fela.GetNDof();
+	     FlatMatrix<double,ColMajor> phi(dimflux*qs.Size(), ndofa, lh), bws(dimflux*qs.Size(), ndofb, lh);
+	     eval_a->CalcMatrix(fela, mira, phi, lh);
+	     for (auto k : Range(qs))
+	       bws.Rows(k*dimflux, (k+1)*dimflux) = bwmat.Rows(qs[k]*dimflux, (qs[k]+1)*dimflux);
+
+	     FlatMatrix<> rhs(ndofb, ndofa, lh), elmat(ndofb, ndofa, lh);
+	     rhs = Trans(bws) * phi;
+	     elmat = minv * rhs;
+	     /** from the global coefficients of space_a to the global ones of space_b,
+		 the transformations are diagonal (orientation signs, dof factors) **/
+	     if (space_a->NeedsTransformVec())
+	       for (size_t r = 0; r < ndofb; r++)
+		 { space_a->TransformVec(eia, elmat.Row(r), TRANSFORM_SOL); }
+	     if (space_b->NeedsTransformVec())
+	       for (size_t c = 0; c < ndofa; c++)
+		 { space_b->TransformVec(ElementId(VOL, i), elmat.Col(c), TRANSFORM_SOL_INVERSE); }
+	     space_a->GetDofNrs(eia, dnums_a);
+	     spmat->AddElementMatrix(fei.GetDofs(), dnums_a, elmat, false);
+	   }
+
+	   for (auto d : fei.GetDofs())
+	     if (IsRegularDof(d))
+	       { cnt_b[d]++; }
+	 });
+    }
+
+    ParallelFor
+      (spmat->Height(), [&](size_t dofnr)
+       {
+	 if (cnt_b[dofnr] > 1) {
+	   double fac = 1.0 / double(cnt_b[dofnr]);
+	   for (auto & v : spmat->GetRowValues(dofnr))
+	     { v *= fac; }
+	 }
+       });
+
+    return spmat;
+  } // TransferOperator
+
 } // namespace ngcomp
@@ -9,6 +9,14 @@ namespace ngcomp
 					  const Region * reg = NULL, shared_ptr<BitArray> range_dofs = nullptr, bool localop = false, bool parmat = true,
 					  bool use_simd = true, int bonus_intorder_ab = 0, int bonus_intorder_bb = 0);
 
+  /**
+     The interpolation gfb.Set(gfa) as a sparse matrix, where spacea and
+     spaceb may be defined on different meshes. The integration points of
+     spaceb are located in the mesh of spacea once, and the local
+     L2-projections and the averaging are stored in the matrix.
+  */
+  shared_ptr<BaseMatrix> TransferOperator (shared_ptr<FESpace> spacea, shared_ptr<FESpace> spaceb, LocalHeap & lh);
+
 } // namespace ngcomp
 
 #endif
@@ -825,6 +825,493 @@ namespace ngcomp
 
 
 
+  /*
+    Checkpoint files, written and read collectively by MPI-IO.
+
+    layout:   header | keys of all dofs | values of all dofs
+
+    Dofs are ordered by the global numbering of ParallelDofs::EnumerateGlobally,
+    every rank writes one contiguous block of its master dofs. The key 
+    identifies a dof independently of the partitioning by its node 
+    (node type, global vertex numbers) and its position within the node.
+    For loading, the file is read in equal slices, and values are found 
+    via a distributed directory (keys hashed to ranks), so the checkpoint 
+    can be loaded on a different number of ranks.
+  */
+  namespace checkpoint
+  {
+    // node type, up to 8 global vertex numbers, index within node
+    typedef Vec<10,int> DofKey;
+
+    struct Header
+    {
+      char magic[8];
+      int64_t nglob;
+      int64_t entrysize;   // scalars per dof
+      int64_t scalsize;
+      int64_t ntasks;      // ranks which wrote the file
+    };
+
+    static const char magic[8] = { 'N', 'G', 'S', 'C', 'K', 'P', 'T', '1' };
+
+    inline bool KeyLess (const DofKey & a, const DofKey & b)
+    {
+      for (int i = 0; i < 10; i++)
+        {
+          if (a[i] < b[i]) return true;
+          if (a[i] > b[i]) return false;
+        }
+      return false;
+    }
+
+    inline int KeyOwner (const DofKey & key, int ntasks)
+    {
+      size_t hash = 0;
+      for (int i = 0; i < 10; i++)
+        hash = 1000003 * hash + size_t(key[i]);
+      return hash % ntasks;
+    }
+
+    /*
+      keys for all local dofs. Dofs without a node (e.g. global dofs)
+      are identified by their global number, they can be restored
+      on the same partitioning only.
+    */
+    void ComputeDofKeys (const MeshAccess & ma, const FESpace & fes,
+                         FlatArray<int> globnums, FlatArray<DofKey> keys)
+    {
+      for (size_t i = 0; i < keys.Size(); i++)
+        {
+          keys[i] = -1;
+          keys[i][0] = -2;
+          keys[i][9] = globnums[i];
+        }
+
+      bool parallel = ma.GetCommunicator().Size() > 1;
+      Array<DofId> dnums;
+      Array<int> pnums;
+      for (NODE_TYPE nt : { NT_VERTEX, NT_EDGE, NT_FACE, NT_CELL })
+        for (size_t i = 0; i < ma.GetNNodes(nt); i++)
+          {
+            fes.GetDofNrs (NodeId(nt, i), dnums);
+            if (dnums.Size() == 0) continue;
+
+            switch (nt)
+              {
+              case NT_VERTEX: pnums.SetSize(1); pnums[0] = i; break;
+              case NT_EDGE: pnums = ma.GetEdgePNums (i); break;
+              case NT_FACE: pnums = ma.GetFacePNums (i); break;
+              case NT_CELL: pnums = ma.GetElVertices (ElementId(VOL,i)); break;
+              default:
+                __assume(false);
+              }
+
+            DofKey key = -1;
+            key[0] = int(nt);
+            for (int j = 0; j < pnums.Size(); j++)
+              key[j+1] = parallel ? ma.GetGlobalNodeNum (NodeId(NT_VERTEX, pnums[j])) : pnums[j];
+            for (int k = 0; k < dnums.Size(); k++)
+              if (IsRegularDof(dnums[k]))
+                {
+                  key[9] = k;
+                  keys[dnums[k]] = key;
+                }
+          }
+    }
+
+    // personalized all-to-all exchange, table rows are the ranks
+    template <typename T>
+    Table<T> ExchangeData (NgMPI_Comm comm, const Table<T> & send)
+    {
+      int ntasks = comm.Size();
+      Array<int> sendcnt(ntasks), recvcnt(ntasks);
+      for (int p = 0; p < ntasks; p++)
+        sendcnt[p] = send[p].Size() * sizeof(T);
+#ifdef PARALLEL
+      if (ntasks > 1)
+        MPI_Alltoall (&sendcnt[0], 1, MPI_INT, &recvcnt[0], 1, MPI_INT, comm);
+      else
+#endif
+        recvcnt = sendcnt;
+
+      Array<size_t> recvsize(ntasks);
+      Array<int> sdispl(ntasks), rdispl(ntasks);
+      size_t sd = 0, rd = 0;
+      for (int p = 0; p < ntasks; p++)
+        {
+          recvsize[p] = recvcnt[p] / sizeof(T);
+          sdispl[p] = sd;  sd += sendcnt[p];
+          rdispl[p] = rd;  rd += recvcnt[p];
+        }
+      Table<T> recv(recvsize);
+
+#ifdef PARALLEL
+      if (ntasks > 1)
+        {
+          MPI_Alltoallv ((void*)send.AsArray().Data(), &sendcnt[0], &sdispl[0], MPI_BYTE,
+                         recv.AsArray().Data(), &recvcnt[0], &rdispl[0], MPI_BYTE, comm);
+          return recv;
+        }
+#endif
+      for (size_t i = 0; i < recv[0].Size(); i++)
+        recv[0][i] = send[0][i];
+      return recv;
+    }
+
+    /*
+      A single task writes through a plain stream, so sequential runs
+      do not need an initialized MPI.
+    */
+    class File
+    {
+#ifdef PARALLEL
+      MPI_File fh;
+      bool parallel;
+#endif
+      fstream fs;
+    public:
+      File (const string & filename, bool write, NgMPI_Comm comm)
+      {
+#ifdef PARALLEL
+        parallel = comm.Size() > 1;
+        if (parallel)
+          {
+            int mode = write ? (MPI_MODE_CREATE | MPI_MODE_WRONLY) : MPI_MODE_RDONLY;
+            if (MPI_File_open (comm, filename.c_str(), mode, MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+              throw Exception ("cannot open checkpoint file '" + filename + "'");
+            if (write)
+              MPI_File_set_size (fh, 0);
+            return;
+          }
+#endif
+        fs.open (filename, write ? (ios::out | ios::binary | ios::trunc) : (ios::in | ios::binary));
+        if (!fs)
+          throw Exception ("cannot open checkpoint file '" + filename + "'");
+      }
+
+      ~File ()
+      {
+#ifdef PARALLEL
+        if (parallel)
+          MPI_File_close (&fh);
+#endif
+      }
+
+      // collective
+      void WriteAll (size_t offset, const void * data, size_t bytes)
+      {
+#ifdef PARALLEL
+        if (parallel)
+          {
+            if (bytes > size_t(numeric_limits<int>::max()))
+              throw Exception ("checkpoint: block per rank exceeds 2GB");
+            MPI_File_write_at_all (fh, offset, (void*)data, bytes, MPI_BYTE, MPI_STATUS_IGNORE);
+            return;
+          }
+#endif
+        fs.seekp (offset);
+        fs.write ((const char*)data, bytes);
+      }
+
+      // collective
+      void ReadAll (size_t offset, void * data, size_t bytes)
+      {
+#ifdef PARALLEL
+        if (parallel)
+          {
+            if (bytes > size_t(numeric_limits<int>::max()))
+              throw Exception ("checkpoint: block per rank exceeds 2GB");
+            MPI_File_read_at_all (fh, offset, data, bytes, MPI_BYTE, MPI_STATUS_IGNORE);
+            return;
+          }
+#endif
+        fs.seekg (offset);
+        fs.read ((char*)data, bytes);
+        if (!fs)
+          throw Exception ("checkpoint: file too short");
+      }
+
+      // by the calling rank only
+      void Write (size_t offset, const void * data, size_t bytes)
+      {
+#ifdef PARALLEL
+        if (parallel)
+          {
+            MPI_File_write_at (fh, offset, (void*)data, bytes, MPI_BYTE, MPI_STATUS_IGNORE);
+            return;
+          }
+#endif
+        WriteAll (offset, data, bytes);
+      }
+    };
+  }
+
+
+  template <class SCAL>
+  CheckpointStatistics S_GridFunction<SCAL> :: SaveCheckpoint (const string & filename) const
+  {
+    using namespace checkpoint;
+    static Timer t("GridFunction::SaveCheckpoint");
+    RegionTimer reg(t);
+
+    auto comm = ma->GetCommunicator();
+    const FESpace & fes = *GetFESpace();
+    shared_ptr<ParallelDofs> par = fes.GetParallelDofs();
+    const BaseVector & vec = GetVector();
+    vec.Cumulate();
+
+    size_t ndof = vec.Size();
+    size_t es = fes.GetDimension();
+    FlatVector<SCAL> fv = vec.FV<SCAL>();
+
+    Array<int> globnums(ndof);
+    int nglob;
+    if (par)
+      par->EnumerateGlobally (nullptr, globnums, nglob);
+    else
+      {
+        for (size_t i = 0; i < ndof; i++) globnums[i] = i;
+        nglob = ndof;
+      }
+    Array<DofKey> keys(ndof);
+    ComputeDofKeys (*ma, fes, globnums, keys);
+
+    // master dofs are numbered consecutively from first on
+    size_t first = nglob, nmaster = 0;
+    for (size_t i = 0; i < ndof; i++)
+      if (!par || par->IsMasterDof(i))
+        {
+          first = min(first, size_t(globnums[i]));
+          nmaster++;
+        }
+    if (nmaster == 0) first = 0;
+
+    Array<DofKey> mykeys(nmaster);
+    Array<SCAL> myvalues(nmaster*es);
+    for (size_t i = 0; i < ndof; i++)
+      if (!par || par->IsMasterDof(i))
+        {
+          size_t pos = globnums[i]-first;
+          mykeys[pos] = keys[i];
+          for (size_t k = 0; k < es; k++)
+            myvalues[pos*es+k] = fv(i*es+k);
+        }
+
+    comm.Barrier();
+    double starttime = WallTime();
+
+    File file(filename, true, comm);
+    if (comm.Rank() == 0)
+      {
+        Header header;
+        for (int i = 0; i < 8; i++) header.magic[i] = magic[i];
+        header.nglob = nglob;
+        header.entrysize = es;
+        header.scalsize = sizeof(SCAL);
+        header.ntasks = comm.Size();
+        file.Write (0, &header, sizeof(header));
+      }
+    size_t keyoffset = sizeof(Header);
+    size_t valoffset = keyoffset + nglob*sizeof(DofKey);
+    file.WriteAll (keyoffset + first*sizeof(DofKey), mykeys.Data(), nmaster*sizeof(DofKey));
+    file.WriteAll (valoffset + first*es*sizeof(SCAL), myvalues.Data(), nmaster*es*sizeof(SCAL));
+
+    comm.Barrier();
+    CheckpointStatistics stat;
+    stat.bytes = valoffset + nglob*es*sizeof(SCAL);
+    stat.seconds = WallTime()-starttime;
+    if (comm.Rank() == 0)
+      cout << IM(3) << "saved checkpoint '" << filename << "': " << stat.bytes/1e6 << " MB in "
+           << stat.seconds << " sec, " << stat.Bandwidth()/1e6 << " MB/s" << endl;
+    return stat;
+  }
+
+
+  template <class SCAL>
+  CheckpointStatistics S_GridFunction<SCAL> :: LoadCheckpoint (const string & filename)
+  {
+    using namespace checkpoint;
+    static Timer t("GridFunction::LoadCheckpoint");
+    RegionTimer reg(t);
+
+    auto comm = ma->GetCommunicator();
+    int ntasks = comm.Size();
+    int id = comm.Rank();
+    const FESpace & fes = *GetFESpace();
+    shared_ptr<ParallelDofs> par = fes.GetParallelDofs();
+    BaseVector & vec = GetVector();
+
+    size_t ndof = vec.Size();
+    size_t es = fes.GetDimension();
+    FlatVector<SCAL> fv = vec.FV<SCAL>();
+
+    comm.Barrier();
+    double starttime = WallTime();
+
+    // read the file in equal slices
+    File file(filename, false, comm);
+    Header header;
+    file.ReadAll (0, &header, sizeof(header));
+    for (int i = 0; i < 8; i++)
+      if (header.magic[i] != magic[i])
+        throw Exception ("'" + filename + "' is not a checkpoint file");
+    if (header.scalsize != sizeof(SCAL) || header.entrysize != es)
+      throw Exception ("checkpoint '" + filename + "' does not fit to the space");
+
+    size_t nglob = header.nglob;
+    size_t lo = nglob * id / ntasks, hi = nglob * (id+1) / ntasks;
+    Array<DofKey> filekeys(hi-lo);
+    Array<SCAL> filevalues((hi-lo)*es);
+    size_t keyoffset = sizeof(Header);
+    size_t valoffset = keyoffset + nglob*sizeof(DofKey);
+    file.ReadAll (keyoffset + lo*sizeof(DofKey), filekeys.Data(), (hi-lo)*sizeof(DofKey));
+    file.ReadAll (valoffset + lo*es*sizeof(SCAL), filevalues.Data(), (hi-lo)*es*sizeof(SCAL));
+
+    // distributed directory: file entries go to the owners of their keys
+    Array<size_t> cnt(ntasks);
+    cnt = 0;
+    for (auto & key : filekeys)
+      cnt[KeyOwner(key, ntasks)]++;
+    Table<DofKey> sendkeys(cnt);
+    for (auto & c : cnt) c *= es;
+    Table<SCAL> sendvalues(cnt);
+    cnt = 0;
+    for (size_t i = 0; i < filekeys.Size(); i++)
+      {
+        int p = KeyOwner(filekeys[i], ntasks);
+        for (size_t k = 0; k < es; k++)
+          sendvalues[p][cnt[p]*es+k] = filevalues[i*es+k];
+        sendkeys[p][cnt[p]++] = filekeys[i];
+      }
+    Table<DofKey> dirtable = ExchangeData (comm, sendkeys);
+    Table<SCAL> dirvaltable = ExchangeData (comm, sendvalues);
+    FlatArray<DofKey> dirkeys = dirtable.AsArray();
+    FlatArray<SCAL> dirvalues = dirvaltable.AsArray();
+    Array<int> index(dirkeys.Size());
+    for (int i = 0; i < index.Size(); i++) index[i] = i;
+    QuickSortI (dirkeys, index, KeyLess);
+
+    // request values of all local dofs from the directory
+    Array<int> globnums(ndof);
+    int nglob_local;
+    if (par)
+      par->EnumerateGlobally (nullptr, globnums, nglob_local);
+    else
+      for (size_t i = 0; i < ndof; i++) globnums[i] = i;
+    Array<DofKey> keys(ndof);
+    ComputeDofKeys (*ma, fes, globnums, keys);
+
+    cnt = 0;
+    for (auto & key : keys)
+      cnt[KeyOwner(key, ntasks)]++;
+    Table<DofKey> reqkeys(cnt);
+    Table<int> reqdofs(cnt);
+    cnt = 0;
+    for (size_t i = 0; i < ndof; i++)
+      {
+        int p = KeyOwner(keys[i], ntasks);
+        reqkeys[p][cnt[p]] = keys[i];
+        reqdofs[p][cnt[p]++] = i;
+      }
+    Table<DofKey> requests = ExchangeData (comm, reqkeys);
+
+    for (int p = 0; p < ntasks; p++)
+      cnt[p] = requests[p].Size()*es;
+    Table<SCAL> answers(cnt);
+    for (int p = 0; p < ntasks; p++)
+      for (size_t j = 0; j < requests[p].Size(); j++)
+        {
+          const DofKey & key = requests[p][j];
+          size_t l = 0, r = index.Size();
+          while (l < r)
+            {
+              size_t m = (l+r)/2;
+              if (KeyLess (dirkeys[index[m]], key)) l = m+1; else r = m;
+            }
+          bool found = l < index.Size() && !KeyLess (key, dirkeys[index[l]]);
+          if (!found && key[0] >= 0)
+            throw Exception ("checkpoint '" + filename + "' does not contain all dofs");
+          for (size_t k = 0; k < es; k++)
+            answers[p][j*es+k] = found ? dirvalues[index[l]*es+k] : SCAL(0.0);
+        }
+    Table<SCAL> values = ExchangeData (comm, answers);
+
+    for (int p = 0; p < ntasks; p++)
+      for (size_t j = 0; j < reqdofs[p].Size(); j++)
+        for (size_t k = 0; k < es; k++)
+          fv(reqdofs[p][j]*es+k) = values[p][j*es+k];
+    if (par)
+      vec.SetParallelStatus (CUMULATED);
+
+    comm.Barrier();
+    CheckpointStatistics stat;
+    stat.bytes = valoffset + nglob*es*sizeof(SCAL);
+    stat.seconds = WallTime()-starttime;
+    if (id == 0)
+      cout << IM(3) << "loaded checkpoint '" << filename << "' written by " << header.ntasks
+           << " ranks: " << stat.bytes/1e6 << " MB in " << stat.seconds << " sec, "
+           << stat.Bandwidth()/1e6 << " MB/s" << endl;
+    return stat;
+  }
+
+
+
+
+#ifdef PARALLEL
+  template <NODE_TYPE NT, typename SCAL>
+  static size_t WriteNodalValuesNT (const GridFunction & gf, const string & filename, bool with_keys)
+  {
+    auto ma = gf.GetMeshAccess();
+    const FESpace & fes = *gf.GetFESpace();
+    const BaseVector & vec = gf.GetVector();
+    vec.Cumulate();
+    FlatVector<SCAL> fv = vec.FV<SCAL>();
+
+    Array<SCAL> values(ma->GetNNodes(NT));
+    values = SCAL(0.0);
+    Array<DofId> dnums;
+    for (size_t i = 0; i < values.Size(); i++)
+      {
+        fes.GetDofNrs (NodeId(NT, i), dnums);
+        if (dnums.Size() && IsRegularDof(dnums[0]))
+          values[i] = fv(dnums[0]);
+      }
+    return WriteNodalData<NT> (*ma, FlatArray<SCAL>(values), filename, with_keys);
+  }
+
+  template <typename SCAL>
+  static size_t WriteNodalValuesSCAL (const GridFunction & gf, NODE_TYPE nt,
+                                      const string & filename, bool with_keys)
+  {
+    switch (nt)
+      {
+      case NT_VERTEX: return WriteNodalValuesNT<NT_VERTEX,SCAL> (gf, filename, with_keys);
+      case NT_EDGE: return WriteNodalValuesNT<NT_EDGE,SCAL> (gf, filename, with_keys);
+      case NT_FACE: return WriteNodalValuesNT<NT_FACE,SCAL> (gf, filename, with_keys);
+      case NT_CELL: return WriteNodalValuesNT<NT_CELL,SCAL> (gf, filename, with_keys);
+      default:
+        throw Exception ("WriteNodalValues: unsupported node type");
+      }
+  }
+#endif
+  
+  size_t WriteNodalValues (const GridFunction & gf, NODE_TYPE nt,
+                           const string & filename, bool with_keys)
+  {
+#ifdef PARALLEL
+    if (gf.GetFESpace()->GetDimension() != 1)
+      throw Exception ("WriteNodalValues: only scalar spaces are supported");
+    if (gf.GetFESpace()->IsComplex())
+      return WriteNodalValuesSCAL<Complex> (gf, nt, filename, with_keys);
+    return WriteNodalValuesSCAL<double> (gf, nt, filename, with_keys);
+#else
+    throw Exception ("WriteNodalValues needs an MPI build");
+#endif
+  }
+  
+
+
+
   ComponentGridFunction ::
   ComponentGridFunction (shared_ptr<GridFunction> agf_parent, int acomp)
     : GridFunction (dynamic_cast<const CompoundFESpace&> (*agf_parent->GetFESpace())[acomp],
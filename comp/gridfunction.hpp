@@ -104,6 +104,15 @@ namespace ngcomp
 
  
 
+  /// size and time of a checkpoint written or read by MPI-IO
+  struct CheckpointStatistics
+  {
+    size_t bytes = 0;
+    double seconds = 0;
+    double Bandwidth () const { return (seconds > 0) ? bytes / seconds : 0; }
+  };
+
+
   /** 
       Grid-functions
   */
@@ -272,6 +281,11 @@ namespace ngcomp
 
     virtual void Load (istream & ist) = 0;
     virtual void Save (ostream & ost) const = 0;
+
+    /// collective checkpoint into one file, by MPI-IO
+    virtual CheckpointStatistics SaveCheckpoint (const string & filename) const = 0;
+    /// load a checkpoint, also if written by a different number of ranks
+    virtual CheckpointStatistics LoadCheckpoint (const string & filename) = 0;
     using NGS_Object::shared_from_this;
   };
 
@@ -284,6 +298,14 @@ namespace ngcomp
 
   
   extern NGS_DLL_HEADER void Visualize(shared_ptr<GridFunction> gf, const string & name);
+
+  /**
+     Writes the value of the first dof of every node of type nt, sorted by 
+     global node key, into one binary file (see WriteNodalData in dump.hpp).
+     Returns the number of nodes written.
+  */
+  extern NGS_DLL_HEADER size_t WriteNodalValues (const GridFunction & gf, NODE_TYPE nt,
+                                                 const string & filename, bool with_keys = true);
   
   template <class SCAL>
   class NGS_DLL_HEADER S_GridFunction : public GridFunction
@@ -305,6 +327,9 @@ namespace ngcomp
     virtual void Load (istream & ist);
     virtual void Save (ostream & ost) const;
 
+    virtual CheckpointStatistics SaveCheckpoint (const string & filename) const;
+    virtual CheckpointStatistics LoadCheckpoint (const string & filename);
+
     virtual void Update ();
 
   private:
@@ -366,6 +391,10 @@ namespace ngcomp
     void Update () override;
     void Load(istream& ist) override { throw Exception("Load not implemented for ComponentGF"); }
     void Save(ostream& ost) const override { throw Exception("Save not implemented for ComponentGF"); }
+    CheckpointStatistics SaveCheckpoint (const string & filename) const override
+    { throw Exception("SaveCheckpoint not implemented for ComponentGF"); }
+    CheckpointStatistics LoadCheckpoint (const string & filename) override
+    { throw Exception("LoadCheckpoint not implemented for ComponentGF"); }
     shared_ptr<GridFunction> GetParent() const { return gf_parent; }
     int GetComponent() const { return comp; }
   };
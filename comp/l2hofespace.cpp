@@ -62,6 +62,7 @@ namespace ngcomp
     DefineDefineFlag("l2ho");
     DefineDefineFlag("all_dofs_together");
     DefineDefineFlag("hide_all_dofs");
+    DefineDefineFlag("tp");
 
     if (parseflags) CheckFlags(flags);
 
@@ -213,6 +214,13 @@ global system.
 
     docu.Arg("hide_all_dofs") = "bool = False\n"
       "  Set all used dofs to HIDDEN_DOFs";
+
+    docu.Arg("tp") = "bool = False\n"
+      "  Use tensor-product elements on quads and hexes, and elements\n"
+      "  in collapsed (Duffy) coordinates on tets. Values and gradients\n"
+      "  are evaluated by sum-factorization, which makes matrix-free\n"
+      "  operator application (nonassemble) much cheaper for high\n"
+      "  polynomial order. Other element types are not affected.";
     return docu;
   }
 
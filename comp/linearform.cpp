@@ -804,6 +804,143 @@ namespace ngcomp
   }
 
 
+  shared_ptr<MultiVector> AssembleMultiLinearForm (shared_ptr<FESpace> fes,
+                                                   FlatArray<shared_ptr<CoefficientFunction>> coefs,
+                                                   VorB vb, const Region * reg,
+                                                   shared_ptr<DifferentialOperator> evaluator,
+                                                   int bonus_intorder, LocalHeap & clh)
+  {
+    static Timer t("AssembleMultiLinearForm"); RegionTimer r(t);
+    static Timer tsimd("AssembleMultiLinearForm - simd");
+    
+    if (fes->IsComplex())
+      throw Exception ("AssembleMultiLinearForm: complex spaces are not supported");
+    if (!evaluator)
+      evaluator = fes->GetEvaluator(vb);
+    if (!evaluator)
+      throw Exception (fes->GetClassName()+string(" does not have an evaluator for ")+ToString(vb)+string("!"));
+
+    size_t k = coefs.Size();
+    int dim = evaluator->Dim();
+    for (auto coef : coefs)
+      {
+        if (coef->IsComplex())
+          throw Exception ("AssembleMultiLinearForm: complex coefficients are not supported");
+        if (coef->Dimension() != dim)
+          throw Exception (string("AssembleMultiLinearForm: test-function dim = ") + ToString(dim) +
+                           ", but coefficient-dim = " + ToString(coef->Dimension()));
+      }
+
+    auto ma = fes->GetMeshAccess();
+    size_t ndof = fes->GetNDof();
+    int es = fes->GetDimension();
+    shared_ptr<BaseVector> refvec;
+#ifdef PARALLEL
+    if (fes->GetParallelDofs())
+      refvec = make_shared<S_ParallelBaseVectorPtr<double>> (ndof, es, fes->GetParallelDofs(), DISTRIBUTED);
+    else
+#endif
+      refvec = make_shared<S_BaseVectorPtr<double>> (ndof, es);
+    auto vecs = make_shared<MultiVector> (refvec, k);
+    for (size_t j = 0; j < k; j++)
+      {
+        *(*vecs)[j] = 0.0;
+        (*vecs)[j]->SetParallelStatus (DISTRIBUTED);
+      }
+
+    Array<Array<CoefficientFunction*>> cachecfs(k);
+    for (size_t j = 0; j < k; j++)
+      cachecfs[j] = FindCacheCF (*coefs[j]);
+
+    bool use_simd = true;
+    ProgressOutput progress (ma, string("assemble ") + ToString(vb) + string(" element"), ma->GetNE(vb));
+    IterateElements
+      (*fes, vb, clh, [&] (FESpace::Element el, LocalHeap & lh)
+       {
+         progress.Update();
+         if (reg && !reg->Mask().Test(el.GetIndex())) return;
+         
+         auto & fel = el.GetFE();
+         auto & trafo = el.GetTrafo();
+         size_t eldofs = fel.GetNDof() * es;
+         int intorder = 2*fel.Order()+bonus_intorder;
+
+         ProxyUserData ud;
+         const_cast<ElementTransformation&>(trafo).userdata = &ud;
+
+         // the element vectors of all right hand sides are the rows of elvecs
+         FlatMatrix<> elvecs(k, eldofs, lh);
+         
+         if (use_simd)
+           try
+             {
+               ThreadRegionTimer rsimd(tsimd, TaskManager::GetThreadId());
+               auto & ir = GetSIMDIntegrationRule(fel.ElementType(), intorder);
+               auto & mir = trafo(ir, lh);
+               size_t nip = ir.Size();
+               size_t nipd = nip * SIMD<double>::Size();
+
+               // test functions once: rows dof*dim+c, viewed as eldofs x (dim*nipd)
+               FlatMatrix<SIMD<double>> bmat(eldofs*dim, nip, lh);
+               evaluator->CalcMatrix (fel, mir, bmat);
+
+               // weighted coefficients: row j, column c*nipd+q
+               FlatMatrix<SIMD<double>> cvals(k*dim, nip, lh);
+               for (size_t j = 0; j < k; j++)
+                 {
+                   PrecomputeCacheCF (cachecfs[j], mir, lh);
+                   coefs[j]->Evaluate (mir, cvals.Rows(j*dim, (j+1)*dim));
+                 }
+               for (size_t j = 0; j < k*dim; j++)
+                 for (size_t q = 0; q < nip; q++)
+                   cvals(j,q) *= mir[q].GetWeight();
+
+               SliceMatrix<> b(eldofs, dim*nipd, dim*nipd, &bmat(0,0)[0]);
+               SliceMatrix<> c(k, dim*nipd, dim*nipd, &cvals(0,0)[0]);
+               elvecs = c * Trans(b);
+             }
+           catch (ExceptionNOSIMD e)
+             {
+               use_simd = false;
+               cout << IM(4) << "Warning: switching to std evalution in AssembleMultiLinearForm since: " << e.What() << endl;
+             }
+         
+         if (!use_simd)
+           {
+             auto & ir = GetIntegrationRule(fel.ElementType(), intorder);
+             auto & mir = trafo(ir, lh);
+             size_t nip = ir.Size();
+
+             // rows q*dim+c
+             FlatMatrix<double,ColMajor> bmat(dim*nip, eldofs, lh);
+             evaluator->CalcMatrix (fel, mir, bmat, lh);
+
+             FlatMatrix<> cvals(k, dim*nip, lh);
+             FlatMatrix<> vals(nip, dim, lh);
+             for (size_t j = 0; j < k; j++)
+               {
+                 PrecomputeCacheCF (cachecfs[j], mir, lh);
+                 coefs[j]->Evaluate (mir, vals);
+                 for (size_t q = 0; q < nip; q++)
+                   vals.Row(q) *= mir[q].GetWeight();
+                 cvals.Row(j) = vals.AsVector();
+               }
+             elvecs = cvals * bmat;
+           }
+
+         for (size_t j = 0; j < k; j++)
+           {
+             FlatVector<> elvec = elvecs.Row(j);
+             fes->TransformVec (el, elvec, TRANSFORM_RHS);
+             (*vecs)[j]->AddIndirect (el.GetDofs(), elvec);
+           }
+       });
+    progress.Done();
+    
+    return vecs;
+  }
+
+
 
   template class S_LinearForm<double>;
   template class S_LinearForm<Complex>;
@@ -232,6 +232,19 @@ namespace ngcomp
                                                                  const string & name,
                                                                  const Flags & flags);
 
+  /**
+     Assembles the right hand sides  \int coefs[j] * test(v)  for all j in
+     one pass over the elements. The test functions are evaluated once per
+     element, the element vectors of all coefficients are one matrix product.
+     test is the evaluator of the space if evaluator is nullptr.
+  */
+  extern NGS_DLL_HEADER
+  shared_ptr<MultiVector> AssembleMultiLinearForm (shared_ptr<FESpace> fes,
+                                                   FlatArray<shared_ptr<CoefficientFunction>> coefs,
+                                                   VorB vb, const Region * reg,
+                                                   shared_ptr<DifferentialOperator> evaluator,
+                                                   int bonus_intorder, LocalHeap & clh);
+
 }
 
 #endif
@@ -207,6 +207,24 @@ namespace ngcomp
       // static Timer t("eltrans::multipointjacobian"); RegionTimer reg(t);
       SIMD_MappedIntegrationRule<DIMS,DIMR> & mir = 
 	static_cast<SIMD_MappedIntegrationRule<DIMS,DIMR> &> (bmir);
+
+      // per point: mapped point, followed by the Jacobian
+      constexpr size_t entrysize = DIMR*(DIMS+1);
+      SIMD_GeometryCache * cache = mesh->GetGeometryCache();
+      if (cache)
+        if (SIMD<double> * cached = cache->Get (GetElementId(), ir))
+          {
+            for (size_t i = 0; i < ir.Size(); i++, cached += entrysize)
+              {
+                for (int j = 0; j < DIMR; j++)
+                  mir[i].Point()(j) = cached[j];
+                for (int j = 0; j < DIMR; j++)
+                  for (int k = 0; k < DIMS; k++)
+                    mir[i].Jacobian()(j,k) = cached[DIMR+j*DIMS+k];
+                mir[i].Compute();
+              }
+            return;
+          }
       
       mesh->mesh.MultiElementTransformation <DIMS,DIMR>
         (elnr, ir.Size(),
@@ -216,6 +234,20 @@ namespace ngcomp
       
       for (int i = 0; i < ir.Size(); i++)
         mir[i].Compute();
+
+      if (cache && ir.IsPersistent() && !cache->Full())
+        {
+          STACK_ARRAY(SIMD<double>, mem, ir.Size()*entrysize);
+          for (size_t i = 0, ii = 0; i < ir.Size(); i++)
+            {
+              for (int j = 0; j < DIMR; j++)
+                mem[ii++] = mir[i].Point()(j);
+              for (int j = 0; j < DIMR; j++)
+                for (int k = 0; k < DIMS; k++)
+                  mem[ii++] = mir[i].Jacobian()(j,k);
+            }
+          cache->Set (GetElementId(), ir, FlatArray<SIMD<double>> (ir.Size()*entrysize, &mem[0]));
+        }
     }
 
     virtual const ElementTransformation & VAddDeformation (const GridFunction * gf, LocalHeap & lh) const override
@@ -920,6 +952,7 @@ namespace ngcomp
     mesh_timestamp = netgen_mesh_timestamp;
     
     timestamp = NGS_Object::GetNextTimeStamp();
+    InvalidateGeometryCache();
     
 
     dim = mesh.GetDimension();
@@ -1446,6 +1479,104 @@ namespace ngcomp
     */
   }
 
+  void SIMD_GeometryCache :: Clear ()
+  {
+    for (int i = 0; i < nrules; i++)
+      {
+        auto & rule = rules[i];
+        for (size_t j = 0; j < rule.nel; j++)
+          delete [] rule.data[j].load();
+        rule.data.reset();
+        rule.ir = nullptr;
+        rule.nel = 0;
+      }
+    nrules = 0;
+    used_memory = 0;
+  }
+
+  SIMD_GeometryCache :: ~SIMD_GeometryCache ()
+  {
+    Clear();
+  }
+
+  bool SIMD_GeometryCache :: Set (ElementId ei, const SIMD_IntegrationRule & ir,
+                                  FlatArray<SIMD<double>> values)
+  {
+    if (!ir.IsPersistent()) return false;
+
+    size_t bytes = values.Size()*sizeof(SIMD<double>);
+    if (used_memory.fetch_add(bytes) + bytes > max_memory)
+      {
+        used_memory -= bytes;
+        return false;
+      }
+
+    auto find = [&] (int n) -> RuleEntry*
+      {
+        for (int i = 0; i < n; i++)
+          if (rules[i].ir == &ir && rules[i].vb == ei.VB())
+            return &rules[i];
+        return nullptr;
+      };
+    
+    RuleEntry * entry = find(nrules.load(memory_order_acquire));
+    if (!entry)
+      {
+        lock_guard<mutex> guard(add_mutex);
+        int n = nrules.load(memory_order_acquire);
+        entry = find(n);
+        if (!entry)
+          {
+            if (n == max_rules)
+              {
+                used_memory -= bytes;
+                return false;
+              }
+            entry = &rules[n];
+            entry->ir = &ir;
+            entry->vb = ei.VB();
+            entry->nel = ma.GetNE(ei.VB());
+            entry->data = make_unique<atomic<SIMD<double>*>[]> (entry->nel);
+            for (size_t j = 0; j < entry->nel; j++)
+              entry->data[j] = nullptr;
+            used_memory += entry->nel * sizeof(SIMD<double>*);
+            nrules.store(n+1, memory_order_release);
+          }
+      }
+    if (ei.Nr() >= entry->nel)
+      {
+        used_memory -= bytes;
+        return false;
+      }
+
+    SIMD<double> * mem = new SIMD<double>[values.Size()];
+    for (size_t i = 0; i < values.Size(); i++)
+      mem[i] = values[i];
+    
+    SIMD<double> * expected = nullptr;
+    if (!entry->data[ei.Nr()].compare_exchange_strong(expected, mem, memory_order_release))
+      {
+        // other thread was faster
+        delete [] mem;
+        used_memory -= bytes;
+      }
+    return true;
+  }
+
+  void MeshAccess :: SetGeometryCache (size_t max_memory)
+  {
+    if (max_memory)
+      geometry_cache = make_unique<SIMD_GeometryCache> (*this, max_memory);
+    else
+      geometry_cache.reset();
+  }
+  
+  void MeshAccess :: InvalidateGeometryCache ()
+  {
+    if (geometry_cache)
+      geometry_cache->Clear();
+  }
+
     void MeshAccess :: SetDeformation (shared_ptr<GridFunction> def)
     {
       if (def)
@@ -1858,6 +1989,160 @@ namespace ngcomp
   }
 
 
+  // local facet of a simplex which does not contain vertex v
+  static int OppositeFacet (ELEMENT_TYPE et, int v)
+  {
+    for (int k = 0; k < ElementTopology::GetNFacets(et); k++)
+      {
+        bool contains = false;
+        switch (et)
+          {
+          case ET_SEGM:
+            contains = (k == v); break;
+          case ET_TRIG:
+            for (int j : Range(2))
+              if (ElementTopology::GetEdges(et)[k][j] == v) contains = true;
+            break;
+          case ET_TET:
+            for (int j : Range(3))
+              if (ElementTopology::GetFaces(et)[k][j] == v) contains = true;
+            break;
+          default:
+            break;
+          }
+        if (!contains) return k;
+      }
+    return -1;
+  }
+
+  /*
+    Local coordinates of point in element ei by Newton's method, exact
+    after one step for affine elements. Returns the vertex of the smallest
+    barycentric coordinate if the point is outside the simplex, -1 if
+    inside, -2 if the element is not a simplex or Newton fails.
+  */
+  static int PointInSimplex (const MeshAccess & ma, ElementId ei, FlatVector<double> point,
+                             IntegrationPoint & ip, LocalHeap & lh)
+  {
+    HeapReset hr(lh);
+    int dim = ma.GetDimension();
+    ELEMENT_TYPE et = ma.GetElType(ei);
+    if (et != ET_SEGM && et != ET_TRIG && et != ET_TET)
+      return -2;
+    
+    auto & trafo = ma.GetTrafo (ei, lh);
+    ip = IntegrationPoint(0,0,0);
+    for (int j = 0; j < dim; j++)
+      ip(j) = 1.0 / (dim+1);
+
+    FlatVector<> x(dim, lh), dxi(dim, lh);
+    FlatMatrix<> jac(dim, dim, lh), inv(dim, dim, lh);
+    bool converged = false;
+    for (int it = 0; it < 10 && !converged; it++)
+      {
+        trafo.CalcPointJacobian (ip, x, jac);
+        CalcInverse (jac, inv);
+        dxi = inv * (point - x);
+        double norm = 0;
+        for (int j = 0; j < dim; j++)
+          {
+            ip(j) += dxi(j);
+            norm += fabs(dxi(j));
+          }
+        converged = norm < 1e-12;
+      }
+    if (!converged) return -2;
+
+    double lamlast = 1;
+    int vmin = dim;
+    double lammin = 1;
+    for (int j = 0; j < dim; j++)
+      {
+        lamlast -= ip(j);
+        if (ip(j) < lammin)
+          {
+            lammin = ip(j);
+            vmin = j;
+          }
+      }
+    if (lamlast < lammin)
+      {
+        lammin = lamlast;
+        vmin = dim;
+      }
+    return (lammin >= -1e-10) ? -1 : vmin;
+  }
+  
+  void MeshAccess :: FindElementsOfPoints (SliceMatrix<double> points,
+                                           FlatArray<int> elnrs,
+                                           FlatArray<IntegrationPoint> ips) const
+  {
+    static Timer t("FindElementsOfPoints"); RegionTimer reg(t);
+    size_t npoints = points.Height();
+    if (npoints == 0) return;
+    if (points.Width() < size_t(dim))
+      throw Exception ("FindElementsOfPoints: need "+ToString(dim)+" coordinates per point");
+
+    auto search = [&] (size_t i)
+      {
+        Vec<3> p = 0.0;
+        for (int j = 0; j < dim; j++)
+          p(j) = points(i,j);
+        ips[i] = IntegrationPoint(0,0,0);
+        return FindElementOfPoint (p, ips[i], true);
+      };
+
+    // build the search tree before the parallel loop
+    if (elnrs[0] < 0)
+      elnrs[0] = search(0);
+    else
+      {
+        IntegrationPoint ip;
+        Vec<3> p = 0.0;
+        FindElementOfPoint (p, ip, true);
+      }
+    
+    constexpr int max_walk = 50;
+    ParallelForRange (npoints, [&] (IntRange r)
+      {
+        LocalHeapMem<10000> lh("FindElementsOfPoints");
+        ArrayMem<int,2> facetels;
+        Vec<3> p;
+        int prev = -1;
+        for (size_t i : r)
+          {
+            for (int j = 0; j < dim; j++)
+              p(j) = points(i,j);
+            
+            int el = (elnrs[i] >= 0 && size_t(elnrs[i]) < GetNE(VOL)) ? elnrs[i] : prev;
+            int found = -1;
+            for (int step = 0; step < max_walk && el >= 0; step++)
+              {
+                ElementId ei(VOL, el);
+                int v = PointInSimplex (*this, ei, FlatVector<>(dim, &p(0)), ips[i], lh);
+                if (v == -1)
+                  {
+                    found = el;
+                    break;
+                  }
+                if (v == -2) break;
+
+                int f = GetElFacets(ei)[OppositeFacet(GetElType(ei), v)];
+                GetFacetElements (f, facetels);
+                int next = -1;
+                for (int e : facetels)
+                  if (e != el) next = e;
+                el = next;
+              }
+
+            if (found < 0)
+              found = search(i);
+            elnrs[i] = found;
+            if (found >= 0) prev = found;
+          }
+      });
+  }
+
   int MeshAccess :: FindSurfaceElementOfPoint (FlatVector<double> point,
 					       IntegrationPoint & ip, 
 					       bool build_searchtree,
@@ -1959,6 +2244,7 @@ namespace ngcomp
   void MeshAccess :: Curve (int order)
   {
     mesh.Curve(order);
+    InvalidateGeometryCache();
   } 
   
   int MeshAccess :: GetCurveOrder ()
@@ -177,6 +177,59 @@ namespace ngcomp
   };
   */
 
+  /**
+     Cache for mapped points and Jacobians of curved elements.
+
+     Data is stored per element and SIMD integration rule, only for the
+     persistent rules of the global rule tables. Determinants and
+     normals are recomputed from the cached Jacobians, which is cheap
+     compared to the geometry evaluation in Netgen. The cache stops
+     growing when the memory budget is used up, and it is cleared when
+     the mesh changes.
+   */
+  class MeshAccess;
+  class NGS_DLL_HEADER SIMD_GeometryCache
+  {
+    static constexpr int max_rules = 32;
+    struct RuleEntry
+    {
+      const SIMD_IntegrationRule * ir = nullptr;
+      VorB vb = VOL;
+      size_t nel = 0;
+      unique_ptr<atomic<SIMD<double>*>[]> data;
+    };
+    const MeshAccess & ma;
+    RuleEntry rules[max_rules];
+    atomic<int> nrules{0};
+    mutex add_mutex;
+    size_t max_memory;
+    atomic<size_t> used_memory{0};
+  public:
+    SIMD_GeometryCache (const MeshAccess & ama, size_t amax_memory)
+      : ma(ama), max_memory(amax_memory) { ; }
+    ~SIMD_GeometryCache ();
+
+    /// cached data of the element, nullptr if not available
+    SIMD<double> * Get (ElementId ei, const SIMD_IntegrationRule & ir) const
+    {
+      for (int i = 0; i < nrules.load(memory_order_acquire); i++)
+        if (rules[i].ir == &ir && rules[i].vb == ei.VB() && ei.Nr() < rules[i].nel)
+          return rules[i].data[ei.Nr()].load(memory_order_acquire);
+      return nullptr;
+    }
+    
+    /// store data of the element, returns false if not cached
+    bool Set (ElementId ei, const SIMD_IntegrationRule & ir, FlatArray<SIMD<double>> values);
+    
+    /// drop all cached data, not thread-safe
+    void Clear ();
+    
+    bool Full () const { return used_memory >= max_memory; }
+    size_t UsedMemory () const { return used_memory; }
+    size_t MaxMemory () const { return max_memory; }
+  };
+
+  
   /** 
       Access to mesh topology and geometry.
 
@@ -232,6 +285,9 @@ namespace ngcomp
     /// for ALE
     shared_ptr<GridFunction> deformation;  
 
+    /// optional cache for SIMD geometry of curved elements
+    unique_ptr<SIMD_GeometryCache> geometry_cache;
+
     /// pml trafos per sub-domain
     Array<shared_ptr <PML_Transformation>> pml_trafos;
     
@@ -676,6 +732,13 @@ namespace ngcomp
       return deformation;
     }
 
+    /// enables caching of mapped points and Jacobians of curved elements,
+    /// max_memory in bytes. max_memory = 0 disables the cache
+    void SetGeometryCache (size_t max_memory);
+    /// drop cached geometry, needed after moving mesh points in Netgen
+    void InvalidateGeometryCache ();
+    SIMD_GeometryCache * GetGeometryCache () const { return geometry_cache.get(); }
+
     void SetPML (const shared_ptr<PML_Transformation> & pml_trafo, int _domnr);
     void UnSetPML (int _domnr);
 
@@ -1052,6 +1115,17 @@ namespace ngcomp
 			    IntegrationPoint & ip, 
 			    bool build_searchtree,
 			    int index) const;
+    /**
+       Locates the rows of points in volume elements, in parallel.
+       elnrs[i] >= 0 on input is the first guess for point i, otherwise
+       the element of the previous point is tried. Starting from the guess,
+       simplicial meshes are walked through facet neighbours, the search
+       tree is the fallback. On output elnrs[i] = -1 if the point is not
+       in the mesh.
+    */
+    void FindElementsOfPoints (SliceMatrix<double> points,
+                               FlatArray<int> elnrs,
+                               FlatArray<IntegrationPoint> ips) const;
     int FindSurfaceElementOfPoint (FlatVector<double> point,
 				   IntegrationPoint & ip, 
 				   bool build_searchtree,
@@ -380,6 +380,378 @@ namespace ngcomp
 
 
 
+  InterpolationOperator ::
+  InterpolationOperator (shared_ptr<FESpace> afes, VorB avb,
+                         const Region * reg,
+                         DifferentialOperator * adiffop,
+                         LocalHeap & clh,
+                         bool store_all, bool use_simd)
+    : fes(afes), vb(avb), diffop(adiffop)
+  {
+    static Timer t("InterpolationOperator - setup"); RegionTimer r(t);
+    shared_ptr<MeshAccess> ma = fes->GetMeshAccess();
+
+    if (!diffop)
+      diffop = fes->GetEvaluator(vb).get();
+    if (!diffop)
+      throw Exception(fes->GetClassName()+string(" does not have an evaluator for ")+ToString(vb)+string("!"));
+    
+    single_bli = fes->GetIntegrator(vb);
+    if (dynamic_pointer_cast<BlockBilinearFormIntegrator> (single_bli))
+      single_bli = dynamic_pointer_cast<BlockBilinearFormIntegrator> (single_bli)->BlockPtr();
+    if (!single_bli)
+      {
+        cout << IM(5) << "make a symbolic integrator for interpolation" << endl;
+        auto single_evaluator =  fes->GetEvaluator(vb);
+        if (dynamic_pointer_cast<BlockDifferentialOperator>(single_evaluator))
+          single_evaluator = dynamic_pointer_cast<BlockDifferentialOperator>(single_evaluator)->BaseDiffOp();
+        
+        auto trial = make_shared<ProxyFunction>(fes, false, false, single_evaluator,
+                                                nullptr, nullptr, nullptr, nullptr, nullptr);
+        auto test  = make_shared<ProxyFunction>(fes, true, false, single_evaluator,
+                                                nullptr, nullptr, nullptr, nullptr, nullptr);
+        single_bli = make_shared<SymbolicBilinearFormIntegrator> (InnerProduct(trial,test), vb, VOL);
+      }
+
+    bool bli_uses_simd = single_bli->SimdEvaluate();
+    if (!use_simd)
+      single_bli->SetSimdEvaluate(false);
+
+    /*
+      On affine elements the mass matrix of a scalar space evaluated by
+      the identity is the measure times a reference matrix. It depends on
+      the element type, the orders of all element nodes, and for high
+      order spaces on the ordering of the vertex numbers. Vector valued
+      elements are Piola-mapped, their mass matrices are not shared.
+    */
+    bool shareable = diffop->Name() == "Id";
+    if (shareable && ma->GetNEdges())
+      try
+        {
+          fes->GetOrder (NodeId(NT_EDGE, 0));
+        }
+      catch (Exception &)
+        {
+          shareable = false;
+        }
+    auto is_scalar = [] (const FiniteElement & fel)
+      {
+        if (dynamic_cast<const BaseScalarFiniteElement*> (&fel)) return true;
+        auto cfel = dynamic_cast<const CompoundFiniteElement*> (&fel);
+        if (!cfel || cfel->GetNComponents() == 0) return false;
+        for (int j = 0; j < cfel->GetNComponents(); j++)
+          if (!dynamic_cast<const BaseScalarFiniteElement*> (&(*cfel)[j])) return false;
+        return true;
+      };
+    
+    size_t ne = ma->GetNE(vb);
+    elclass.SetSize(ne);
+    elclass = -1;
+    elscale.SetSize(ne);
+    Array<double> measure(ne);
+    Array<std::vector<int>> keys(ne);   // empty key: mass matrix not shared
+    
+    ParallelForRange (ne, [&] (IntRange myrange)
+      {
+        LocalHeap lh = clh.Split();
+        for (size_t i : myrange)
+          {
+            HeapReset hr(lh);
+            ElementId ei(vb, i);
+            if (!fes->DefinedOn(ei)) continue;
+            int index = ma->GetElIndex(ei);
+            if (reg)
+              {
+                if (!reg->Mask().Test(index)) continue;
+              }
+            else
+              {
+                if (vb==BND && !fes->IsDirichletBoundary(index)) continue;
+              }
+            
+            const FiniteElement & fel = fes->GetFE (ei, lh);
+            const ElementTransformation & eltrans = ma->GetTrafo (ei, lh);
+            IntegrationRule ir(fel.ElementType(), 0);
+            measure[i] = eltrans(ir[0], lh).GetMeasure();
+            elclass[i] = -2;
+            
+            if (!shareable || eltrans.IsCurvedElement() || !is_scalar(fel))
+              continue;
+
+            auto ngel = ma->GetElement(ei);
+            auto vnums = ngel.Vertices();
+            auto & key = keys[i];
+            key.push_back (fel.ElementType());
+            key.push_back (fel.Order());
+            key.push_back (fel.GetNDof());
+            for (int k : Range(vnums))
+              {
+                int rank = 0;
+                for (auto v : vnums)
+                  if (v < vnums[k]) rank++;
+                key.push_back (rank);
+              }
+            for (auto e : ngel.Edges())
+              key.push_back (fes->GetOrder (NodeId(NT_EDGE, e)));
+            if (ma->GetDimension() == 3)
+              for (auto f : ngel.Faces())
+                key.push_back (fes->GetOrder (NodeId(NT_FACE, f)));
+            if (vb == VOL)
+              key.push_back (fes->GetOrder (NodeId(NT_ELEMENT, i)));
+          }
+      });
+
+    // one representative element per class of equal mass matrices
+    Array<int> rep, second;
+    std::map<std::vector<int>, int> classes;
+    for (size_t i = 0; i < ne; i++)
+      {
+        if (elclass[i] == -1) continue;
+        if (keys[i].empty())
+          {
+            if (store_all)
+              {
+                elclass[i] = rep.Size();
+                rep.Append(i);
+                second.Append(-1);
+              }
+            continue;
+          }
+        auto [pos, isnew] = classes.emplace (keys[i], rep.Size());
+        if (isnew)
+          {
+            rep.Append(i);
+            second.Append(-1);
+          }
+        else if (second[pos->second] == -1)
+          second[pos->second] = i;
+        elclass[i] = pos->second;
+      }
+
+    /*
+      Invert the mass matrices of the representatives. The scaling is
+      checked by a second element of the class, classes failing the
+      check are not shared.
+    */
+    Array<bool> shared;
+    auto invert_classes = [&] (IntRange classnrs)
+      {
+        invmats.SetSize(rep.Size());
+        shared.SetSize(rep.Size());
+        ParallelForRange (classnrs, [&] (IntRange myrange)
+          {
+            LocalHeap lh = clh.Split();
+            for (size_t c : myrange)
+              {
+                HeapReset hr(lh);
+                ElementId ei(vb, rep[c]);
+                const FiniteElement & fel = fes->GetFE (ei, lh);
+                size_t ndof = fel.GetNDof();
+                invmats[c].SetSize(ndof, ndof);
+                single_bli->CalcElementMatrix (fel, ma->GetTrafo (ei, lh), invmats[c], lh);
+                
+                shared[c] = true;
+                if (second[c] != -1)
+                  {
+                    ElementId ei2(vb, second[c]);
+                    FlatMatrix<double> elmat2(ndof, ndof, lh);
+                    single_bli->CalcElementMatrix (fes->GetFE(ei2, lh), ma->GetTrafo (ei2, lh), elmat2, lh);
+                    double scale = measure[second[c]] / measure[rep[c]];
+                    double err = 0, norm = 0;
+                    for (size_t j = 0; j < ndof; j++)
+                      for (size_t k = 0; k < ndof; k++)
+                        {
+                          err += sqr(elmat2(j,k) - scale * invmats[c](j,k));
+                          norm += sqr(elmat2(j,k));
+                        }
+                    shared[c] = err <= 1e-20 * norm;
+                  }
+                CalcInverse (invmats[c]);
+              }
+          });
+      };
+    invert_classes (IntRange(rep.Size()));
+
+    size_t nshared = rep.Size();
+    for (size_t i = 0; i < ne; i++)
+      {
+        int c = elclass[i];
+        if (c < 0 || size_t(c) >= nshared || shared[c] || size_t(rep[c]) == i) continue;
+        if (store_all)
+          {
+            elclass[i] = rep.Size();
+            rep.Append(i);
+            second.Append(-1);
+          }
+        else
+          elclass[i] = -2;
+      }
+    invert_classes (IntRange(nshared, rep.Size()));
+
+    for (size_t i = 0; i < ne; i++)
+      if (elclass[i] >= 0)
+        elscale[i] = measure[rep[elclass[i]]] / measure[i];
+
+    single_bli->SetSimdEvaluate(bli_uses_simd);
+
+    cnti.SetSize(fes->GetNDof());
+    cnti = 0;
+    Array<DofId> dnums;
+    for (size_t i = 0; i < ne; i++)
+      if (elclass[i] != -1)
+        {
+          fes->GetDofNrs (ElementId(vb, i), dnums);
+          for (auto d : dnums)
+            if (IsRegularDof(d)) cnti[d]++;
+        }
+#ifdef PARALLEL
+    AllReduceDofData (cnti, MPI_SUM, fes->GetParallelDofs());
+#endif
+
+    cout << IM(5) << "InterpolationOperator: " << invmats.Size() << " inverse mass matrices for "
+         << ne << " elements" << endl;
+  }
+
+
+  void InterpolationOperator :: Set (shared_ptr<CoefficientFunction> coef, GridFunction & u,
+                                     LocalHeap & clh, bool use_simd) const
+  {
+    if (fes->IsComplex())
+      T_Set<Complex> (coef, u, clh, use_simd);
+    else
+      T_Set<double> (coef, u, clh, use_simd);
+  }
+
+  
+  template <class SCAL>
+  void InterpolationOperator :: T_Set (shared_ptr<CoefficientFunction> coef, GridFunction & u,
+                                       LocalHeap & clh, bool use_simd) const
+  {
+    static Timer t("InterpolationOperator - set"); RegionTimer r(t);
+    shared_ptr<MeshAccess> ma = fes->GetMeshAccess();
+
+    if (u.GetFESpace() != fes)
+      throw Exception("InterpolationOperator: GridFunction is not defined on the space of the operator");
+    if (cnti.Size() != fes->GetNDof() || elclass.Size() != ma->GetNE(vb))
+      throw Exception("InterpolationOperator: space has changed since setup, create a new operator");
+    
+    int dim = fes->GetDimension();
+    int dimflux = diffop->Dim();
+    if (coef -> Dimension() != dimflux)
+      throw Exception(string("Error in SetValues: gridfunction-dim = ") + ToString(dimflux) +
+                      ", but coefficient-dim = " + ToString(coef->Dimension()));
+
+    u.GetVector() = 0.0;
+    
+    ProgressOutput progress (ma, "setvalues element", ma->GetNE(vb));
+    
+    auto cachecfs = FindCacheCF (*coef);
+    IterateElements 
+      (*fes, vb, clh, 
+       [&] (FESpace::Element ei, LocalHeap & lh)
+       {
+         progress.Update ();
+         int c = elclass[ei.Nr()];
+         if (c == -1) return;
+         
+         const FiniteElement & fel = fes->GetFE (ei, lh);
+         const ElementTransformation & eltrans = ma->GetTrafo (ei, lh); 
+         size_t ndof = fel.GetNDof();
+         
+         FlatVector<SCAL> elflux(ndof * dim, lh);
+         FlatVector<SCAL> elfluxi(ndof * dim, lh);
+         elflux = SCAL(0.0);
+
+         bool done = false;
+         if (use_simd)
+           {
+             try
+               {
+                 SIMD_IntegrationRule ir(fel.ElementType(), 2*fel.Order());
+                 FlatMatrix<SIMD<SCAL>> mfluxi(dimflux, ir.Size(), lh);
+                 auto & mir = eltrans(ir, lh);
+                 
+                 ProxyUserData ud;
+                 const_cast<ElementTransformation&>(eltrans).userdata = &ud;
+                 PrecomputeCacheCF (cachecfs, mir, lh);
+                 
+                 coef->Evaluate (mir, mfluxi);
+                 for (size_t j : Range(ir))
+                   mfluxi.Col(j) *= mir[j].GetWeight();
+                 diffop -> AddTrans (fel, mir, mfluxi, elflux);
+                 done = true;
+               }
+             catch (ExceptionNOSIMD e)
+               {
+                 use_simd = false;
+                 elflux = SCAL(0.0);
+                 cout << IM(4) << "Warning: switching to std evalution in SetValues since: " << e.What() << endl;
+               }
+           }
+         
+         if (!done)
+           {
+             IntegrationRule ir(fel.ElementType(), 2*fel.Order());
+             FlatMatrix<SCAL> mfluxi(ir.GetNIP(), dimflux, lh);
+             BaseMappedIntegrationRule & mir = eltrans(ir, lh);
+             
+             ProxyUserData ud;
+             const_cast<ElementTransformation&>(eltrans).userdata = &ud;
+             PrecomputeCacheCF (cachecfs, mir, lh);
+             
+             coef->Evaluate (mir, mfluxi);
+             for (int j : Range(ir))
+               mfluxi.Row(j) *= mir[j].GetWeight();
+             diffop -> ApplyTrans (fel, mir, mfluxi, elflux, lh);
+           }
+
+         if (c >= 0)
+           {
+             // the dim components are interleaved, i.e. the columns of a ndof x dim matrix
+             FlatMatrix<SCAL> mflux(ndof, dim, elflux.Data());
+             FlatMatrix<SCAL> mfluxi(ndof, dim, elfluxi.Data());
+             mfluxi = invmats[c] * mflux;
+             mfluxi *= elscale[ei.Nr()];
+           }
+         else
+           {
+             FlatMatrix<double> elmat(ndof, lh);
+             single_bli->CalcElementMatrix (fel, eltrans, elmat, lh);
+             FlatCholeskyFactors<double> invelmat(elmat, lh);
+             for (int j = 0; j < dim; j++)
+               invelmat.Mult (elflux.Slice (j,dim), elfluxi.Slice (j,dim));
+           }
+         
+         fes->TransformVec (ei, elfluxi, TRANSFORM_SOL_INVERSE);
+         
+         u.GetElementVector (ei.GetDofs(), elflux);
+         elfluxi += elflux;
+         u.SetElementVector (ei.GetDofs(), elfluxi);
+       });
+    progress.Done();
+
+#ifdef PARALLEL
+    u.GetVector().SetParallelStatus(DISTRIBUTED);
+    u.GetVector().Cumulate(); 	 
+#endif
+
+    ParallelForRange
+      (cnti.Size(), [&] (IntRange r)
+       {
+         VectorMem<10,SCAL> fluxi(dim);
+         ArrayMem<int,1> dnums(1);
+         for (auto i : r)
+           if (cnti[i] > 1)
+             {
+               dnums[0] = i;
+               u.GetElementVector (dnums, fluxi);
+               fluxi /= double (cnti[i]);
+               u.SetElementVector (dnums, fluxi);
+             }
+       });
+  }
+
+
   template <class SCAL>
   void SetValues (shared_ptr<CoefficientFunction> coef,
 		  GridFunction & u,
@@ -396,6 +768,14 @@ namespace ngcomp
     int dim   = fes->GetDimension();
     ma->PushStatus("setvalues");
 
+    if (!dualdiffop)
+      {
+        InterpolationOperator interpol(fes, vb, reg, diffop, clh, false, use_simd);
+        interpol.Set (coef, u, clh, use_simd);
+        ma->PopStatus ();
+        return;
+      }
+    
     Array<int> cnti(fes->GetNDof());
     cnti = 0;
 
@@ -638,222 +1018,6 @@ namespace ngcomp
            }); // IterateElements
         progress.Done();
       }
-    else
-      {
-        if (!diffop)
-          diffop = fes->GetEvaluator(vb).get();
-        shared_ptr<BilinearFormIntegrator> bli = fes->GetIntegrator(vb);
-        shared_ptr<BilinearFormIntegrator> single_bli = bli;
-        if (dynamic_pointer_cast<BlockBilinearFormIntegrator> (single_bli))
-          single_bli = dynamic_pointer_cast<BlockBilinearFormIntegrator> (single_bli)->BlockPtr();
-    
-        if (!bli)
-          {
-            cout << IM(5) << "make a symbolic integrator for interpolation" << endl;
-            if (!fes->GetEvaluator(vb))
-              throw Exception(fes->GetClassName()+string(" does not have an evaluator for ")+ToString(vb)+string("!"));
-            auto single_evaluator =  fes->GetEvaluator(vb);
-            if (dynamic_pointer_cast<BlockDifferentialOperator>(single_evaluator))
-              single_evaluator = dynamic_pointer_cast<BlockDifferentialOperator>(single_evaluator)->BaseDiffOp();
-        
-            auto trial = make_shared<ProxyFunction>(fes, false, false, single_evaluator,
-                                                    nullptr, nullptr, nullptr, nullptr, nullptr);
-            auto test  = make_shared<ProxyFunction>(fes, true, false, single_evaluator,
-                                                    nullptr, nullptr, nullptr, nullptr, nullptr);
-            bli = make_shared<SymbolicBilinearFormIntegrator> (InnerProduct(trial,test), vb, VOL);
-          
-            single_bli = bli;
-            // throw Exception ("no integrator available");
-          }
-            
-	/** So we can restore this afterwards **/
-	bool bli_uses_simd = bli->SimdEvaluate(), sbli_uses_simd = single_bli->SimdEvaluate();
-	if ( !use_simd ) { // if simd was already turned off, no point in turning it back on
-	  bli->SetSimdEvaluate(use_simd);
-	  single_bli->SetSimdEvaluate(use_simd);
-	}
-
-	int dimflux = diffop ? diffop->Dim() : bli->DimFlux(); 
-        if (coef -> Dimension() != dimflux)
-          throw Exception(string("Error in SetValues: gridfunction-dim = ") + ToString(dimflux) +
-                          ", but coefficient-dim = " + ToString(coef->Dimension()));
-        
-        u.GetVector() = 0.0;
-        
-        ProgressOutput progress (ma, "setvalues element", ma->GetNE(vb));
-        
-        auto cachecfs = FindCacheCF (*coef);
-        IterateElements 
-          (*fes, vb, clh, 
-           [&] (FESpace::Element ei, LocalHeap & lh)
-           {
-             progress.Update ();
-             
-             if (reg)
-               {
-                 if (!reg->Mask().Test(ei.GetIndex())) return;
-               }
-             else
-               {
-                 if (vb==BND && !fes->IsDirichletBoundary(ei.GetIndex()))
-                   return;
-               }
-             
-             const FiniteElement & fel = fes->GetFE (ei, lh);
-             const ElementTransformation & eltrans = ma->GetTrafo (ei, lh); 
-             
-             // Array<int> dnums(fel.GetNDof(), lh);
-             // fes.GetDofNrs (ei, dnums);
-             
-             FlatVector<SCAL> elflux(fel.GetNDof() * dim, lh);
-             FlatVector<SCAL> elfluxi(fel.GetNDof() * dim, lh);
-             FlatVector<SCAL> fluxi(dimflux, lh);
-             
-             if (use_simd)
-               {
-                 try
-                   {
-                     SIMD_IntegrationRule ir(fel.ElementType(), 2*fel.Order());
-                     FlatMatrix<SIMD<SCAL>> mfluxi(dimflux, ir.Size(), lh);
-                     
-                     auto & mir = eltrans(ir, lh);
-
-                     ProxyUserData ud;
-                     const_cast<ElementTransformation&>(eltrans).userdata = &ud;
-                     PrecomputeCacheCF (cachecfs, mir, lh);
-                     
-                     coef->Evaluate (mir, mfluxi);
-                     
-                     for (size_t j : Range(ir))
-                       mfluxi.Col(j) *= mir[j].GetWeight();
-                     
-                     elflux = SCAL(0.0);
-                     if (diffop)
-                       diffop -> AddTrans (fel, mir, mfluxi, elflux);
-                     else
-                       throw ExceptionNOSIMD("need diffop");
-                     
-                     if (dim > 1) //  && typeid(*bli)==typeid(BlockBilinearFormIntegrator))
-                       {
-                         FlatMatrix<SCAL> elmat(fel.GetNDof(), lh);
-                         single_bli->CalcElementMatrix (fel, eltrans, elmat, lh);                      
-                         FlatCholeskyFactors<SCAL> invelmat(elmat, lh);
-                         
-                         for (int j = 0; j < dim; j++)
-                           invelmat.Mult (elflux.Slice (j,dim), elfluxi.Slice (j,dim));
-                       }
-                     else
-                       {
-                         FlatMatrix<SCAL> elmat(fel.GetNDof(), lh);
-                         bli->CalcElementMatrix (fel, eltrans, elmat, lh);
-                         
-                         // Transform solution inverse instead
-                         // fes->TransformMat (ei, elmat, TRANSFORM_MAT_LEFT_RIGHT);
-                         // fes->TransformVec (ei, elflux, TRANSFORM_RHS);
-                         // if (fel.GetNDof() < 50)
-                         if (true)
-                           {
-                             // FlatCholeskyFactors<SCAL> invelmat(elmat, lh);
-                             // invelmat.Mult (elflux, elfluxi);
-                             
-                             CalcLDL<SCAL,ColMajor> (Trans(elmat));
-                             elfluxi = elflux;
-                             SolveLDL<SCAL,ColMajor> (Trans(elmat), elfluxi);
-                           }
-                         else
-                           {
-                             LapackInverseSPD (elmat);
-                             elfluxi = elmat * elflux;
-                           }
-                       }
-                     
-                     fes->TransformVec (ei, elfluxi, TRANSFORM_SOL_INVERSE);
-                     
-                     u.GetElementVector (ei.GetDofs(), elflux);
-                     elfluxi += elflux;
-                     u.SetElementVector (ei.GetDofs(), elfluxi);
-                     
-                     for (auto d : ei.GetDofs())
-                       if (IsRegularDof(d)) cnti[d]++;
-                     
-                     return;
-                   }
-                 catch (ExceptionNOSIMD e)
-                   {
-                     use_simd = false;
-                     cout << IM(4) << "Warning: switching to std evalution in SetValues since: " << e.What() << endl;
-                   }
-               }
-             
-             IntegrationRule ir(fel.ElementType(), 2*fel.Order());
-             FlatMatrix<SCAL> mfluxi(ir.GetNIP(), dimflux, lh);
-             
-             BaseMappedIntegrationRule & mir = eltrans(ir, lh);
-             ProxyUserData ud;
-             const_cast<ElementTransformation&>(eltrans).userdata = &ud;
-             PrecomputeCacheCF (cachecfs, mir, lh);
-             
-             coef->Evaluate (mir, mfluxi);
-             
-             for (int j : Range(ir))
-               mfluxi.Row(j) *= mir[j].GetWeight();
-             
-             if (diffop)
-               diffop -> ApplyTrans (fel, mir, mfluxi, elflux, lh);
-             else
-               bli->ApplyBTrans (fel, mir, mfluxi, elflux, lh);
-             
-             if (dim > 1)
-               {
-                 FlatMatrix<SCAL> elmat(fel.GetNDof(), lh);
-                 // const BlockBilinearFormIntegrator & bbli = 
-                 // dynamic_cast<const BlockBilinearFormIntegrator&> (*bli.get());
-                 // bbli . Block() . CalcElementMatrix (fel, eltrans, elmat, lh);
-                 single_bli->CalcElementMatrix (fel, eltrans, elmat, lh);
-                 FlatCholeskyFactors<SCAL> invelmat(elmat, lh);
-                 
-                 for (int j = 0; j < dim; j++)
-                   invelmat.Mult (elflux.Slice (j,dim), elfluxi.Slice (j,dim));
-               }
-             else
-               {
-                 FlatMatrix<SCAL> elmat(fel.GetNDof()*dim, lh);
-                 bli->CalcElementMatrix (fel, eltrans, elmat, lh);
-                 
-                 // Transform solution inverse instead
-                 // fes->TransformMat (ei, elmat, TRANSFORM_MAT_LEFT_RIGHT);
-                 // fes->TransformVec (ei, elflux, TRANSFORM_RHS);
-                 // if (fel.GetNDof() < 50)
-                 if (true)
-                   {
-                     CalcLDL<SCAL,ColMajor> (Trans(elmat));
-                     elfluxi = elflux;
-                     SolveLDL<SCAL,ColMajor> (Trans(elmat), elfluxi);
-                   }
-                 else
-                   {
-                     LapackInverse (elmat);
-                     elfluxi = elmat * elflux;
-                   }
-               }
-             
-             fes->TransformVec (ei, elfluxi, TRANSFORM_SOL_INVERSE);
-             
-             u.GetElementVector (ei.GetDofs(), elflux);
-             elfluxi += elflux;
-             u.SetElementVector (ei.GetDofs(), elfluxi);
-             
-             for (auto d : ei.GetDofs())
-               if (d != -1) cnti[d]++;
-             
-           });
-        progress.Done();
-
-	/** Restore simd evaluate in case we are using the integrators from fes **/
-	bli->SetSimdEvaluate(bli_uses_simd);
-	single_bli->SetSimdEvaluate(sbli_uses_simd);
-
-      }
 
 
 #ifdef PARALLEL
@@ -52,6 +52,50 @@ namespace ngcomp
                   bool dualdiffop = false, bool use_simd = true);
   
 
+  /**
+     Reusable local L2-projection of CoefficientFunctions, as done by
+     SetValues. The element mass matrices are inverted at setup, and
+     shared between affine elements of the same type, order and vertex
+     ordering. Set then only evaluates the coefficient and applies the
+     stored inverses, which pays off for repeated Set calls in time loops.
+
+     Elements which cannot share an inverse (curved elements, or spaces
+     with a Piola-type mapping) get their own stored inverse for
+     store_all = true, otherwise they are factorized in every Set call.
+  */
+  class NGS_DLL_HEADER InterpolationOperator
+  {
+    shared_ptr<FESpace> fes;
+    VorB vb;
+    DifferentialOperator * diffop;
+    shared_ptr<BilinearFormIntegrator> single_bli;
+    /// inverse matrix per element, -1 .. element not set, -2 .. factorized on the fly
+    Array<int> elclass;
+    /// measure of the class representative over measure of element
+    Array<double> elscale;
+    Array<Matrix<double>> invmats;
+    /// number of elements sharing a dof, for averaging
+    Array<int> cnti;
+  public:
+    InterpolationOperator (shared_ptr<FESpace> afes, VorB avb,
+                           const Region * reg,       // nullptr is whole mesh, BND only Dirichlet
+                           DifferentialOperator * adiffop,   // NULL is FESpace evaluator
+                           LocalHeap & clh,
+                           bool store_all = true, bool use_simd = true);
+
+    void Set (shared_ptr<CoefficientFunction> coef, GridFunction & u,
+              LocalHeap & clh, bool use_simd = true) const;
+
+    shared_ptr<FESpace> GetFESpace() const { return fes; }
+    /// number of stored inverse matrices
+    size_t GetNInverses() const { return invmats.Size(); }
+  private:
+    template <class SCAL>
+    void T_Set (shared_ptr<CoefficientFunction> coef, GridFunction & u,
+                LocalHeap & clh, bool use_simd) const;
+  };
+  
+
   template <class SCAL>
   extern NGS_DLL_HEADER
   int CalcPointFlux (const GridFunction & u,
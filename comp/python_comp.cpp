@@ -1666,6 +1666,71 @@ filename : string
 parallel : bool
   input parallel
 
+)raw_string"))
+    .def("SaveCheckpoint", [](GF & self, string filename)
+         {
+           auto stat = self.SaveCheckpoint(filename);
+           py::dict res;
+           res["bytes"] = stat.bytes;
+           res["seconds"] = stat.seconds;
+           res["bandwidth"] = stat.Bandwidth();
+           return res;
+         },
+         py::arg("filename"), docu_string(R"raw_string(
+Saves the gridfunction into one file, written collectively by MPI-IO.
+The checkpoint can be loaded on a different number of ranks.
+Returns a dict with bytes, seconds and bandwidth (bytes/sec).
+
+Parameters:
+
+filename : string
+  output file name
+
+)raw_string"))
+    .def("LoadCheckpoint", [](GF & self, string filename)
+         {
+           auto stat = self.LoadCheckpoint(filename);
+           py::dict res;
+           res["bytes"] = stat.bytes;
+           res["seconds"] = stat.seconds;
+           res["bandwidth"] = stat.Bandwidth();
+           return res;
+         },
+         py::arg("filename"), docu_string(R"raw_string(
+Loads a gridfunction from a checkpoint written by SaveCheckpoint,
+possibly on a different number of ranks.
+Returns a dict with bytes, seconds and bandwidth (bytes/sec).
+
+Parameters:
+
+filename : string
+  input file name
+
+)raw_string"))
+    .def("WriteNodalValues", [](GF & self, string filename, NODE_TYPE nt, bool keys)
+         {
+           return WriteNodalValues (self, nt, filename, keys);
+         },
+         py::arg("filename"), py::arg("nodetype")=NT_VERTEX, py::arg("keys")=true,
+         docu_string(R"raw_string(
+Writes the value of the first dof of every node, sorted by global node key,
+into one binary file. The data is sorted by a parallel sample sort and
+written collectively by MPI-IO. Returns the number of nodes written.
+
+File layout: 8 bytes 'NGSNODAL', int64 number of nodes, int32 key size,
+int32 value size, followed by (key, value) records, or values only.
+
+Parameters:
+
+filename : string
+  output file name
+
+nodetype : ngsolve.fem.NODE_TYPE
+  VERTEX, EDGE, FACE or CELL
+
+keys : bool
+  write the global node keys in front of the values
+
 )raw_string"))
     .def("Set", 
          [](shared_ptr<GF> self, spCF cf,
@@ -1934,6 +1999,47 @@ diffop : ngsolve.fem.DifferentialOperator
                     }))
     ;
 
+
+  py::class_<InterpolationOperator, shared_ptr<InterpolationOperator>>
+    (m, "InterpolationOperator", docu_string(R"raw_string(
+Reusable local L2-projection into a finite element space, as done by
+GridFunction.Set. The element mass matrices are inverted once, and shared
+between affine elements. Repeated Set calls, e.g. in time loops, only
+evaluate the coefficient and apply the stored inverses.
+
+Parameters:
+
+space : ngsolve.FESpace
+  the space to project into
+
+VOL_or_BND : ngsolve.comp.VorB
+  input VOL, BND, BBND, ...
+
+definedon : object
+  input definedon region
+
+)raw_string"))
+    .def(py::init([](shared_ptr<FESpace> fes, VorB vb, py::object definedon)
+                  {
+                    Region * reg = nullptr;
+                    if (py::extract<Region&> (definedon).check())
+                      reg = &py::extract<Region&>(definedon)();
+                    py::gil_scoped_release release;
+                    return make_shared<InterpolationOperator> (fes, reg ? reg->VB() : vb, reg, nullptr, glh);
+                  }),
+         py::arg("space"), py::arg("VOL_or_BND")=VOL, py::arg("definedon")=DummyArgument())
+    .def("Set", [](InterpolationOperator & self, spCF cf, shared_ptr<GF> gf, bool use_simd)
+         {
+           py::gil_scoped_release release;
+           self.Set (cf, *gf, glh, use_simd);
+         },
+         py::arg("coefficient"), py::arg("gf"), py::arg("use_simd")=true,
+         "Set the GridFunction gf to the local L2-projection of the coefficient")
+    .def_property_readonly("space", &InterpolationOperator::GetFESpace)
+    .def_property_readonly("ninverses", &InterpolationOperator::GetNInverses,
+                           "number of stored inverse element mass matrices")
+    ;
+
   ///////////////////////////// BilinearForm   ////////////////////////////////////////
 
   py::class_<DifferentialSymbol>(m, "DifferentialSymbol")
@@ -1944,6 +2050,7 @@ diffop : ngsolve.fem.DifferentialOperator
                         VorB element_vb, bool skeleton,
                         int bonus_intorder,
                         std::map<ELEMENT_TYPE,IntegrationRule> intrules,
+                        INTRULE_TYPE intrule_type,
                         shared_ptr<GridFunction> deformation,
                         shared_ptr<BitArray> definedonelements)
          {
@@ -1961,6 +2068,7 @@ diffop : ngsolve.fem.DifferentialOperator
            for (auto both : intrules)
              dx.userdefined_intrules[both.first] =
                make_shared<IntegrationRule> (both.second.Copy());
+           dx.intrule_type = intrule_type;
            return dx;
          },
          py::arg("definedon")=nullptr,
@@ -1969,6 +2077,7 @@ diffop : ngsolve.fem.DifferentialOperator
          py::arg("skeleton")=false,
          py::arg("bonus_intorder")=0,
          py::arg("intrules")=std::map<ELEMENT_TYPE,IntegrationRule>{},
+         py::arg("intrule_type")=IRT_DEFAULT,
          py::arg("deformation")=nullptr,
          py::arg("definedonelements")=nullptr)
     ;
@@ -2106,6 +2215,10 @@ space : ngsolve.FESpace
                      py::arg("geom_free") = "bool = False\n"
                      "  when element matrices are independent of geometry, we store them \n"
                      "  only for the referecne elements",
+                     py::arg("geom_free_affine") = "bool = False\n"
+                     "  for element-wise constant coefficients on affine simplicial meshes:\n"
+                     "  store operators on reference elements and small coefficient\n"
+                     "  matrices per element, apply by batched matrix products",
                      py::arg("check_unused") = "bool = True\n"
 		     "  If set prints warnings if not UNUSED_DOFS are not used."
                      );
@@ -2168,6 +2281,7 @@ integrator : ngsolve.fem.BFI
                bfi->SetBonusIntegrationOrder(dx.bonus_intorder);
                if(dx.definedonelements)
                  bfi->SetDefinedOnElements(dx.definedonelements);
+               bfi->SetIntegrationRuleType(dx.intrule_type);
                for (auto both : dx.userdefined_intrules)
                  bfi->SetIntegrationRule(both.first, *both.second);
                self += bfi;
@@ -2194,6 +2308,7 @@ integrator : ngsolve.fem.BFI
                  }
                bfi->SetDeformation(dx.deformation);               
                bfi->SetBonusIntegrationOrder(dx.bonus_intorder);
+               bfi->SetIntegrationRuleType(dx.intrule_type);
                self += bfi;
              }
            return self;
@@ -2479,6 +2594,7 @@ integrator : ngsolve.fem.LFI
                lfi->SetBonusIntegrationOrder(dx.bonus_intorder);
                if(dx.definedonelements)
                  lfi->SetDefinedOnElements(dx.definedonelements);
+               lfi->SetIntegrationRuleType(dx.intrule_type);
                for (auto both : dx.userdefined_intrules)
                  lfi->SetIntegrationRule(both.first, *both.second);
                *self += lfi;
@@ -3832,6 +3948,86 @@ use_simd:
 bonus_intorder_ab/bb: int
   Bonus integration order for spacea/spaceb and spaceb/spaceb integrals. Can be useful for curved elements. Should only be necessary for
 spacea/spaceb integrals.
+)raw_string")
+	 );
+
+   m.def("TransferOperator", [](shared_ptr<FESpace> spacea, shared_ptr<FESpace> spaceb) -> shared_ptr<BaseMatrix>
+         {
+           return TransferOperator(spacea, spaceb, glh);
+         },
+	 py::arg("spacea"), py::arg("spaceb"), py::call_guard<py::gil_scoped_release>(),
+     docu_string(R"raw_string(
+The interpolation gfb.Set(gfa) from spacea to spaceb as a sparse matrix, i.e. element-wise
+local L2-projection into spaceb and averaging. The spaces may be defined on different meshes,
+the integration points of spaceb are then located in the mesh of spacea once. Points outside
+of the mesh of spacea contribute zero.
+
+Parameters:
+
+spacea: ngsolve.comp.FESpace
+  the origin space
+
+spaceb: ngsolve.comp.FESpace
+  the goal space
+)raw_string")
+	 );
+
+   m.def("AssembleMultiLinearForm", [](shared_ptr<FESpace> space, std::vector<shared_ptr<CoefficientFunction>> coefs,
+                                       VorB vb, optional<Region> definedon, shared_ptr<ProxyFunction> test,
+                                       int bonus_intorder) -> shared_ptr<MultiVector>
+         {
+           const Region * reg = nullptr;
+           if (definedon.has_value())
+             {
+               reg = &(*definedon);
+               vb = VorB(*definedon);
+             }
+           shared_ptr<DifferentialOperator> eval;
+           if (test)
+             {
+               if (!test->IsTestFunction())
+                 throw Exception("Need a test-proxy, but got a trial-proxy!");
+               if (vb == VOL)
+                 eval = test->Evaluator();
+               else if (vb == BND)
+                 eval = test->TraceEvaluator();
+               else if (vb == BBND)
+                 eval = test->TTraceEvaluator();
+               if (!eval)
+                 throw Exception(string("test-proxy has no evaluator for vb = ") + to_string(vb) + string("!"));
+             }
+           Array<shared_ptr<CoefficientFunction>> acoefs(coefs.size());
+           for (size_t j = 0; j < coefs.size(); j++)
+             acoefs[j] = coefs[j];
+           py::gil_scoped_release release;
+           return AssembleMultiLinearForm(space, acoefs, vb, reg, eval, bonus_intorder, glh);
+         },
+	 py::arg("space"), py::arg("coefs"), py::arg("VOL_or_BND") = VOL, py::arg("definedon") = nullptr,
+	 py::arg("test") = nullptr, py::arg("bonus_intorder") = 0,
+     docu_string(R"raw_string(
+Assembles the right hand sides  Integrate(coefs[j] * test) * dx  for all j in one pass over the
+elements, and returns them as a MultiVector. The test functions are evaluated once per element,
+and the element vectors of all coefficients are computed by one matrix-matrix product.
+
+Parameters:
+
+space: ngsolve.comp.FESpace
+  the test space
+
+coefs: list of ngsolve.fem.CoefficientFunction
+  the coefficients, of the dimension of the test function
+
+VOL_or_BND : ngsolve.comp.VorB
+  input VOL, BND, BBND
+
+definedon: object
+  region to integrate over
+
+test: ngsolve.comp.ProxyFunction
+  (optional) a test-proxy like grad(v), default is v
+
+bonus_intorder: int
+  the integration order is 2*order+bonus_intorder
 )raw_string")
 	 );
 
@@ -459,6 +459,31 @@ mesh (netgen.Mesh): a mesh generated from Netgen
 
     .def("UnsetDeformation", [](MeshAccess & ma){ ma.SetDeformation(nullptr);}, "Unset the deformation")
 
+    .def("SetGeometryCache",
+         [](MeshAccess & ma, double maxmemory)
+         { ma.SetGeometryCache(size_t(maxmemory)); }, py::arg("maxmemory")=1e9,
+         docu_string(R"raw_string(
+Cache mapped integration points and Jacobians of curved elements.
+Speeds up repeated operator applications (e.g. nonassemble forms)
+on curved meshes.
+
+Parameters:
+
+maxmemory : float
+  memory budget in bytes, 0 disables the cache
+
+)raw_string"))
+
+    .def("InvalidateGeometryCache", &MeshAccess::InvalidateGeometryCache,
+         "Drop cached geometry, needed if the Netgen mesh is deformed")
+
+    .def_property_readonly("geometrycache_memory",
+                           [](MeshAccess & ma) -> size_t
+                           {
+                             auto cache = ma.GetGeometryCache();
+                             return cache ? cache->UsedMemory() : 0;
+                           }, "memory used by the geometry cache in bytes")
+
     .def("SetPML", 
 	 [](MeshAccess & ma,  shared_ptr<PML> apml, py::object definedon)
           {
@@ -699,6 +724,59 @@ mesh (netgen.Mesh): a mesh generated from Netgen
                                    points.Append({p(0), p(1), p(2), self, vb, int(el.Nr())});
                                return MoveToNumpyArray(points);
                              })
+    .def("LocatePoints", [](MeshAccess* self,
+                            py::array_t<double, py::array::c_style | py::array::forcecast> points,
+                            py::object hints) -> py::array_t<MeshPoint>
+         {
+           int dim = self->GetDimension();
+           if (points.ndim() != 2 || points.shape(1) != dim)
+             throw Exception("LocatePoints: expected an array of shape (npoints, "+ToString(dim)+") for a "
+                             +ToString(dim)+"D mesh");
+           size_t npoints = points.shape(0);
+           auto pts = points.unchecked<2>();
+           Matrix<> coords(npoints, dim);
+           for (size_t i = 0; i < npoints; i++)
+             for (size_t j = 0; j < size_t(dim); j++)
+               coords(i,j) = pts(i,j);
+
+           Array<int> elnrs(npoints);
+           elnrs = -1;
+           if (!hints.is_none())
+             {
+               auto h = py::cast<py::array_t<int, py::array::c_style | py::array::forcecast>>(hints);
+               if (size_t(h.size()) != npoints)
+                 throw Exception("LocatePoints: need one hint per point");
+               for (size_t i = 0; i < npoints; i++)
+                 elnrs[i] = h.data()[i];
+             }
+           
+           Array<IntegrationPoint> ips(npoints);
+           {
+             py::gil_scoped_release release;
+             self->FindElementsOfPoints(coords, elnrs, ips);
+           }
+           
+           Array<MeshPoint> res(npoints);
+           for (size_t i = 0; i < npoints; i++)
+             res[i] = { ips[i](0), ips[i](1), ips[i](2), self, VOL, elnrs[i] };
+           return MoveToNumpyArray(res);
+         }, py::arg("points"), py::arg("hints") = py::none(),
+         docu_string(R"raw_string(
+Locates many points at once in the volume elements, in parallel.
+
+Parameters:
+
+points : numpy array
+  coordinates of the points, of shape (npoints, dim) with the dimension
+  of the mesh
+
+hints : numpy array
+  element numbers to start the search from, e.g. the field 'nr' of a
+  previous result for slightly moved points. Negative entries are ignored.
+
+Returns a numpy array of MeshPoints, which can be used for evaluating
+CoefficientFunctions. Points outside the mesh get the element number -1.
+)raw_string"))
     ;
     PyDefVectorized(mesh_access, "__call__",
          [](MeshAccess* ma, double x, double y, double z, VorB vb)
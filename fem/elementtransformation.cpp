@@ -22,6 +22,85 @@ namespace ngfem
     throw ExceptionNOSIMD("ElementTransformation(SIMD_IR) not overloaded");
   }
 
+  namespace
+  {
+    // per-thread pool of mapped integration rules
+    class MappedRulePool
+    {
+    public:
+      struct Entry
+      {
+        const SIMD_IntegrationRule * ir = nullptr;
+        int dim_element = -1, dim_space = -1;
+        SIMD_BaseMappedIntegrationRule * mir = nullptr;
+        bool in_use = false;
+      };
+      static constexpr size_t maxentries = 16;
+      std::array<Entry,maxentries> entries;
+      size_t nentries = 0;
+      LocalHeap heap;
+      
+      MappedRulePool () : heap(4*1024*1024, "mapped-rule pool") { ; }
+
+      bool Clear ()
+      {
+        for (size_t i = 0; i < nentries; i++)
+          if (entries[i].in_use) return false;
+        nentries = 0;
+        heap.CleanUp();
+        return true;
+      }
+    };
+
+    MappedRulePool & GetMappedRulePool ()
+    {
+      thread_local MappedRulePool pool;
+      return pool;
+    }
+  }
+
+  ElementTransformation::PooledSIMD_MIR ElementTransformation ::
+  GetPooledMIR (const SIMD_IntegrationRule & ir, LocalHeap & lh) const
+  {
+    if (!ir.IsPersistent())
+      return PooledSIMD_MIR ((*this)(ir, lh), nullptr);
+
+    auto & pool = GetMappedRulePool();
+    int dimel = ElementDim(), dimsp = SpaceDim();
+    for (size_t i = 0; i < pool.nentries; i++)
+      {
+        auto & entry = pool.entries[i];
+        if (entry.ir == &ir && entry.dim_element == dimel && 
+            entry.dim_space == dimsp && !entry.in_use)
+          {
+            entry.mir->ReMap (*this);
+            entry.in_use = true;
+            return PooledSIMD_MIR (*entry.mir, &entry.in_use);
+          }
+      }
+
+    if (pool.nentries == MappedRulePool::maxentries && !pool.Clear())
+      return PooledSIMD_MIR ((*this)(ir, lh), nullptr);
+
+    void * heapstart = pool.heap.GetPointer();
+    try
+      {
+        auto & entry = pool.entries[pool.nentries];
+        entry.mir = &(*this)(ir, pool.heap);
+        entry.ir = &ir;
+        entry.dim_element = dimel;
+        entry.dim_space = dimsp;
+        entry.in_use = true;
+        pool.nentries++;
+        return PooledSIMD_MIR (*entry.mir, &entry.in_use);
+      }
+    catch (const LocalHeapOverflow &)
+      {
+        pool.heap.CleanUp (heapstart);
+        return PooledSIMD_MIR ((*this)(ir, lh), nullptr);
+      }
+  }
+
   void ElementTransformation :: VCalcHesse (const SIMD<ngfem::IntegrationPoint> & ip, SIMD<double> * hesse) const
   {
     cout << "ElementTransformation::VCalcHesse not overloaded for " << typeid(*this).name() << endl;
@@ -157,6 +157,30 @@ namespace ngfem
     /// return a mapped integration rule on localheap
     virtual SIMD_BaseMappedIntegrationRule & operator() (const SIMD_IntegrationRule & ir, Allocator & lh) const;
 
+    /// a mapped rule borrowed from the per-thread pool, returned on destruction
+    class PooledSIMD_MIR
+    {
+      SIMD_BaseMappedIntegrationRule * mir;
+      bool * in_use;
+    public:
+      PooledSIMD_MIR (SIMD_BaseMappedIntegrationRule & amir, bool * ain_use)
+        : mir(&amir), in_use(ain_use) { ; }
+      PooledSIMD_MIR (PooledSIMD_MIR && other)
+        : mir(other.mir), in_use(other.in_use) { other.in_use = nullptr; }
+      PooledSIMD_MIR (const PooledSIMD_MIR &) = delete;
+      ~PooledSIMD_MIR () { if (in_use) *in_use = false; }
+      SIMD_BaseMappedIntegrationRule & operator* () const { return *mir; }
+      operator SIMD_BaseMappedIntegrationRule & () const { return *mir; }
+    };
+
+    /**
+       Like operator(), but re-uses a mapped rule of the per-thread pool.
+       Rules are kept for persistent integration rules (one per element type 
+       and order), and are only re-mapped to the new element. 
+       Falls back to the localheap for non-persistent rules.
+     */
+    NGS_DLL_HEADER PooledSIMD_MIR GetPooledMIR (const SIMD_IntegrationRule & ir, LocalHeap & lh) const;
+
     template <int DIMS, int DIMR> 
       void CalcHesse (const SIMD<ngfem::IntegrationPoint> & ip, Vec<DIMR, Mat<DIMS,DIMS,SIMD<double>>> & hesse) const
     {
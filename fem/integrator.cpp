@@ -213,6 +213,20 @@ namespace ngfem
     elmat += helmat;
     if (!IsSymmetric().IsTrue()) symmetric_so_far = false;    
   }
+
+  void BilinearFormIntegrator ::
+  CalcElementMatrixSymmetricAdd (const FiniteElement & fel,
+                                 const ElementTransformation & eltrans, 
+                                 FlatSymmetricMatrix<double> elmat,
+                                 LocalHeap & lh) const
+  {
+    HeapReset hr(lh);
+    FlatMatrix<double> helmat(elmat.Height(), elmat.Width(), lh);
+    helmat = 0.0;
+    bool symmetric_so_far = true;
+    CalcElementMatrixAdd(fel, eltrans, helmat, symmetric_so_far, lh);
+    elmat.AddLower(helmat);
+  }
   
 
 
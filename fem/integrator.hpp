@@ -57,8 +57,12 @@ namespace ngfem
     shared_ptr<BitArray> definedon_element = nullptr;
     std::array<unique_ptr<IntegrationRule>,25> userdefined_intrules;
     std::array<unique_ptr<SIMD_IntegrationRule>,25> userdefined_simd_intrules;
+    /// family of trig/tet rules, IRT_DEFAULT follows the global setting
+    INTRULE_TYPE intrule_type = IRT_DEFAULT;
 
     mutable bool simd_evaluate = true;
+    /// maximal LocalHeap usage of one element computation
+    mutable atomic<size_t> heap_highwater{0};
 
     shared_ptr<ngcomp::GridFunction> deformation; // ALE for this integrator
     
@@ -125,14 +129,29 @@ namespace ngfem
         }
     }
 
+    void SetIntegrationRuleType (INTRULE_TYPE type) { intrule_type = type; }
+    INTRULE_TYPE GetIntegrationRuleType () const { return intrule_type; }
+
     inline const IntegrationRule& GetIntegrationRule(ELEMENT_TYPE et, int order) const
     {
-      return userdefined_intrules[et] ? *userdefined_intrules[et] : SelectIntegrationRule(et,order);
+      return userdefined_intrules[et] ? *userdefined_intrules[et] : SelectIntegrationRule(et,order,intrule_type);
     }
     inline const SIMD_IntegrationRule& GetSIMDIntegrationRule(ELEMENT_TYPE et, int order) const
     {
-      return userdefined_simd_intrules[et] ? *userdefined_simd_intrules[et] : SIMD_SelectIntegrationRule(et,order);
+      return userdefined_simd_intrules[et] ? *userdefined_simd_intrules[et] : SIMD_SelectIntegrationRule(et,order,intrule_type);
+    }
+
+    /// record the heap memory used since heapstart
+    void RecordHeapUsage (void * heapstart, LocalHeap & lh) const
+    {
+      size_t used = (char*)lh.GetPointer() - (char*)heapstart;
+      size_t prev = heap_highwater.load(memory_order_relaxed);
+      while (used > prev && !heap_highwater.compare_exchange_weak(prev, used, memory_order_relaxed))
+        ;
     }
+    /// maximal LocalHeap usage per element in bytes, to size the heaps
+    size_t GetHeapHighWater () const { return heap_highwater.load(); }
+    void ResetHeapHighWater () { heap_highwater = 0; }
 
     /// defined only on some elements/facets/boundary elements
     shared_ptr<BitArray> GetDefinedOnElements () const { return definedon_element; } 
@@ -262,6 +281,24 @@ namespace ngfem
     const shared_ptr<ngcomp::GridFunction> & GetDeformation() const { return deformation; }
   };
 
+  /**
+     Records the heap usage of an element computation when leaving the scope.
+     Declare it after the HeapReset of the scope, so that it sees the heap
+     before the reset.
+  */
+  class HeapUsageRecorder
+  {
+    const Integrator & integrator;
+    LocalHeap & lh;
+    void * heapstart;
+  public:
+    HeapUsageRecorder (const Integrator & aintegrator, LocalHeap & alh)
+      : integrator(aintegrator), lh(alh), heapstart(alh.GetPointer()) { ; }
+    ~HeapUsageRecorder () { integrator.RecordHeapUsage (heapstart, lh); }
+    /// record the current usage, at the deepest point of inner loops
+    void Record () const { integrator.RecordHeapUsage (heapstart, lh); }
+  };
+
 
   ostream & operator << (ostream & ost, const Integrator & igt);
 
@@ -330,6 +367,16 @@ namespace ngfem
                             FlatMatrix<Complex> elmat,
                             bool & symmetric_so_far,                            
                             LocalHeap & lh) const;
+
+    /**
+       Computes the element matrix of a symmetric integrator.
+       Add the lower triangle to the packed elmat
+    */
+    virtual void
+      CalcElementMatrixSymmetricAdd (const FiniteElement & fel,
+                                     const ElementTransformation & eltrans, 
+                                     FlatSymmetricMatrix<double> elmat,
+                                     LocalHeap & lh) const;
     
 
     
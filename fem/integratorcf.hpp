@@ -13,6 +13,7 @@ namespace ngfem
     int bonus_intorder = 0;
     shared_ptr<ngcomp::GridFunction> deformation;
     std::map<ELEMENT_TYPE,shared_ptr<IntegrationRule>> userdefined_intrules;
+    INTRULE_TYPE intrule_type = IRT_DEFAULT;
     shared_ptr<BitArray> definedonelements;
     
     DifferentialSymbol (VorB _vb) : vb(_vb) { ; }
@@ -2310,6 +2310,9 @@ namespace ngfem
     Array<IntegrationRule*> jacobirules10;
     Array<IntegrationRule*> jacobirules20;
 
+    Array<IntegrationRule*> symtrigrules, symtetrules;
+    Array<SIMD_IntegrationRule*> simd_symtrigrules, simd_symtetrules;
+
   public:
     static IntegrationRule intrule0, intrule1;
     static SIMD_IntegrationRule *simd_intrule0, *simd_intrule1;
@@ -2325,6 +2328,9 @@ namespace ngfem
     ///
     const IntegrationRule & SelectIntegrationRuleJacobi20 (int order) const;
     const SIMD_IntegrationRule & SIMD_SelectIntegrationRule (ELEMENT_TYPE eltyp, int order);
+    /// fully symmetric rule for trig/tet, nullptr if not tabulated
+    const IntegrationRule * SelectSymmetricIntegrationRule (ELEMENT_TYPE eltyp, int order);
+    const SIMD_IntegrationRule * SIMD_SelectSymmetricIntegrationRule (ELEMENT_TYPE eltyp, int order);
     ///
     const IntegrationRule & GenerateIntegrationRule (ELEMENT_TYPE eltyp, int order);
     const IntegrationRule & GenerateIntegrationRuleJacobi10 (int order);
@@ -2651,6 +2657,16 @@ namespace ngfem
 	GenerateIntegrationRuleJacobi10 (i);
 	GenerateIntegrationRuleJacobi20 (i);
       }
+
+    // symmetric rules are generated on demand, arrays are never resized
+    symtrigrules.SetSize (MaxSymmetricIntegrationOrder(ET_TRIG)+1);
+    symtetrules.SetSize (MaxSymmetricIntegrationOrder(ET_TET)+1);
+    simd_symtrigrules.SetSize (symtrigrules.Size());
+    simd_symtetrules.SetSize (symtetrules.Size());
+    for (auto & ir : symtrigrules) ir = nullptr;
+    for (auto & ir : symtetrules) ir = nullptr;
+    for (auto & ir : simd_symtrigrules) ir = nullptr;
+    for (auto & ir : simd_symtetrules) ir = nullptr;
   }
 
 
@@ -2684,7 +2700,11 @@ namespace ngfem
 
     for (int i = 0; i < jacobirules20.Size(); i++)
       delete jacobirules20[i];
-   
+
+    for (auto ir : symtrigrules) delete ir;
+    for (auto ir : symtetrules) delete ir;
+    for (auto ir : simd_symtrigrules) delete ir;
+    for (auto ir : simd_symtetrules) delete ir;
   }
 
 
@@ -3204,7 +3224,7 @@ namespace ngfem
 
         if ( (*ira)[order] == nullptr)
           {
-            IntegrationRule ir(eltype, order);
+            const IntegrationRule & ir = SelectIntegrationRule (eltype, order);
             auto tmp = new SIMD_IntegrationRule(ir);
             switch (eltype)
               {
@@ -3262,6 +3282,7 @@ namespace ngfem
               default:
                 ;
               }
+            tmp->SetPersistent();
             (*ira)[order] = tmp;
           }
       }
@@ -3269,6 +3290,50 @@ namespace ngfem
     return *((*ira)[order]);
   }
 
+
+  const IntegrationRule * IntegrationRules :: SelectSymmetricIntegrationRule (ELEMENT_TYPE eltype, int order)
+  {
+    if (eltype != ET_TRIG && eltype != ET_TET) return nullptr;
+    Array<IntegrationRule*> & ira = (eltype == ET_TRIG) ? symtrigrules : symtetrules;
+
+    if (order < 0) order = 0;
+    if (order >= ira.Size()) return nullptr;
+
+    if (ira[order] == nullptr)
+      {
+        lock_guard<mutex> guard(genintrule_mutex);
+        if (ira[order] == nullptr)
+          {
+            auto ir = new IntegrationRule;
+            GenerateSymmetricIntegrationRule (eltype, order, *ir);
+            ira[order] = ir;
+          }
+      }
+    return ira[order];
+  }
+
+  const SIMD_IntegrationRule * IntegrationRules :: SIMD_SelectSymmetricIntegrationRule (ELEMENT_TYPE eltype, int order)
+  {
+    if (eltype != ET_TRIG && eltype != ET_TET) return nullptr;
+    Array<SIMD_IntegrationRule*> & ira = (eltype == ET_TRIG) ? simd_symtrigrules : simd_symtetrules;
+
+    if (order < 0) order = 0;
+    if (order >= ira.Size()) return nullptr;
+
+    if (ira[order] == nullptr)
+      {
+        const IntegrationRule & ir = *SelectSymmetricIntegrationRule (eltype, order);
+        lock_guard<mutex> guard(simd_genintrule_mutex[eltype]);
+        if (ira[order] == nullptr)
+          {
+            auto tmp = new SIMD_IntegrationRule(ir);
+            tmp->SetPersistent();
+            ira[order] = tmp;
+          }
+      }
+    return ira[order];
+  }
+
   SIMD_IntegrationRule::SIMD_IntegrationRule (const IntegrationRule & ir)
     : Array<SIMD<IntegrationPoint>> (0, nullptr)
   {
@@ -3329,7 +3394,7 @@ namespace ngfem
     FlatArray<SIMD<IntegrationPoint>> hir = ir;
     FlatArray<SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>>> hmips = mips;
     for (size_t i = 0; i < hir.Size(); i++)
-      new (&hmips[i]) SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>> (hir[i], eltrans, -1);
+      new (&hmips[i]) SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>> (hir[i], aeltrans, -1);
 
     new (&points) BareSliceMatrix<SIMD<double>> (sizeof(SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>>)/sizeof(SIMD<double>),
                                                  &mips[0].Point()(0),
@@ -3339,11 +3404,27 @@ namespace ngfem
                                                   &mips[0].NV()(0),
                                                   DummySize(mips.Size(), DIM_SPACE));
     
-    eltrans.CalcMultiPointJacobian (ir, *this);
+    aeltrans.CalcMultiPointJacobian (ir, *this);
 
     if (ir.Size())
       if (ir[0].VB() != VOL)
-        ComputeNormalsAndMeasure (eltrans.GetElementType(), ir[0].FacetNr());
+        ComputeNormalsAndMeasure (aeltrans.GetElementType(), ir[0].FacetNr());
+  }
+
+  template <int DIM_ELEMENT, int DIM_SPACE>
+  void SIMD_MappedIntegrationRule<DIM_ELEMENT,DIM_SPACE> :: 
+  ReMap (const ElementTransformation & aeltrans)
+  {
+    eltrans = &aeltrans;
+    other_mir = nullptr;
+    for (auto & mip : mips)
+      mip.SetTransformation (aeltrans);
+
+    aeltrans.CalcMultiPointJacobian (ir, *this);
+
+    if (ir.Size())
+      if (ir[0].VB() != VOL)
+        ComputeNormalsAndMeasure (aeltrans.GetElementType(), ir[0].FacetNr());
   }
 
   template <int DIM_ELEMENT, int DIM_SPACE>
@@ -3495,8 +3576,29 @@ namespace ngfem
   }
 
 
+  static INTRULE_TYPE intrule_type = IRT_STANDARD;
+
+  void SetIntegrationRuleType (INTRULE_TYPE type)
+  {
+    intrule_type = (type == IRT_DEFAULT) ? IRT_STANDARD : type;
+  }
+
+  INTRULE_TYPE GetIntegrationRuleType ()
+  {
+    return intrule_type;
+  }
+
   const IntegrationRule & SelectIntegrationRule (ELEMENT_TYPE eltype, int order)
   {
+    return SelectIntegrationRule (eltype, order, IRT_DEFAULT);
+  }
+
+  const IntegrationRule & SelectIntegrationRule (ELEMENT_TYPE eltype, int order, INTRULE_TYPE type)
+  {
+    if (type == IRT_DEFAULT) type = intrule_type;
+    if (type == IRT_SYMMETRIC)
+      if (auto ir = const_cast<IntegrationRules&>(GetIntegrationRules()).SelectSymmetricIntegrationRule (eltype, order))
+        return *ir;
     return GetIntegrationRules ().SelectIntegrationRule (eltype, order);
   }
 
@@ -3512,7 +3614,17 @@ namespace ngfem
 
   const SIMD_IntegrationRule & SIMD_SelectIntegrationRule (ELEMENT_TYPE eltype, int order)
   {
-    return const_cast<IntegrationRules&>(GetIntegrationRules()).SIMD_SelectIntegrationRule (eltype, order);
+    return SIMD_SelectIntegrationRule (eltype, order, IRT_DEFAULT);
+  }
+
+  const SIMD_IntegrationRule & SIMD_SelectIntegrationRule (ELEMENT_TYPE eltype, int order, INTRULE_TYPE type)
+  {
+    auto & rules = const_cast<IntegrationRules&>(GetIntegrationRules());
+    if (type == IRT_DEFAULT) type = intrule_type;
+    if (type == IRT_SYMMETRIC)
+      if (auto ir = rules.SIMD_SelectSymmetricIntegrationRule (eltype, order))
+        return *ir;
+    return rules.SIMD_SelectIntegrationRule (eltype, order);
   }
 
 
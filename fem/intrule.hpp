@@ -850,7 +850,29 @@ namespace ngfem
 				  Array<double> & w);
   
 
+  /**
+     Families of integration rules for triangles and tetrahedra.
+     IRT_STANDARD are the tabulated low order rules, and collapsed 
+     Gauss-Jacobi rules for higher orders. IRT_SYMMETRIC are fully 
+     symmetric rules with (close to) minimal number of points, they
+     are available up to MaxSymmetricIntegrationOrder(et), beyond that
+     the standard rules are used. IRT_DEFAULT uses the global setting.
+   */
+  enum INTRULE_TYPE { IRT_DEFAULT, IRT_STANDARD, IRT_SYMMETRIC };
+
+  /// global rule family used by SelectIntegrationRule (eltype, order)
+  extern NGS_DLL_HEADER void SetIntegrationRuleType (INTRULE_TYPE type);
+  extern NGS_DLL_HEADER INTRULE_TYPE GetIntegrationRuleType ();
+
+  /// highest order of tabulated symmetric rules, -1 if there are none
+  extern NGS_DLL_HEADER int MaxSymmetricIntegrationOrder (ELEMENT_TYPE eltype);
+  /// generates the fully symmetric rule, returns false if not available
+  extern NGS_DLL_HEADER bool GenerateSymmetricIntegrationRule (ELEMENT_TYPE eltype, int order,
+                                                               IntegrationRule & ir);
+  
   extern NGS_DLL_HEADER const IntegrationRule & SelectIntegrationRule (ELEMENT_TYPE eltype, int order);
+  extern NGS_DLL_HEADER const IntegrationRule & SelectIntegrationRule (ELEMENT_TYPE eltype, int order,
+                                                                       INTRULE_TYPE type);
   extern NGS_DLL_HEADER const IntegrationRule & SelectIntegrationRuleJacobi10 (int order);
   extern NGS_DLL_HEADER const IntegrationRule & SelectIntegrationRuleJacobi20 (int order);
 
@@ -1709,6 +1731,7 @@ namespace ngstd
     // ~SIMD();
     const SIMD<ngfem::IntegrationPoint> & IP () const { return ip; }
     const ngfem::ElementTransformation & GetTransformation () const { return *eltrans; }
+    void SetTransformation (const ngfem::ElementTransformation & aeltrans) { eltrans = &aeltrans; }
     // int GetIPNr() const { return ip.Nr(); }
 
     int DimElement() const;
@@ -2273,6 +2296,7 @@ namespace ngfem
     int dimension = -1;
     size_t nip = -47;
     const SIMD_IntegrationRule *irx = nullptr, *iry = nullptr, *irz = nullptr; // for tensor product IR
+    bool persistent = false;   // lives in the global rule tables, may be used as cache key
   public:
     SIMD_IntegrationRule () = default;
     inline SIMD_IntegrationRule (ELEMENT_TYPE eltype, int order);
@@ -2316,9 +2340,14 @@ namespace ngfem
     void SetIRX(const SIMD_IntegrationRule * ir) { irx = ir; }
     void SetIRY(const SIMD_IntegrationRule * ir) { iry = ir; }
     void SetIRZ(const SIMD_IntegrationRule * ir) { irz = ir; }
+
+    bool IsPersistent() const { return persistent; }
+    void SetPersistent(bool p = true) { persistent = p; }
   };
 
   extern NGS_DLL_HEADER const SIMD_IntegrationRule & SIMD_SelectIntegrationRule (ELEMENT_TYPE eltype, int order);
+  extern NGS_DLL_HEADER const SIMD_IntegrationRule & SIMD_SelectIntegrationRule (ELEMENT_TYPE eltype, int order,
+                                                                                 INTRULE_TYPE type);
 
   inline SIMD_IntegrationRule :: SIMD_IntegrationRule (ELEMENT_TYPE eltype, int order)
   { 
@@ -2340,7 +2369,7 @@ namespace ngfem
   { 
   protected:
     SIMD_IntegrationRule ir;
-    const ElementTransformation & eltrans;
+    const ElementTransformation * eltrans;
     char * baseip;
     size_t incr;
     int dim_element, dim_space;
@@ -2353,7 +2382,7 @@ namespace ngfem
   public:
     SIMD_BaseMappedIntegrationRule (const SIMD_IntegrationRule & air,
                                     const ElementTransformation & aeltrans)
-      : ir(air.Size(),&air[0]), eltrans(aeltrans)
+      : ir(air.Size(),&air[0]), eltrans(&aeltrans)
     {
       ir.SetIRX(&air.GetIRX());
       ir.SetIRY(&air.GetIRY());
@@ -2365,8 +2394,10 @@ namespace ngfem
 
     INLINE size_t Size() const { return ir.Size(); }
     INLINE const SIMD_IntegrationRule & IR() const { return ir; }
-    INLINE const ElementTransformation & GetTransformation () const { return eltrans; }
+    INLINE const ElementTransformation & GetTransformation () const { return *eltrans; }
     virtual void ComputeNormalsAndMeasure (ELEMENT_TYPE et, int facetnr) = 0;    
+    /// map the same rule to another element of same dimensions, re-using the memory
+    virtual void ReMap (const ElementTransformation & aeltrans) = 0;
     INLINE const SIMD<BaseMappedIntegrationPoint> & operator[] (size_t i) const
     { return *static_cast<const SIMD<BaseMappedIntegrationPoint>*> ((void*)(baseip+i*incr)); }
     INLINE int DimElement() const { return dim_element; }
@@ -2413,7 +2444,7 @@ namespace ngfem
         incr = sizeof (SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>>);
 
         for (size_t i = 0; i < ir.Size(); i++)
-          new (&mips[i]) SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>> (ir[i], eltrans, -1);
+          new (&mips[i]) SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>> (ir[i], aeltrans, -1);
 
         new (&points) BareSliceMatrix<SIMD<double>> (sizeof(SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>>)/sizeof(SIMD<double>),
                                                      &mips[0].Point()(0),
@@ -2425,6 +2456,7 @@ namespace ngfem
       }
 
     virtual void ComputeNormalsAndMeasure (ELEMENT_TYPE et, int facetnr) override;
+    virtual void ReMap (const ElementTransformation & aeltrans) override;
     SIMD<MappedIntegrationPoint<DIM_ELEMENT, DIM_SPACE>> & operator[] (size_t i) const 
     { 
       return mips[i]; 
@@ -0,0 +1,470 @@
+/*********************************************************************/
+/* File:   intrule_symmetric.cpp                                     */
+/* Date:   Oct. 2026                                                 */
+/*********************************************************************/
+
+/* 
+   Fully symmetric integration rules for triangles and tetrahedra.
+
+   The rules are given by orbits of the symmetry group of the simplex,
+   in barycentric coordinates. All weights are positive, all points
+   are inside the element. The rules have been computed by minimizing 
+   the moment residual for orthogonal polynomials over prescribed orbit 
+   structures (in the spirit of Witherden-Vincent), and were checked
+   for exactness on monomials. If no dedicated rule is available for 
+   an order, the cheapest rule of higher order is used.
+*/
+
+
+#include <fem.hpp>
+   
+namespace ngfem
+{
+  namespace
+  {
+    /*
+      trig:  S3 (1/3,1/3,1/3),  S21 (a,a,1-2a),  S111 (a,b,1-a-b)
+      tet:   S4 (1/4,..),  S31 (a,a,a,1-3a),  S22 (a,a,1/2-a,1/2-a),
+             S211 (a,a,b,1-2a-b),  S1111 (a,b,c,1-a-b-c)
+    */
+    enum ORBIT_TYPE { S3, S21, S111, S4, S31, S22, S211, S1111 };
+    
+    struct SymmetricOrbit
+    {
+      ORBIT_TYPE type;
+      double weight;   // weight of every point in the orbit
+      double a, b, c;
+    };
+
+    struct SymmetricRule
+    {
+      int nip;
+      size_t norbits;
+      const SymmetricOrbit * orbits;
+    };
+  }
+
+  // order 1, 1 point
+  static const SymmetricOrbit trig_1[] = {
+    { S3, 0.5, 0.0, 0.0, 0.0 },
+  };
+
+  // order 2, 3 points
+  static const SymmetricOrbit trig_2[] = {
+    { S21, 0.16666666666666663, 0.16666666666666669, 0.0, 0.0 },
+  };
+
+  // order 3, 6 points
+  static const SymmetricOrbit trig_3[] = {
+    { S111, 0.08333333333333338, 0.6590276223740923, 0.10903900907287718, 0.0 },
+  };
+
+  // order 4, 6 points
+  static const SymmetricOrbit trig_4[] = {
+    { S21, 0.11169079483900574, 0.4459484909159649, 0.0, 0.0 },
+    { S21, 0.05497587182766093, 0.09157621350977077, 0.0, 0.0 },
+  };
+
+  // order 5, 7 points
+  static const SymmetricOrbit trig_5[] = {
+    { S3, 0.11250000000000006, 0.0, 0.0, 0.0 },
+    { S21, 0.06619707639425315, 0.47014206410511516, 0.0, 0.0 },
+    { S21, 0.06296959027241364, 0.10128650732345619, 0.0, 0.0 },
+  };
+
+  // order 6, 12 points
+  static const SymmetricOrbit trig_6[] = {
+    { S21, 0.05839313786318978, 0.24928674517091035, 0.0, 0.0 },
+    { S21, 0.02542245318510347, 0.06308901449150221, 0.0, 0.0 },
+    { S111, 0.04142553780918681, 0.3103524510337845, 0.053145049844816876, 0.0 },
+  };
+
+  // order 7, 15 points
+  static const SymmetricOrbit trig_7[] = {
+    { S21, 0.06269680372465149, 0.24325913983560757, 0.0, 0.0 },
+    { S111, 0.013831762300736704, 0.8676425388119305, 0.04572082984632039, 0.0 },
+    { S111, 0.03815316917027082, 0.6306414258452558, 0.31864418984753706, 0.0 },
+  };
+
+  // order 8, 16 points
+  static const SymmetricOrbit trig_8[] = {
+    { S3, 0.07215780383889353, 0.0, 0.0, 0.0 },
+    { S21, 0.04754581713364232, 0.4592925882927232, 0.0, 0.0 },
+    { S21, 0.05160868526735909, 0.17056930775176024, 0.0, 0.0 },
+    { S21, 0.016229248811599054, 0.050547228317031005, 0.0, 0.0 },
+    { S111, 0.013615157087217495, 0.2631128296346381, 0.7284923929554042, 0.0 },
+  };
+
+  // order 9, 19 points
+  static const SymmetricOrbit trig_9[] = {
+    { S3, 0.048567898141399404, 0.0, 0.0, 0.0 },
+    { S21, 0.03891377050238713, 0.43708959149293664, 0.0, 0.0 },
+    { S21, 0.012788837829348995, 0.04472951339445274, 0.0, 0.0 },
+    { S21, 0.0398238694636051, 0.18820353561903275, 0.0, 0.0 },
+    { S21, 0.015667350113569505, 0.4896825191987376, 0.0, 0.0 },
+    { S111, 0.021641769688644657, 0.741198598784498, 0.036838412054736314, 0.0 },
+  };
+
+  // order 10, 25 points
+  static const SymmetricOrbit trig_10[] = {
+    { S3, 0.04160986849322505, 0.0, 0.0, 0.0 },
+    { S21, 0.005475644170134198, 0.02850350028838783, 0.0, 0.0 },
+    { S21, 0.026325974734122272, 0.16291311787409476, 0.0, 0.0 },
+    { S111, 0.014661432047826103, 0.8130112461498283, 0.03368569868061029, 0.0 },
+    { S111, 0.028138639855405573, 0.516492619327838, 0.33669587527823164, 0.0 },
+    { S111, 0.017697473895769183, 0.60732977850085, 0.029307604504579473, 0.0 },
+  };
+
+  // order 11, 28 points
+  static const SymmetricOrbit trig_11[] = {
+    { S3, 0.040538231472781745, 0.0, 0.0, 0.0 },
+    { S21, 0.033823677619780806, 0.21476409090473175, 0.0, 0.0 },
+    { S21, 0.020126830834288224, 0.1138591240291737, 0.0, 0.0 },
+    { S21, 0.03136338441398919, 0.4364371827220585, 0.0, 0.0 },
+    { S21, 0.00606386768766197, 0.4990633569444419, 0.0, 0.0 },
+    { S21, 0.006175799082159207, 0.030971968812356004, 0.0, 0.0 },
+    { S111, 0.007419175516637206, 0.8253563815032834, 0.014738980432483756, 0.0 },
+    { S111, 0.02038100608562615, 0.047773717411249396, 0.6400098234328134, 0.0 },
+  };
+
+  // order 12, 33 points
+  static const SymmetricOrbit trig_12[] = {
+    { S21, 0.0030831305257795227, 0.02131735045321034, 0.0, 0.0 },
+    { S21, 0.03142911210894257, 0.2712103850121159, 0.0, 0.0 },
+    { S21, 0.012865533220227697, 0.4882173897738049, 0.0, 0.0 },
+    { S21, 0.017398056465354483, 0.12757614554158586, 0.0, 0.0 },
+    { S21, 0.021846272269019223, 0.4397243922944603, 0.0, 0.0 },
+    { S111, 0.008658115554329462, 0.11625191590759713, 0.8580140335440727, 0.0 },
+    { S111, 0.020185778883190477, 0.6089432357797879, 0.11534349453469796, 0.0 },
+    { S111, 0.011178386601151743, 0.6958360867878035, 0.022838332222256987, 0.0 },
+  };
+
+  // order 13, 37 points
+  static const SymmetricOrbit trig_13[] = {
+    { S3, 0.0339800182934158, 0.0, 0.0, 0.0 },
+    { S21, 0.003026168551769582, 0.021509681108843156, 0.0, 0.0 },
+    { S21, 0.027800983765226658, 0.4269414142598004, 0.0, 0.0 },
+    { S21, 0.02913924255959997, 0.22137228629183292, 0.0, 0.0 },
+    { S21, 0.011997200964447358, 0.48907694645253935, 0.0, 0.0 },
+    { S111, 0.004795340501771622, 0.2725158177734297, 0.0051263891023823616, 0.0 },
+    { S111, 0.01732063807042419, 0.6235459955536756, 0.3084417608921177, 0.0 },
+    { S111, 0.012089519905796906, 0.08789548303219737, 0.7485071158999521, 0.0 },
+    { S111, 0.00748270055258283, 0.8647077702954428, 0.02437018690109386, 0.0 },
+  };
+
+  // order 14, 42 points
+  static const SymmetricOrbit trig_14[] = {
+    { S21, 0.016394176772062664, 0.41764471934045394, 0.0, 0.0 },
+    { S21, 0.007216849834888322, 0.06179988309087262, 0.0, 0.0 },
+    { S21, 0.021081294368496498, 0.17720553241254344, 0.0, 0.0 },
+    { S21, 0.025887052253645765, 0.27347752830883865, 0.0, 0.0 },
+    { S21, 0.010941790684714429, 0.4889639103621786, 0.0, 0.0 },
+    { S21, 0.002461701801200035, 0.01939096124870105, 0.0, 0.0 },
+    { S111, 0.007218154056766913, 0.6869801678080879, 0.2983728821362577, 0.0 },
+    { S111, 0.0025051144192503347, 0.8797571713701711, 0.001268330932872015, 0.0 },
+    { S111, 0.01233287660628183, 0.7706085547749965, 0.1722666878213556, 0.0 },
+    { S111, 0.01928575539353032, 0.09291624935697182, 0.5702222908466832, 0.0 },
+  };
+
+  // order 15, 49 points
+  static const SymmetricOrbit trig_15[] = {
+    { S3, 0.024777380743035555, 0.0, 0.0, 0.0 },
+    { S21, 0.00924339430233078, 0.07903101365554163, 0.0, 0.0 },
+    { S21, 0.00224857689621754, 0.0187895018107701, 0.0, 0.0 },
+    { S21, 0.019011381726930558, 0.4088631690774411, 0.0, 0.0 },
+    { S21, 0.0067052581900064025, 0.4925016882324967, 0.0, 0.0 },
+    { S111, 0.015630213780078783, 0.3688394837485754, 0.5534967491871164, 0.0 },
+    { S111, 0.005874737324256961, 0.6597598927179693, 0.32515745241110783, 0.0 },
+    { S111, 0.0032209366452594615, 0.8951462452879488, 0.012563596287785016, 0.0 },
+    { S111, 0.014605445387471876, 0.2670952856700523, 0.5387785106422014, 0.0 },
+    { S111, 0.015087322572773119, 0.2025054980483, 0.6987285905959879, 0.0 },
+    { S111, 0.006180808608577809, 0.7834502256732081, 0.02159462843398032, 0.0 },
+  };
+
+  // order 16, 55 points
+  static const SymmetricOrbit trig_16[] = {
+    { S3, 0.022754856820545497, 0.0, 0.0, 0.0 },
+    { S21, 0.0012827520711343292, 0.01378789382488993, 0.0, 0.0 },
+    { S21, 0.00831006986109851, 0.4287720511409793, 0.0, 0.0 },
+    { S21, 0.0052042596029980735, 0.4939677744427702, 0.0, 0.0 },
+    { S21, 0.0074675856168781515, 0.08184464296361423, 0.0, 0.0 },
+    { S21, 0.015968913556468678, 0.17808983755091176, 0.0, 0.0 },
+    { S21, 0.01129104997400539, 0.46778542106057686, 0.0, 0.0 },
+    { S111, 0.004482921620645239, 0.8026253222517847, 0.18399586742077492, 0.0 },
+    { S111, 0.003567809514276664, 0.9086981456866124, 0.016316019407894677, 0.0 },
+    { S111, 0.009563680801937684, 0.7455601666186993, 0.18345017444633388, 0.0 },
+    { S111, 0.01748436384427421, 0.4876241242290439, 0.1974525340233747, 0.0 },
+    { S111, 0.006643854193904958, 0.6546530547840218, 0.3287632304695872, 0.0 },
+    { S111, 0.013035911880245454, 0.31087857018263443, 0.0852985084016416, 0.0 },
+  };
+
+  // order 17, 61 points
+  static const SymmetricOrbit trig_17[] = {
+    { S3, 0.01660393792678501, 0.0, 0.0, 0.0 },
+    { S21, 0.011882774437462478, 0.17443111686782814, 0.0, 0.0 },
+    { S21, 0.0016824593761243893, 0.01608926967100796, 0.0, 0.0 },
+    { S21, 0.01601146192059318, 0.40914294517037664, 0.0, 0.0 },
+    { S21, 0.012846655607411082, 0.4616079395947335, 0.0, 0.0 },
+    { S21, 0.0062599847812191915, 0.4921883205997769, 0.0, 0.0 },
+    { S21, 0.015961515126964924, 0.26145901512577013, 0.0, 0.0 },
+    { S111, 0.004857434003112746, 0.19364357055407994, 0.014656540514619091, 0.0 },
+    { S111, 0.01341438324373344, 0.13676748005935982, 0.29639593882689286, 0.0 },
+    { S111, 0.0029817265702477493, 0.9046103819640378, 0.08246726806252168, 0.0 },
+    { S111, 0.0035538469263777404, 0.060364785074663606, 0.08229390834433062, 0.0 },
+    { S111, 0.009849556656340776, 0.631010757110872, 0.05271164633423006, 0.0 },
+    { S111, 0.003552306121975136, 0.6521040379629403, 0.008422391768749909, 0.0 },
+    { S111, 0.010034331198860436, 0.7494849709711693, 0.07679422586905704, 0.0 },
+  };
+
+  // order 18, 72 points
+  static const SymmetricOrbit trig_18[] = {
+    { S21, 0.011804156611517241, 0.2301428167425885, 0.0, 0.0 },
+    { S21, 0.004895128869071902, 0.49394234663437364, 0.0, 0.0 },
+    { S21, 0.0037319018105225403, 0.047552021232673714, 0.0, 0.0 },
+    { S21, 0.009176632031142043, 0.1276079986302664, 0.0, 0.0 },
+    { S111, 0.010734367627183869, 0.6328153121878367, 0.2369326431200695, 0.0 },
+    { S111, 0.00990188133519744, 0.4144889748161122, 0.25270735392425264, 0.0 },
+    { S111, 0.006070067610616713, 0.8212178430915724, 0.129395423960928, 0.0 },
+    { S111, 0.010378478829281685, 0.3920989214393077, 0.5462405816953642, 0.0 },
+    { S111, 0.0007159679683913234, 0.9705750050029794, 0.007179464833564285, 0.0 },
+    { S111, 0.0032661510333717035, 0.7925471597277219, 0.009857202508651729, 0.0 },
+    { S111, 0.012873241157158731, 0.4934482272536334, 0.1455362387892732, 0.0 },
+    { S111, 0.0019356024740609786, 0.9054373834182317, 0.08667066299867272, 0.0 },
+    { S111, 0.004439883423509262, 0.6500124111832827, 0.3384490161083459, 0.0 },
+    { S111, 0.008213782213434856, 0.6963835515135413, 0.24847657365156836, 0.0 },
+  };
+
+  // order 19, 76 points
+  static const SymmetricOrbit trig_19[] = {
+    { S3, 0.014759296732047669, 0.0, 0.0, 0.0 },
+    { S21, 0.008849283274695835, 0.1423208990164898, 0.0, 0.0 },
+    { S21, 0.011349117215150188, 0.2427709068298768, 0.0, 0.0 },
+    { S21, 0.0011545546048649918, 0.01330629179745834, 0.0, 0.0 },
+    { S111, 0.008399626790342216, 0.6800414228837686, 0.2618062616256611, 0.0 },
+    { S111, 0.010936755540659097, 0.6130296515486718, 0.24751807620870944, 0.0 },
+    { S111, 0.003344945292675269, 0.8257026640990165, 0.16233294124139094, 0.0 },
+    { S111, 0.003748526403671874, 0.2845134429943448, 0.7044300403861122, 0.0 },
+    { S111, 0.010864863740371477, 0.3742886322096889, 0.5052127352741941, 0.0 },
+    { S111, 0.00211831649242647, 0.9203571789976084, 0.010894367228653725, 0.0 },
+    { S111, 0.0035027204814454755, 0.5667770761330166, 0.00959955435913956, 0.0 },
+    { S111, 0.00807526488071828, 0.5474690744565425, 0.05016707257576452, 0.0 },
+    { S111, 0.010025043743536423, 0.21540818921903027, 0.34622292013803446, 0.0 },
+    { S111, 0.0023952625041193496, 0.06649864450631547, 0.05241061995175727, 0.0 },
+    { S111, 0.006785647127337438, 0.1449828801101105, 0.06150378990835735, 0.0 },
+  };
+
+  // order 20, 81 points
+  static const SymmetricOrbit trig_20[] = {
+    { S21, 0.0018556020750496811, 0.03225860053523861, 0.0, 0.0 },
+    { S21, 0.015076222610916274, 0.24343810636613822, 0.0, 0.0 },
+    { S21, 0.0006304451141728717, 0.009595349373072182, 0.0, 0.0 },
+    { S21, 0.0036981925015602455, 0.49124697814167895, 0.0, 0.0 },
+    { S21, 0.01598160546663508, 0.3743256872021317, 0.0, 0.0 },
+    { S21, 0.00809543137705444, 0.1705922413073923, 0.0, 0.0 },
+    { S21, 0.00766863781508976, 0.1123848859698269, 0.0, 0.0 },
+    { S111, 0.00806652769712529, 0.6134484516511844, 0.051243095528019256, 0.0 },
+    { S111, 0.003567375176649361, 0.011397904445900182, 0.2687063198994005, 0.0 },
+    { S111, 0.0025053978765760755, 0.15471766915051996, 0.8359648727833833, 0.0 },
+    { S111, 0.004241481638673466, 0.09465475673304523, 0.04003231374416576, 0.0 },
+    { S111, 0.002743246517824157, 0.3982828934073674, 0.5936522336436038, 0.0 },
+    { S111, 0.012874430494719816, 0.4982387324823173, 0.3576449562577614, 0.0 },
+    { S111, 0.0010790670731616913, 0.9323887300177826, 0.06301076301054939, 0.0 },
+    { S111, 0.00510211212021769, 0.44112324158617144, 0.49181684420352745, 0.0 },
+    { S111, 0.007299083730179697, 0.19637464381544717, 0.055145784752881274, 0.0 },
+    { S111, 0.009351542527967037, 0.11816819213932336, 0.2510449575012158, 0.0 },
+  };
+
+  static const SymmetricRule trigrules[] = {
+    { 1, std::size(trig_1), trig_1 },  // order 0
+    { 1, std::size(trig_1), trig_1 },  // order 1
+    { 3, std::size(trig_2), trig_2 },  // order 2
+    { 6, std::size(trig_3), trig_3 },  // order 3
+    { 6, std::size(trig_4), trig_4 },  // order 4
+    { 7, std::size(trig_5), trig_5 },  // order 5
+    { 12, std::size(trig_6), trig_6 },  // order 6
+    { 15, std::size(trig_7), trig_7 },  // order 7
+    { 16, std::size(trig_8), trig_8 },  // order 8
+    { 19, std::size(trig_9), trig_9 },  // order 9
+    { 25, std::size(trig_10), trig_10 },  // order 10
+    { 28, std::size(trig_11), trig_11 },  // order 11
+    { 33, std::size(trig_12), trig_12 },  // order 12
+    { 37, std::size(trig_13), trig_13 },  // order 13
+    { 42, std::size(trig_14), trig_14 },  // order 14
+    { 49, std::size(trig_15), trig_15 },  // order 15
+    { 55, std::size(trig_16), trig_16 },  // order 16
+    { 61, std::size(trig_17), trig_17 },  // order 17
+    { 72, std::size(trig_18), trig_18 },  // order 18
+    { 76, std::size(trig_19), trig_19 },  // order 19
+    { 81, std::size(trig_20), trig_20 },  // order 20
+  };
+
+  // order 1, 1 point
+  static const SymmetricOrbit tet_1[] = {
+    { S4, 0.16666666666666666, 0.0, 0.0, 0.0 },
+  };
+
+  // order 2, 4 points
+  static const SymmetricOrbit tet_2[] = {
+    { S31, 0.041666666666666644, 0.13819660112501053, 0.0, 0.0 },
+  };
+
+  // order 3, 8 points
+  static const SymmetricOrbit tet_3[] = {
+    { S31, 0.013869531825799062, 0.09038353122330126, 0.0, 0.0 },
+    { S31, 0.027797134840867665, 0.3276198882642511, 0.0, 0.0 },
+  };
+
+  // order 4, 14 points
+  static const SymmetricOrbit tet_4[] = {
+    { S31, 0.018337173783586767, 0.31065893770037933, 0.0, 0.0 },
+    { S31, 0.012051461815365065, 0.09204342492135659, 0.0, 0.0 },
+    { S22, 0.007518687378476584, 0.04847595890730794, 0.0, 0.0 },
+  };
+
+  // order 5, 14 points
+  static const SymmetricOrbit tet_5[] = {
+    { S31, 0.018781320953002632, 0.31088591926330067, 0.0, 0.0 },
+    { S31, 0.012248840519393659, 0.09273525031089114, 0.0, 0.0 },
+    { S22, 0.007091003462846916, 0.04550370412564957, 0.0, 0.0 },
+  };
+
+  // order 6, 24 points
+  static const SymmetricOrbit tet_6[] = {
+    { S31, 0.0016795351758867806, 0.04067395853461134, 0.0, 0.0 },
+    { S31, 0.009226196923942474, 0.32233789014227554, 0.0, 0.0 },
+    { S31, 0.006653791709694596, 0.214602871259152, 0.0, 0.0 },
+    { S211, 0.008035714285714304, 0.0636610018750175, 0.2696723314583158, 0.0 },
+  };
+
+  // order 7, 35 points
+  static const SymmetricOrbit tet_7[] = {
+    { S4, 0.015914214910688448, 0.0, 0.0, 0.0 },
+    { S31, 0.007054930201661148, 0.3157011497782028, 0.0, 0.0 },
+    { S22, 0.0053161546388095825, 0.05048982259839644, 0.0, 0.0 },
+    { S211, 0.006201188454722425, 0.18883383102600113, 0.04716070036099798, 0.0 },
+    { S211, 0.0013517951383172206, 0.021265472541483338, 0.146638813818485, 0.0 },
+  };
+
+  // order 8, 46 points
+  static const SymmetricOrbit tet_8[] = {
+    { S31, 0.0015237324130723691, 0.045532193562504306, 0.0, 0.0 },
+    { S31, 0.00752543462814543, 0.18806562254660028, 0.0, 0.0 },
+    { S31, 0.005309981275026133, 0.11769751016575315, 0.0, 0.0 },
+    { S31, 0.0074096785690909925, 0.31359750854187846, 0.0, 0.0 },
+    { S22, 0.0062002156988137, 0.0660391515215508, 0.0, 0.0 },
+    { S211, 0.001194762404278162, 0.021187838842582265, 0.713219343192772, 0.0 },
+    { S211, 0.002337743006758886, 0.20381415839461614, 0.003584496591598819, 0.0 },
+  };
+
+  // order 9, 61 points
+  static const SymmetricOrbit tet_9[] = {
+    { S4, 0.009625590720836946, 0.0, 0.0, 0.0 },
+    { S31, 0.0007301048044956183, 0.03493849593785961, 0.0, 0.0 },
+    { S31, 0.006545935996543889, 0.3143260710371168, 0.0, 0.0 },
+    { S31, 0.007398627573767023, 0.1532528239386897, 0.0, 0.0 },
+    { S22, 0.0006890457594628923, 0.48992886034629635, 0.0, 0.0 },
+    { S22, 0.005177784812012031, 0.41057236811154774, 0.0, 0.0 },
+    { S211, 0.00207630485564537, 0.04039206406941671, 0.7362696115998444, 0.0 },
+    { S1111, 0.0015927400312503864, 0.5623506671502927, 0.010709681785211521, 0.14243401922542018 },
+  };
+
+  // order 10, 84 points
+  static const SymmetricOrbit tet_10[] = {
+    { S31, 0.005381191771758654, 0.2897811808959082, 0.0, 0.0 },
+    { S31, 0.001688247283847764, 0.0984548147343561, 0.0, 0.0 },
+    { S31, 0.00013879263613398907, 0.016504492465753886, 0.0, 0.0 },
+    { S211, 0.00044047383517845296, 0.46070218275434316, 0.006719014563250167, 0.0 },
+    { S211, 0.0008903531511807555, 0.02821438630077171, 0.12981487757552487, 0.0 },
+    { S211, 0.004033314195612893, 0.11607732193487616, 0.26711238846712504, 0.0 },
+    { S211, 0.001847496636031823, 0.1727654825557712, 0.6373460936955685, 0.0 },
+    { S211, 0.0027648063961809026, 0.39093418241620376, 0.026223383866965978, 0.0 },
+    { S211, 0.001509700777457257, 0.033608254349658556, 0.32297570372452145, 0.0 },
+  };
+
+  // order 11, 107 points
+  static const SymmetricOrbit tet_11[] = {
+    { S4, 0.0035457114953018082, 0.0, 0.0, 0.0 },
+    { S31, 0.0023378631212228156, 0.32598978319921423, 0.0, 0.0 },
+    { S22, 0.0012182129877710546, 0.4716606820299052, 0.0, 0.0 },
+    { S211, 0.00226878776770491, 0.2512873418779153, 0.11105441954350365, 0.0 },
+    { S211, 0.0015746483426913984, 0.11537895348956545, 0.19544318186048415, 0.0 },
+    { S211, 0.000898252703396409, 0.02563716754718665, 0.7015138721497044, 0.0 },
+    { S211, 0.0013924825857152636, 0.1159453325029823, 0.026325665037737117, 0.0 },
+    { S211, 0.0018977910644746505, 0.11605341583969446, 0.4468227867601328, 0.0 },
+    { S211, 0.00026038805225300185, 0.015856813744152442, 0.07595062903270018, 0.0 },
+    { S1111, 0.0019563341068758134, 0.30436264865837154, 0.022885642501966653, 0.5321330593075654 },
+  };
+
+  static const SymmetricRule tetrules[] = {
+    { 1, std::size(tet_1), tet_1 },  // order 0
+    { 1, std::size(tet_1), tet_1 },  // order 1
+    { 4, std::size(tet_2), tet_2 },  // order 2
+    { 8, std::size(tet_3), tet_3 },  // order 3
+    { 14, std::size(tet_4), tet_4 },  // order 4
+    { 14, std::size(tet_5), tet_5 },  // order 5
+    { 24, std::size(tet_6), tet_6 },  // order 6
+    { 35, std::size(tet_7), tet_7 },  // order 7
+    { 46, std::size(tet_8), tet_8 },  // order 8
+    { 61, std::size(tet_9), tet_9 },  // order 9
+    { 84, std::size(tet_10), tet_10 },  // order 10
+    { 107, std::size(tet_11), tet_11 },  // order 11
+  };
+
+
+  int MaxSymmetricIntegrationOrder (ELEMENT_TYPE eltype)
+  {
+    switch (eltype)
+      {
+      case ET_TRIG: return std::size(trigrules)-1;
+      case ET_TET: return std::size(tetrules)-1;
+      default: return -1;
+      }
+  }
+
+  
+  bool GenerateSymmetricIntegrationRule (ELEMENT_TYPE eltype, int order,
+                                         IntegrationRule & ir)
+  {
+    if (order > MaxSymmetricIntegrationOrder(eltype)) return false;
+    if (order < 0) order = 0;
+
+    const SymmetricRule & rule = (eltype == ET_TRIG) ? trigrules[order] : tetrules[order];
+    int dim = ElementTopology::GetSpaceDim(eltype);
+    
+    ir.SetSize(0);
+    ir.SetAllocSize(rule.nip);
+    ir.SetDim(dim);
+    
+    for (auto & orbit : FlatArray<const SymmetricOrbit> (rule.norbits, rule.orbits))
+      {
+        double a = orbit.a, b = orbit.b, c = orbit.c;
+        double lam[4] = { 0, 0, 0, 0 };
+        switch (orbit.type)
+          {
+          case S3:    lam[0] = lam[1] = lam[2] = 1.0/3; break;
+          case S21:   lam[0] = lam[1] = a; lam[2] = 1-2*a; break;
+          case S111:  lam[0] = a; lam[1] = b; lam[2] = 1-a-b; break;
+          case S4:    lam[0] = lam[1] = lam[2] = lam[3] = 0.25; break;
+          case S31:   lam[0] = lam[1] = lam[2] = a; lam[3] = 1-3*a; break;
+          case S22:   lam[0] = lam[1] = a; lam[2] = lam[3] = 0.5-a; break;
+          case S211:  lam[0] = lam[1] = a; lam[2] = b; lam[3] = 1-2*a-b; break;
+          case S1111: lam[0] = a; lam[1] = b; lam[2] = c; lam[3] = 1-a-b-c; break;
+          }
+
+        // all distinct permutations of the barycentric coordinates
+        int nlam = dim+1;
+        std::sort (lam, lam+nlam);
+        do
+          {
+            IntegrationPoint ip(lam[0], lam[1], (dim == 3) ? lam[2] : 0.0, orbit.weight);
+            ip.SetNr (ir.Size());
+            ir.Append (ip);
+          }
+        while (std::next_permutation (lam, lam+nlam));
+      }
+
+    if (ir.Size() != rule.nip)
+      throw Exception ("symmetric integration rule: wrong number of points");
+    return true;
+  }
+}
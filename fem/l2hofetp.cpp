@@ -333,6 +333,183 @@ namespace ngfem
   }
 
 
+
+
+  void L2HighOrderFETP<ET_QUAD> ::
+  CalcTPFactors (const SIMD_IntegrationRule & irx, const SIMD_IntegrationRule & iry,
+                 FlatMatrix<SIMD<double>> shapex, FlatMatrix<SIMD<double>> dshapex,
+                 FlatMatrix<SIMD<double>> shapey, FlatMatrix<SIMD<double>> dshapey) const
+  {
+    double facx[] = { -1, 1, 1, -1 };
+    double facy[] = { -1, -1, 1, 1 };
+    INT<4> f = GetFaceSort (0, vnums);
+    double fx = facx[f[0]];
+    double fy = facy[f[0]];
+
+    for (size_t i = 0; i < irx.Size(); i++)
+      {
+        AutoDiff<1,SIMD<double>> adx(irx[i](0), 0);
+        LegendrePolynomial (order, fx*(2*adx-1),
+                            SBLambda([&] (size_t nr, auto val)
+                                     {
+                                       shapex(nr, i) = val.Value();
+                                       dshapex(nr, i) = val.DValue(0);
+                                     }));
+      }
+    
+    for (size_t i = 0; i < iry.Size(); i++)
+      {
+        AutoDiff<1,SIMD<double>> ady(iry[i](0), 0);
+        LegendrePolynomial (order, fy*(2*ady-1),
+                            SBLambda([&] (size_t nr, auto val)
+                                     {
+                                       shapey(nr, i) = val.Value();
+                                       dshapey(nr, i) = val.DValue(0);
+                                     }));
+      }
+  }
+
+  
+  void L2HighOrderFETP<ET_QUAD> ::
+  EvaluateGrad (const SIMD_BaseMappedIntegrationRule & mir,
+                BareSliceVector<> bcoefs,
+                BareSliceMatrix<SIMD<double>> values) const
+  {
+    static Timer t("quad evaluate grad");
+    static Timer tmult("quad evaluate grad mult");
+    ThreadRegionTimer reg(t, TaskManager::GetThreadId());
+
+    auto & ir = mir.IR();
+    if (ir.IsTP() && mir.DimSpace() == 2)
+      {
+        double facx[] = { -1, 1, 1, -1 };
+        INT<4> f = GetFaceSort (0, vnums);
+        bool flip = (facx[f[0]] == facx[f[1]]);
+        
+        auto & irx = ir.GetIRX();
+        auto & iry = ir.GetIRY();
+        size_t nipx = irx.GetNIP();
+        size_t nipy = iry.GetNIP();
+
+        // coefficients ordered as (x-polynomial, y-polynomial)
+        STACK_ARRAY(double, mem_coefs, sqr(order+1));
+        FlatMatrix<> cx(order+1, order+1, mem_coefs);
+        {
+          STACK_ARRAY(double, mem_lin, sqr(order+1));
+          FlatVector<> lin(sqr(order+1), mem_lin);
+          lin = bcoefs.Range(0,ndof);
+          FlatMatrix<> mat_coefs(order+1, order+1, mem_lin);
+          if (flip)
+            cx = Trans(mat_coefs);
+          else
+            cx = mat_coefs;
+        }
+        
+        STACK_ARRAY(SIMD<double>, mem_shapex, 2*(order+1)*irx.Size());
+        FlatMatrix<SIMD<double>> simd_shapex(order+1, irx.Size(), mem_shapex);
+        FlatMatrix<SIMD<double>> simd_dshapex(order+1, irx.Size(), &mem_shapex[(order+1)*irx.Size()]);
+        STACK_ARRAY(SIMD<double>, mem_shapey, 2*(order+1)*iry.Size());
+        FlatMatrix<SIMD<double>> simd_shapey(order+1, iry.Size(), mem_shapey);
+        FlatMatrix<SIMD<double>> simd_dshapey(order+1, iry.Size(), &mem_shapey[(order+1)*iry.Size()]);
+        CalcTPFactors (irx, iry, simd_shapex, simd_dshapex, simd_shapey, simd_dshapey);
+
+        SliceMatrix<double> shapex(order+1, nipx, SIMD<double>::Size()*irx.Size(), &simd_shapex(0,0)[0]);
+        SliceMatrix<double> dshapex(order+1, nipx, SIMD<double>::Size()*irx.Size(), &simd_dshapex(0,0)[0]);
+        SliceMatrix<double> shapey(order+1, nipy, SIMD<double>::Size()*iry.Size(), &simd_shapey(0,0)[0]);
+        SliceMatrix<double> dshapey(order+1, nipy, SIMD<double>::Size()*iry.Size(), &simd_dshapey(0,0)[0]);
+
+        values.Col(ir.Size()-1).Range(0,2) = SIMD<double>(0);        
+        FlatMatrix<> grad_x(nipx, nipy, &values(0,0)[0]);
+        FlatMatrix<> grad_y(nipx, nipy, &values(1,0)[0]);
+        
+        STACK_ARRAY(double, mem_tmp, (order+1)*nipx);
+        FlatMatrix<> tmp(order+1, nipx, mem_tmp);
+
+        {
+          ThreadRegionTimer regmult(tmult, TaskManager::GetThreadId());
+          NgProfiler::AddThreadFlops (tmult, TaskManager::GetThreadId(), 2*nipx*(order+1)*((order+1)+nipy));
+          
+          tmp = Trans(cx) * dshapex;
+          grad_x = Trans(tmp) * shapey;
+          tmp = Trans(cx) * shapex;
+          grad_y = Trans(tmp) * dshapey;
+        }
+        
+        mir.TransformGradient (values);
+        return;
+      }
+
+    TBASE::EvaluateGrad (mir, bcoefs, values);
+  }
+
+
+  void L2HighOrderFETP<ET_QUAD> ::
+  AddGradTrans (const SIMD_BaseMappedIntegrationRule & mir,
+                BareSliceMatrix<SIMD<double>> values,
+                BareSliceVector<> bcoefs) const
+  {
+    static Timer t("quad AddGradTrans");
+    static Timer tmult("quad AddGradTrans mult");
+    ThreadRegionTimer reg(t, TaskManager::GetThreadId());
+
+    auto & ir = mir.IR();
+    if (ir.IsTP() && mir.DimSpace() == 2)
+      {
+        mir.TransformGradientTrans (values);
+        
+        double facx[] = { -1, 1, 1, -1 };
+        INT<4> f = GetFaceSort (0, vnums);
+        bool flip = (facx[f[0]] == facx[f[1]]);
+        
+        auto & irx = ir.GetIRX();
+        auto & iry = ir.GetIRY();
+        size_t nipx = irx.GetNIP();
+        size_t nipy = iry.GetNIP();
+
+        STACK_ARRAY(SIMD<double>, mem_shapex, 2*(order+1)*irx.Size());
+        FlatMatrix<SIMD<double>> simd_shapex(order+1, irx.Size(), mem_shapex);
+        FlatMatrix<SIMD<double>> simd_dshapex(order+1, irx.Size(), &mem_shapex[(order+1)*irx.Size()]);
+        STACK_ARRAY(SIMD<double>, mem_shapey, 2*(order+1)*iry.Size());
+        FlatMatrix<SIMD<double>> simd_shapey(order+1, iry.Size(), mem_shapey);
+        FlatMatrix<SIMD<double>> simd_dshapey(order+1, iry.Size(), &mem_shapey[(order+1)*iry.Size()]);
+        CalcTPFactors (irx, iry, simd_shapex, simd_dshapex, simd_shapey, simd_dshapey);
+
+        SliceMatrix<double> shapex(order+1, nipx, SIMD<double>::Size()*irx.Size(), &simd_shapex(0,0)[0]);
+        SliceMatrix<double> dshapex(order+1, nipx, SIMD<double>::Size()*irx.Size(), &simd_dshapex(0,0)[0]);
+        SliceMatrix<double> shapey(order+1, nipy, SIMD<double>::Size()*iry.Size(), &simd_shapey(0,0)[0]);
+        SliceMatrix<double> dshapey(order+1, nipy, SIMD<double>::Size()*iry.Size(), &simd_dshapey(0,0)[0]);
+
+        FlatMatrix<> grad_x(nipx, nipy, &values(0,0)[0]);
+        FlatMatrix<> grad_y(nipx, nipy, &values(1,0)[0]);
+
+        STACK_ARRAY(double, mem_tmp, (order+1)*nipx);
+        FlatMatrix<> tmp(order+1, nipx, mem_tmp);
+        // result ordered as (x-polynomial, y-polynomial)
+        STACK_ARRAY(double, mem_sum, sqr(order+1));
+        FlatMatrix<> sum(order+1, order+1, mem_sum);
+        
+        {
+          ThreadRegionTimer regmult(tmult, TaskManager::GetThreadId());
+          NgProfiler::AddThreadFlops (tmult, TaskManager::GetThreadId(), 2*nipx*(order+1)*((order+1)+nipy));
+
+          tmp = shapey * Trans(grad_x);
+          sum = dshapex * Trans(tmp);
+          tmp = dshapey * Trans(grad_y);
+          sum += shapex * Trans(tmp);
+        }
+
+        STACK_ARRAY(double, mem_coefs, sqr(order+1));
+        FlatMatrix<> mat_coefs(order+1, order+1, mem_coefs);
+        if (flip)
+          mat_coefs = Trans(sum);
+        else
+          mat_coefs = sum;
+        bcoefs.Range(0,ndof) += mat_coefs.AsVector();
+        return;
+      }
+
+    TBASE::AddGradTrans (mir, values, bcoefs);
+  }
   
   
   // template class L2HighOrderFETP<ET_QUAD>;
@@ -538,6 +715,139 @@ namespace ngfem
   }
 
 
+  void L2HighOrderFETP<ET_HEX> ::  
+  EvaluateGrad (const SIMD_BaseMappedIntegrationRule & mir,
+                BareSliceVector<> bcoefs,
+                BareSliceMatrix<SIMD<double>> values) const
+  {
+    static Timer t("hex EvaluateGrad");
+    static Timer tmult("hex EvaluateGrad mult");
+    ThreadRegionTimer reg(t, TaskManager::GetThreadId());
+    auto & ir = mir.IR();
+    if (ir.IsTP())
+      {
+        auto & irx = ir.GetIRX();
+        auto & iry = ir.GetIRY();
+        auto & irz = ir.GetIRZ();
+        size_t nipx = irx.GetNIP();
+        size_t nipy = iry.GetNIP();
+        size_t nipz = irz.GetNIP();
+        size_t ndof = (order+1)*(order+1)*(order+1);
+        bool needs_copy = bcoefs.Dist() != 1;
+        STACK_ARRAY(double, mem_coefs, needs_copy ? ndof : 0);
+        if (needs_copy)
+          {
+            FlatVector<> coefs(ndof, mem_coefs);
+            coefs = bcoefs;
+          }
+        FlatMatrix<> mat_coefs(sqr(order+1), order+1, needs_copy ? mem_coefs : &bcoefs(0));
+
+        STACK_ARRAY(SIMD<double>, mem_shapex, (order+1)*irx.Size());
+        FlatMatrix<SIMD<double>> simd_shapex(order+1, irx.Size(), mem_shapex);
+        SliceMatrix<double> shapex(order+1, nipx, SIMD<double>::Size()*irx.Size(), &mem_shapex[0][0]);
+        STACK_ARRAY(SIMD<double>, mem_dshapex, (order+1)*irx.Size());
+        FlatMatrix<SIMD<double>> simd_dshapex(order+1, irx.Size(), mem_dshapex);
+        SliceMatrix<double> dshapex(order+1, nipx, SIMD<double>::Size()*irx.Size(), &mem_dshapex[0][0]);
+        
+        for (size_t i = 0; i < irx.Size(); i++)
+          {
+            AutoDiff<1,SIMD<double>> adx(irx[i](0), 0);
+            LegendrePolynomial (order, (2*adx-1),
+                                SBLambda([&] (size_t nr, auto val)
+                                         {
+                                           simd_shapex(nr, i) = val.Value();
+                                           simd_dshapex(nr, i) = val.DValue(0);
+                                         }));
+          }
+
+        STACK_ARRAY(SIMD<double>, mem_shapey, (order+1)*iry.Size());
+        FlatMatrix<SIMD<double>> simd_shapey(order+1, iry.Size(), mem_shapey);
+        SliceMatrix<double> shapey(order+1, nipy, SIMD<double>::Size()*iry.Size(), &mem_shapey[0][0]);
+        STACK_ARRAY(SIMD<double>, mem_dshapey, (order+1)*iry.Size());
+        FlatMatrix<SIMD<double>> simd_dshapey(order+1, iry.Size(), mem_dshapey);
+        SliceMatrix<double> dshapey(order+1, nipy, SIMD<double>::Size()*iry.Size(), &mem_dshapey[0][0]);
+        
+        for (size_t i = 0; i < iry.Size(); i++)
+          {
+            AutoDiff<1,SIMD<double>> ady(iry[i](0), 0);
+            LegendrePolynomial (order, (2*ady-1),
+                                SBLambda([&] (size_t nr, auto val)
+                                         {
+                                           simd_shapey(nr, i) = val.Value();
+                                           simd_dshapey(nr, i) = val.DValue(0);
+                                         }));
+          }
+
+        STACK_ARRAY(SIMD<double>, mem_shapez, (order+1)*irz.Size());
+        FlatMatrix<SIMD<double>> simd_shapez(order+1, irz.Size(), mem_shapez);
+        SliceMatrix<double> shapez(order+1, nipz, SIMD<double>::Size()*irz.Size(), &mem_shapez[0][0]);
+        STACK_ARRAY(SIMD<double>, mem_dshapez, (order+1)*irz.Size());
+        FlatMatrix<SIMD<double>> simd_dshapez(order+1, irz.Size(), mem_dshapez);
+        SliceMatrix<double> dshapez(order+1, nipz, SIMD<double>::Size()*irz.Size(), &mem_dshapez[0][0]);
+        
+        for (size_t i = 0; i < irz.Size(); i++)
+          {
+            AutoDiff<1,SIMD<double>> adz(irz[i](0), 0);
+            LegendrePolynomial (order, (2*adz-1),
+                                SBLambda([&] (size_t nr, auto val)
+                                         {
+                                           simd_shapez(nr, i) = val.Value();
+                                           simd_dshapez(nr, i) = val.DValue(0);
+                                         }));
+          }
+
+        values.Col(ir.Size()-1).Range(0,3) = SIMD<double>(0);
+        
+        NgProfiler::AddThreadFlops (tmult, TaskManager::GetThreadId(),
+                                    3*(nipx*nipy*nipz*(order+1) + nipy*nipz*sqr(order+1) + nipz*ndof));
+        ThreadRegionTimer regmult(tmult, TaskManager::GetThreadId());
+        
+        for (size_t j = 0; j < 3; j++)
+          {
+            STACK_ARRAY(double, memtshapez, nipz*(order+1));
+            FlatMatrix<> tshapez(nipz, order+1, memtshapez);
+            STACK_ARRAY(double, memtshapey, nipy*(order+1));
+            FlatMatrix<> tshapey(nipy, order+1, memtshapey);
+            STACK_ARRAY(double, memtshapex, nipx*(order+1));
+            FlatMatrix<> tshapex(nipx, order+1, memtshapex);
+
+            if (j == 2)
+              tshapez = Trans(dshapez);
+            else
+              tshapez = Trans(shapez);
+
+            if (j == 1)
+              tshapey = Trans(dshapey);
+            else
+              tshapey = Trans(shapey);
+
+            if (j == 0)
+              tshapex = Trans(dshapex);
+            else
+              tshapex = Trans(shapex);
+
+            STACK_ARRAY(double, mem1, nipz*sqr(order+1));
+            FlatMatrix<> temp1(nipz, sqr(order+1), mem1);
+            temp1 = tshapez*Trans(mat_coefs);
+
+            FlatMatrix<> temp1reshape(nipz*(order+1), order+1, &temp1(0,0));
+            STACK_ARRAY(double, mem2, nipy*nipz*(order+1));
+            FlatMatrix<> temp2(nipy, nipz*(order+1), mem2);
+            temp2 = tshapey*Trans(temp1reshape);
+        
+            FlatMatrix<> temp2reshape(nipz*nipy, order+1, &temp2(0,0));
+            FlatMatrix<> temp3(nipx, nipz*nipy, &values(j,0)[0]);
+            temp3 = tshapex*Trans(temp2reshape);
+          }
+        
+        mir.TransformGradient (values);
+        return;
+      }
+    
+    TBASE::EvaluateGrad(mir, bcoefs, values);
+  }
+
+  
   void L2HighOrderFETP<ET_HEX> ::  
   AddGradTrans (const SIMD_BaseMappedIntegrationRule & mir,
                 BareSliceMatrix<SIMD<double>> values,
@@ -1107,6 +1107,21 @@ namespace ngfem
     virtual void AddTrans (const SIMD_IntegrationRule & ir,
                            BareVector<SIMD<double>> values,
                            BareSliceVector<> coefs) const override;    
+
+    using TBASE::EvaluateGrad;
+    virtual void EvaluateGrad (const SIMD_BaseMappedIntegrationRule & mir,
+                               BareSliceVector<> bcoefs,
+                               BareSliceMatrix<SIMD<double>> values) const override;
+
+    using TBASE::AddGradTrans;
+    virtual void AddGradTrans (const SIMD_BaseMappedIntegrationRule & mir,
+                               BareSliceMatrix<SIMD<double>> values,
+                               BareSliceVector<> bcoefs) const override;
+  private:
+    // 1d Legendre factors (and derivatives) in the oriented x/y directions
+    void CalcTPFactors (const SIMD_IntegrationRule & irx, const SIMD_IntegrationRule & iry,
+                        FlatMatrix<SIMD<double>> shapex, FlatMatrix<SIMD<double>> dshapex,
+                        FlatMatrix<SIMD<double>> shapey, FlatMatrix<SIMD<double>> dshapey) const;
   };
   
 
@@ -1137,6 +1152,12 @@ namespace ngfem
                            BareVector<SIMD<double>> values,
                            BareSliceVector<> coefs) const override;
 
+    using TBASE::EvaluateGrad;
+    virtual void EvaluateGrad (const SIMD_BaseMappedIntegrationRule & mir,
+                               BareSliceVector<> bcoefs,
+                               BareSliceMatrix<SIMD<double>> values) const override;
+
+    using TBASE::AddGradTrans;
     virtual void AddGradTrans (const SIMD_BaseMappedIntegrationRule & mir,
                                BareSliceMatrix<SIMD<double>> values,
                                BareSliceVector<> bcoefs) const override;
@@ -1072,63 +1072,79 @@ wait : bool
            py::array np_array;
            if (!self->IsComplex())
              {
-               Array<double> vals(npoints * self->Dimension());
+               size_t dim = self->Dimension();
+               Array<double> vals(npoints * dim);
                constexpr size_t maxp = 16;
                ParallelForRange(Range(npoints), [&](IntRange r)
                            {
                              LocalHeapMem<50000> lh("CF evaluate");
-                             Matrix<SIMD<double>> simdvals(self->Dimension(), maxp / SIMD<double>::Size());
+                             Matrix<SIMD<double>> simdvals(dim, maxp / SIMD<double>::Size());
+                             Matrix<> tmpvals(maxp, dim);
                              IntegrationRule ir;
 
+                             // points of the same element are evaluated together,
+                             // even if they are not consecutive in the input
+                             Array<size_t> order;
+                             for (auto i : r)
+                               if (pts(i).nr >= 0)
+                                 order.Append(i);
+                               else
+                                 vals.Range(i*dim, (i+1)*dim) = 0.0;
+                             auto key = [&](size_t i) { return std::make_tuple(pts(i).mesh, pts(i).vb, pts(i).nr); };
+                             QuickSort (order, [&](size_t i, size_t j) { return key(i) < key(j); });
+
+                             // collects up to maxp points of one element, starting at order[k]
+                             auto next_batch = [&](size_t k)
+                               {
+                                 ir.SetSize(0);
+                                 size_t first = k;
+                                 auto & mp = pts(order[k]);
+                                 while (k < order.Size() && k < first+maxp && key(order[k]) == key(order[first]))
+                                   {
+                                     auto & p = pts(order[k]);
+                                     ir.Append(IntegrationPoint(p.x, p.y, p.z));
+                                     k++;
+                                   }
+                                 return std::make_tuple(ElementId(mp.vb, mp.nr), mp.mesh, k);
+                               };
+                             auto scatter = [&](size_t first, FlatMatrix<> res)
+                               {
+                                 for (size_t j : Range(res.Height()))
+                                   for (size_t l : Range(dim))
+                                     vals[order[first+j]*dim+l] = res(j,l);
+                               };
+
                              try
                                {
-                                 for (auto i = r.begin(); i < r.end(); )
+                                 for (size_t k = 0; k < order.Size(); )
                                    {
                                      HeapReset hr(lh);
-                                     auto& mp = pts(i);
-                                     auto ei = ElementId(mp.vb, mp.nr);
-                                     auto& trafo = mp.mesh->GetTrafo(ei, lh);
-                                     ir.SetSize(0);
-                                     
-                                     auto first = i;
-                                     ir.Append (IntegrationPoint(mp.x, mp.y, mp.z));
-                                     i++;
-                                     while (i < r.end() && ElementId(pts(i).vb, pts(i).nr) == ei && i < first+maxp)
-                                       {
-                                         ir.Append(IntegrationPoint(pts(i).x, pts(i).y, pts(i).z));
-                                         i++;
-                                       }
+                                     auto [ei, mesh, next] = next_batch(k);
+                                     auto& trafo = mesh->GetTrafo(ei, lh);
                                      SIMD_IntegrationRule simd_ir(ir, lh);
                                      auto& mir = trafo(simd_ir, lh);                                 
                                      self->Evaluate(mir, simdvals.Cols(0, simd_ir.Size()));
                                      
-                                     FlatMatrix<double> fm(ir.Size(), self->Dimension(), &vals[first*self->Dimension()]);
-                                     SliceMatrix<> simdfm(self->Dimension(), ir.Size(), simdvals.Width()*SIMD<double>::Size(),
+                                     FlatMatrix<double> fm = tmpvals.Rows(0, ir.Size());
+                                     SliceMatrix<> simdfm(dim, ir.Size(), simdvals.Width()*SIMD<double>::Size(),
                                                           &simdvals(0,0)[0]);
                                      fm = Trans(simdfm);
+                                     scatter(k, fm);
+                                     k = next;
                                    }
                                }
                              catch (ExceptionNOSIMD e)
                                {
-                                 for (auto i = r.begin(); i < r.end(); )
+                                 for (size_t k = 0; k < order.Size(); )
                                    {
                                      HeapReset hr(lh);
-                                     auto& mp = pts(i);
-                                     auto ei = ElementId(mp.vb, mp.nr);
-                                     auto& trafo = mp.mesh->GetTrafo(ei, lh);
-                                     ir.SetSize(0);
-                                     
-                                     auto first = i;
-                                     ir.Append (IntegrationPoint(mp.x, mp.y, mp.z));
-                                     i++;
-                                     while (i < r.end() && ElementId(pts(i).vb, pts(i).nr) == ei && i < first+maxp)
-                                       {
-                                         ir.Append(IntegrationPoint(pts(i).x, pts(i).y, pts(i).z));
-                                         i++;
-                                       }
+                                     auto [ei, mesh, next] = next_batch(k);
+                                     auto& trafo = mesh->GetTrafo(ei, lh);
                                      auto& mir = trafo(ir, lh);
-                                     FlatMatrix<double> fm(ir.Size(), self->Dimension(), &vals[first*self->Dimension()]);
+                                     FlatMatrix<double> fm = tmpvals.Rows(0, ir.Size());
                                      self->Evaluate(mir, fm);
+                                     scatter(k, fm);
+                                     k = next;
                                    }
                                }
                            });
@@ -1141,6 +1157,11 @@ wait : bool
                            {
                              LocalHeapMem<1000> lh("CF evaluate");
                              auto& mp = pts(i);
+                             if (mp.nr < 0)
+                               {
+                                 vals.Range(i*self->Dimension(), (i+1)*self->Dimension()) = 0.0;
+                                 return;
+                               }
                              auto& trafo = mp.mesh->GetTrafo(ElementId(mp.vb, mp.nr), lh);
                              auto& mip = trafo(IntegrationPoint(mp.x,mp.y,mp.z),lh);
                              FlatVector<Complex> fv(self->Dimension(), &vals[i*self->Dimension()]);
@@ -1264,6 +1285,19 @@ void NGS_DLL_HEADER ExportNgfem(py::module &m) {
     .export_values()
     ;
 
+  py::enum_<INTRULE_TYPE>(m, "IntegrationRuleType", "Families of integration rules for triangles and tetrahedra.")
+    .value("DEFAULT", IRT_DEFAULT)
+    .value("STANDARD", IRT_STANDARD)
+    .value("SYMMETRIC", IRT_SYMMETRIC)
+    ;
+
+  m.def("SetIntegrationRuleType", &SetIntegrationRuleType, py::arg("type"),
+        "Set the global family of trig/tet integration rules (STANDARD or SYMMETRIC)");
+  m.def("GetIntegrationRuleType", &GetIntegrationRuleType,
+        "Returns the global family of trig/tet integration rules");
+  m.def("MaxSymmetricIntegrationOrder", &MaxSymmetricIntegrationOrder, py::arg("et"),
+        "Highest order of tabulated symmetric integration rules for element type");
+
   py::enum_<NODE_TYPE>(m, "NODE_TYPE", "Enumeration of all supported node types.")
     .value("VERTEX", NT_VERTEX)
     .value("EDGE", NT_EDGE)
@@ -1564,6 +1598,9 @@ element type : ngsolve.fem.ET
 order : int
   input order of integration rule
 
+type : ngsolve.fem.IntegrationRuleType
+  family of rules for trigs and tets, DEFAULT uses the global setting
+
 
 2)
 
@@ -1577,9 +1614,13 @@ weights : list
 
 )raw_string"))
     .def(py::init
-         ([](ELEMENT_TYPE et, int order)
-          { return new IntegrationRule (et, order); }),
-         py::arg("element type"), py::arg("order"))
+         ([](ELEMENT_TYPE et, int order, INTRULE_TYPE type)
+          {
+            auto ir = new IntegrationRule (SelectIntegrationRule (et, order, type));
+            ir->SetDim (ElementTopology::GetSpaceDim(et));
+            return ir;
+          }),
+         py::arg("element type"), py::arg("order"), py::arg("type")=IRT_DEFAULT)
     
     .def(py::init
          ([](py::list points, py::list weights)
@@ -1951,6 +1992,14 @@ bitarray : ngsolve.ngstd.BitArray
   input bitarray
 
 )raw_string") )
+    .def_property_readonly("heap_highwater", [](shared_ptr<BFI> self) { return self->GetHeapHighWater(); },
+                           "maximal LocalHeap memory in bytes used for one element")
+    .def("ResetHeapHighWater", [](shared_ptr<BFI> self) { self->ResetHeapHighWater(); })
+    .def("SetIntegrationRuleType", [] (shared_ptr<BFI> self, INTRULE_TYPE type)
+         {
+           self -> SetIntegrationRuleType(type);
+           return self;
+         }, py::arg("type"), "Set family of trig/tet integration rules used by this integrator")
     .def("SetIntegrationRule", [] (shared_ptr<BFI> self, ELEMENT_TYPE et, IntegrationRule ir)
          {
            self -> SetIntegrationRule(et,ir);
@@ -2146,6 +2195,14 @@ ba : ngsolve.ngstd.BitArray
   input bit array ( 1-> defined on, 0 -> not defoned on)
 
 )raw_string"))
+    .def_property_readonly("heap_highwater", [](shared_ptr<LFI> self) { return self->GetHeapHighWater(); },
+                           "maximal LocalHeap memory in bytes used for one element")
+    .def("ResetHeapHighWater", [](shared_ptr<LFI> self) { self->ResetHeapHighWater(); })
+    .def("SetIntegrationRuleType", [](shared_ptr<LFI> self, INTRULE_TYPE type)
+         {
+           self->SetIntegrationRuleType(type);
+           return self;
+         }, py::arg("type"), "Set family of trig/tet integration rules used by this integrator")
     .def("SetIntegrationRule", [](shared_ptr<LFI> self, ELEMENT_TYPE et, IntegrationRule ir)
          {
            self->SetIntegrationRule(et,ir);
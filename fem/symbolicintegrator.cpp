@@ -824,6 +824,7 @@ namespace ngfem
     // static Timer t("symbolicLFI - CalcElementVector", 2); RegionTimer reg(t);
     
     HeapReset hr(lh);
+    HeapUsageRecorder record(*this, lh);
     IntegrationRule ir(trafo.GetElementType(), 2*fel.Order());
     BaseMappedIntegrationRule & mir = trafo(ir, lh);
     
@@ -871,6 +872,8 @@ namespace ngfem
                        FlatVector<SCAL> elvec,
                        LocalHeap & lh) const
   {
+    void * heapstart = lh.GetPointer();
+    HeapUsageRecorder record(*this, lh);
     if (element_vb != VOL)
       { // not yet simded
         elvec = 0;
@@ -912,6 +915,7 @@ namespace ngfem
                   proxyvalues.Row(i) *= ir_facet[i].Weight() * mir[i].GetMeasure();
                 
                 proxy->Evaluator()->ApplyTrans(fel, mir, proxyvalues, elvec1, lh);
+                record.Record();
                 elvec += elvec1;
               }
           }
@@ -929,7 +933,8 @@ namespace ngfem
             HeapReset hr(lh);
             // NgProfiler::StartThreadTimer(telvec_mapping, tid);
             const SIMD_IntegrationRule& ir = GetSIMDIntegrationRule(trafo.GetElementType(), 2*fel.Order()+bonus_intorder);
-            auto & mir = trafo(ir, lh);
+            auto pooled_mir = trafo.GetPooledMIR(ir, lh);
+            auto & mir = *pooled_mir;
             // NgProfiler::StopThreadTimer(telvec_mapping, tid);
             
             // NgProfiler::StartThreadTimer(telvec_zero, tid);            
@@ -951,6 +956,7 @@ namespace ngfem
                     for (size_t i = 0; i < mir.Size(); i++)
                       proxyvalues(k,i) *= mir[i].GetWeight();
                   }
+                RecordHeapUsage (heapstart, lh);
                 // NgProfiler::StopThreadTimer(telvec_dvec, tid);
                 
                 // NgProfiler::StartThreadTimer(telvec_applytrans, tid);                                
@@ -1208,7 +1214,7 @@ namespace ngfem
     auto et = fel.ElementType();
     if (et == ET_TRIG || et == ET_TET)
       intorder -= test_difforder+trial_difforder;
-    return SelectIntegrationRule (et, intorder);
+    return SelectIntegrationRule (et, intorder, intrule_type);
   }
 
   const SIMD_IntegrationRule& SymbolicBilinearFormIntegrator ::
@@ -1234,7 +1240,184 @@ namespace ngfem
     auto et = fel.ElementType();
     if (et == ET_TRIG || et == ET_TET)
       intorder -= test_difforder+trial_difforder;
-    return SIMD_SelectIntegrationRule (et, intorder);
+    return SIMD_SelectIntegrationRule (et, intorder, intrule_type);
+  }
+
+
+
+  // stacked operator matrix, row i*dim+cum[nr]+k is component k of proxy nr in point i
+  static void CalcStackedOperator (FlatArray<ProxyFunction*> proxies, FlatArray<int> cum,
+                                   const FiniteElement & fel,
+                                   const BaseMappedIntegrationRule & mir,
+                                   FlatMatrix<double> bmat, LocalHeap & lh)
+  {
+    size_t dim = cum.Last();
+    bmat = 0.0;
+    for (size_t nr : Range(proxies))
+      {
+        HeapReset hr(lh);
+        size_t dimp = proxies[nr]->Dimension();
+        FlatMatrix<double> hbmat(fel.GetNDof(), mir.Size()*dimp, lh);
+        hbmat = 0.0;
+        proxies[nr]->Evaluator()->CalcMatrix(fel, mir, Trans(hbmat), lh);
+        for (size_t i = 0; i < mir.Size(); i++)
+          for (size_t k = 0; k < dimp; k++)
+            bmat.Row(i*dim+cum[nr]+k) = hbmat.Col(i*dimp+k);
+      }
+  }
+
+  template <typename FUNC>
+  static void OnReferenceElement (ELEMENT_TYPE et, FUNC func)
+  {
+    switch (Dim(et))
+      {
+      case 1: { FE_ElementTransformation<1,1> trafo(et); func(trafo); break; }
+      case 2: { FE_ElementTransformation<2,2> trafo(et); func(trafo); break; }
+      case 3: { FE_ElementTransformation<3,3> trafo(et); func(trafo); break; }
+      default:
+        throw Exception ("OnReferenceElement: illegal element type "+ToString(et));
+      }
+  }
+  
+  bool SymbolicBilinearFormIntegrator :: SupportsAffineFactorization () const
+  {
+    return vb == VOL && element_vb == VOL && elementwise_constant && !has_interpolate &&
+      gridfunction_cfs.Size() == 0 && trial_proxies.Size() && test_proxies.Size();
+  }
+
+  void SymbolicBilinearFormIntegrator ::
+  CalcReferenceOperators (const FiniteElement & fel,
+                          FlatMatrix<double> bmatx, FlatMatrix<double> bmaty,
+                          LocalHeap & lh) const
+  {
+    bool is_mixedfe = typeid(fel) == typeid(const MixedFiniteElement&);
+    const MixedFiniteElement * mixedfe = static_cast<const MixedFiniteElement*> (&fel);
+    const FiniteElement & fel_trial = is_mixedfe ? mixedfe->FETrial() : fel;
+    const FiniteElement & fel_test = is_mixedfe ? mixedfe->FETest() : fel;
+
+    const IntegrationRule & ir = GetIntegrationRule (fel, lh);
+    OnReferenceElement
+      (fel.ElementType(), [&] (const ElementTransformation & reftrafo)
+       {
+         BaseMappedIntegrationRule & mir = reftrafo(ir, lh);
+         CalcStackedOperator (trial_proxies, trial_cum, fel_trial, mir, bmatx, lh);
+         CalcStackedOperator (test_proxies, test_cum, fel_test, mir, bmaty, lh);
+       });
+
+    size_t dimy = test_cum.Last();
+    for (size_t i = 0; i < ir.Size(); i++)
+      bmaty.Rows(i*dimy, (i+1)*dimy) *= ir[i].Weight();
+  }
+
+  void SymbolicBilinearFormIntegrator ::
+  CalcAffineCoefficients (const FiniteElement & fel,
+                          const ElementTransformation & trafo,
+                          FlatMatrix<double> coefs,
+                          LocalHeap & lh) const
+  {
+    if (trafo.IsCurvedElement())
+      throw Exception ("SymbolicBFI::CalcAffineCoefficients: element is curved");
+    
+    bool is_mixedfe = typeid(fel) == typeid(const MixedFiniteElement&);
+    const MixedFiniteElement * mixedfe = static_cast<const MixedFiniteElement*> (&fel);
+    const FiniteElement & fel_trial = is_mixedfe ? mixedfe->FETrial() : fel;
+    const FiniteElement & fel_test = is_mixedfe ? mixedfe->FETest() : fel;
+
+    auto save_userdata = trafo.PushUserData();
+    const IntegrationRule & ir = GetIntegrationRule (fel, lh);
+    BaseMappedIntegrationRule & mir = trafo(ir, lh);
+
+    // proxy values on affine elements are linear maps of the reference values,
+    // B_phys = M B_ref, M is obtained from the normal equations over all points
+    auto calc_maps = [&] (FlatArray<ProxyFunction*> proxies, FlatArray<int> cum,
+                          const FiniteElement & fe)
+      {
+        size_t dim = cum.Last();
+        FlatMatrix<double> maps(dim, dim, lh);
+        maps = 0.0;
+        FlatMatrix<double> bphys(ir.Size()*dim, fe.GetNDof(), lh);
+        FlatMatrix<double> bref(ir.Size()*dim, fe.GetNDof(), lh);
+        CalcStackedOperator (proxies, cum, fe, mir, bphys, lh);
+        OnReferenceElement
+          (fe.ElementType(), [&] (const ElementTransformation & reftrafo)
+           {
+             CalcStackedOperator (proxies, cum, fe, reftrafo(ir, lh), bref, lh);
+           });
+
+        for (size_t nr : Range(proxies))
+          {
+            HeapReset hr(lh);
+            IntRange r(cum[nr], cum[nr+1]);
+            FlatMatrix<double> gram(r.Size(), r.Size(), lh);
+            FlatMatrix<double> mixed(r.Size(), r.Size(), lh);
+            gram = 0.0;
+            mixed = 0.0;
+            for (size_t i = 0; i < ir.Size(); i++)
+              {
+                auto brefi = bref.Rows(i*dim+r.First(), i*dim+r.Next());
+                auto bphysi = bphys.Rows(i*dim+r.First(), i*dim+r.Next());
+                gram += brefi * Trans(brefi);
+                mixed += bphysi * Trans(brefi);
+              }
+
+            // the reference values must span all components, check the pivots
+            // of a Cholesky factorization relative to the largest diagonal
+            FlatMatrix<double> chol(r.Size(), r.Size(), lh);
+            chol = gram;
+            double maxdiag = 0;
+            for (size_t j = 0; j < r.Size(); j++)
+              maxdiag = max2(maxdiag, chol(j,j));
+            for (size_t j = 0; j < r.Size(); j++)
+              {
+                if (!(chol(j,j) > 1e-12 * maxdiag))
+                  throw Exception (string("affine element matrix: Gram matrix of proxy '")
+                                   + proxies[nr]->GetDescription()
+                                   + "' is singular, its reference values do not span all components");
+                for (size_t k = j+1; k < r.Size(); k++)
+                  {
+                    double fac = chol(k,j) / chol(j,j);
+                    for (size_t l = j+1; l <= k; l++)
+                      chol(k,l) -= fac * chol(l,j);
+                  }
+              }
+            CalcInverse (gram);
+            maps.Rows(r).Cols(r) = mixed * gram;
+          }
+        return maps;
+      };
+
+    FlatMatrix<double> mapx = calc_maps (trial_proxies, trial_cum, fel_trial);
+    FlatMatrix<double> mapy = calc_maps (test_proxies, test_cum, fel_test);
+
+    ProxyUserData ud;
+    const_cast<ElementTransformation&>(trafo).userdata = &ud;
+
+    FlatMatrix<double> dmat(trial_cum.Last(), test_cum.Last(), lh);
+    FlatVector<double> val(1, lh);
+    dmat = 0.0;
+    for (size_t k1nr : Range(trial_proxies))
+      for (size_t l1nr : Range(test_proxies))
+        {
+          auto proxy1 = trial_proxies[k1nr];
+          auto proxy2 = test_proxies[l1nr];
+          int k1 = trial_cum[k1nr], l1 = test_cum[l1nr];
+          for (int k = 0; k < proxy1->Dimension(); k++)
+            for (int l = 0; l < proxy2->Dimension(); l++)
+              if (nonzeros(l1+l, k1+k))
+                {
+                  ud.trialfunction = proxy1;
+                  ud.trial_comp = k;
+                  ud.testfunction = proxy2;
+                  ud.test_comp = l;
+                  cf -> Evaluate (mir[0], val);
+                  dmat(k1+k, l1+l) = val(0);
+                }
+        }
+
+    FlatMatrix<double> hmat(trial_cum.Last(), test_cum.Last(), lh);
+    hmat = Trans(mapx) * dmat;
+    coefs = hmat * mapy;
+    coefs *= mir[0].GetMeasure();
   }
 
 
@@ -1315,6 +1498,8 @@ namespace ngfem
     // RegionTracer regtr(TaskManager::GetThreadId(), t);    
 
     auto save_userdata = trafo.PushUserData(); 
+    void * heapstart = lh.GetPointer();
+    HeapUsageRecorder record(*this, lh);
     
     if (element_vb != VOL)
       {
@@ -1347,7 +1532,8 @@ namespace ngfem
           // RegionTracer regsimd(TaskManager::GetThreadId(), tsimd);
  
           const SIMD_IntegrationRule& ir = Get_SIMD_IntegrationRule (fel, lh);
-          SIMD_BaseMappedIntegrationRule & mir = trafo(ir, lh);
+          auto pooled_mir = trafo.GetPooledMIR(ir, lh);
+          SIMD_BaseMappedIntegrationRule & mir = *pooled_mir;
 
           // NgProfiler::StopThreadTimer (timer_SymbBFIstart, TaskManager::GetThreadId());
 
@@ -1447,6 +1633,7 @@ namespace ngfem
                         if (!samediffop)
                           proxy2->Evaluator()->CalcMatrix(fel_test, mir, bbmat2);
                       }
+                      RecordHeapUsage (heapstart, lh);
 
                       if (is_diagonal)
                         {
@@ -1740,6 +1927,7 @@ namespace ngfem
                     // elmat.Rows(r2).Cols(r1) += bbmat2.Rows(r2) * Trans(bdbmat1.Rows(r1));
                     // AddABt (bbmat2.Rows(r2), bdbmat1.Rows(r1), elmat.Rows(r2).Cols(r1));
 
+                    RecordHeapUsage (heapstart, lh);
                     symmetric_so_far &= samediffop && is_diagonal;
                     if (symmetric_so_far)
                       AddABtSym (bbmat2.Rows(r2), bdbmat1.Rows(r1), part_elmat);
@@ -1850,6 +2038,98 @@ namespace ngfem
   }
 
 
+  void 
+  SymbolicBilinearFormIntegrator ::
+  CalcElementMatrixSymmetricAdd (const FiniteElement & fel,
+                                 const ElementTransformation & trafo, 
+                                 FlatSymmetricMatrix<double> elmat,
+                                 LocalHeap & lh) const
+  {
+    // the packed SIMD kernel covers proxy pairs u_i*v_i with the same diffop
+    bool packed = simd_evaluate && element_vb == VOL && !has_interpolate &&
+      typeid(fel) != typeid(const MixedFiniteElement&) &&
+      !fel.ComplexShapes() && !trafo.IsComplex() && !cf->IsComplex();
+    for (size_t tt_pair = 0; tt_pair < trial_proxies.Size()*test_proxies.Size(); tt_pair++)
+      if (nonzeros_proxies(tt_pair) && !(same_diffops(tt_pair) && diagonal_proxies(tt_pair)))
+        packed = false;
+    
+    if (!packed)
+      {
+        BilinearFormIntegrator::CalcElementMatrixSymmetricAdd (fel, trafo, elmat, lh);
+        return;
+      }
+
+    static Timer t("SymbolicBFI::CalcElementMatrixSymmetricAdd", 2);
+    ThreadRegionTimer reg(t, TaskManager::GetThreadId());
+
+    auto save_userdata = trafo.PushUserData(); 
+    void * heapstart = lh.GetPointer();
+    HeapUsageRecorder record(*this, lh);
+    
+    try
+      {
+        const SIMD_IntegrationRule& ir = Get_SIMD_IntegrationRule (fel, lh);
+        auto pooled_mir = trafo.GetPooledMIR(ir, lh);
+        SIMD_BaseMappedIntegrationRule & mir = *pooled_mir;
+
+        ProxyUserData ud;
+        const_cast<ElementTransformation&>(trafo).userdata = &ud;
+
+        for (size_t k1nr = 0; k1nr < trial_proxies.Size(); k1nr++)
+          for (size_t l1nr = 0; l1nr < test_proxies.Size(); l1nr++)
+            {
+              size_t tt_pair = l1nr*trial_proxies.Size()+k1nr;
+              if (!nonzeros_proxies(tt_pair)) continue;
+              
+              HeapReset hr(lh);
+              auto proxy1 = trial_proxies[k1nr];
+              auto proxy2 = test_proxies[l1nr];
+              size_t dim_proxy = proxy1->Dimension();
+              
+              FlatMatrix<SIMD<double>> diagproxyvalues(dim_proxy, ir.Size(), lh);
+              for (size_t k = 0; k < dim_proxy; k++)
+                {
+                  ud.trialfunction = proxy1;
+                  ud.trial_comp = k;
+                  ud.testfunction = proxy2;
+                  ud.test_comp = k;
+                  cf -> Evaluate (mir, diagproxyvalues.Rows(k,k+1));
+                }
+              for (size_t i = 0; i < ir.Size(); i++)
+                diagproxyvalues.Col(i) *= mir[i].GetWeight();
+
+              IntRange r1 = proxy1->Evaluator()->UsedDofs(fel);
+              size_t ndof = elmat.Height();
+              FlatMatrix<SIMD<double>> bbmat1(ndof*dim_proxy, ir.Size(), lh);
+              FlatMatrix<SIMD<double>> bdbmat1(ndof*dim_proxy, ir.Size(), lh);
+              FlatMatrix<SIMD<double>> hbbmat1(ndof, dim_proxy*ir.Size(), bbmat1.Data());
+              FlatMatrix<SIMD<double>> hbdbmat1(ndof, dim_proxy*ir.Size(), bdbmat1.Data());
+
+              proxy1->Evaluator()->CalcMatrix(fel, mir, bbmat1);
+              RecordHeapUsage (heapstart, lh);
+              
+              for (size_t j = 0; j < dim_proxy; j++)
+                {
+                  auto bbmat1_j = bbmat1.RowSlice(j,dim_proxy).Rows(r1);
+                  auto bdbmat1_j = bdbmat1.RowSlice(j,dim_proxy).Rows(r1);
+                  for (size_t k = 0; k < bdbmat1.Width(); k++)
+                    bdbmat1_j.Col(k).Range(0,r1.Size()) = diagproxyvalues(j,k) * bbmat1_j.Col(k);
+                }
+
+              // only the lower triangle of the diagonal block r1 x r1
+              AddABtSym (hbbmat1.Rows(r1), hbdbmat1.Rows(r1), elmat, r1.First());
+            }
+      }
+    catch (ExceptionNOSIMD e)
+      {
+        cout << IM(6) << e.What() << endl
+             << "switching to scalar evaluation" << endl;
+        simd_evaluate = false;
+        throw ExceptionNOSIMD("in CalcElementMatrixSymmetricAdd");
+      }
+  }
+
+
   
 
   template <typename SCAL, typename SCAL_SHAPES, typename SCAL_RES>
@@ -1871,6 +2151,7 @@ namespace ngfem
       // RegionTimer reg(t);
 
       // elmat = 0;
+      HeapUsageRecorder record(*this, lh);
 
       const MixedFiniteElement * mixedfe = dynamic_cast<const MixedFiniteElement*> (&fel);
       const FiniteElement & fel_trial = mixedfe ? mixedfe->FETrial() : fel;
@@ -1978,6 +2259,7 @@ namespace ngfem
                             
                             FlatMatrix<SIMD<SCAL_SHAPES>> hbbmat2(elmat.Height(), dim_proxy2*mir.Size(),
                                                                   &bbmat2(0,0));
+                            record.Record();
                             AddABt (hbbmat2.Rows(r2), hbdbmat1.Rows(r1), part_elmat);
                           }
                         else
@@ -2008,6 +2290,7 @@ namespace ngfem
                             
                             FlatMatrix<SIMD<SCAL_SHAPES>> hbbmat1(elmat.Width(), dim_proxy1*mir.Size(),
                                                                   &bbmat1(0,0));
+                            record.Record();
                             AddABt (hbdbmat2.Rows(r2), hbbmat1.Rows(r1), part_elmat);
                           }
                       }
@@ -2124,6 +2407,7 @@ namespace ngfem
                     // tdb.Stop();
                     
                     // tmult.Start();                    
+                    record.Record();
                     AddABt (part_bbmat2, part_bdbmat1, part_elmat);
                     // part_elmat += part_bbmat2 * Trans(part_bdbmat1);
                     // tmult.Stop();
@@ -2147,6 +2431,7 @@ namespace ngfem
     const FiniteElement & fel_test = mixedfe ? mixedfe->FETest() : fel;
 
     HeapReset hr(lh);
+    HeapUsageRecorder record(*this, lh);
     
     const IntegrationRule& ir = GetIntegrationRule (fel, lh);
     BaseMappedIntegrationRule & mir = trafo(ir, lh);
@@ -2191,6 +2476,7 @@ namespace ngfem
                                LocalHeap & lh) const
   {
     auto save_userdata = trafo.PushUserData();
+    HeapUsageRecorder record(*this, lh);
     
     
     /*
@@ -2438,6 +2724,7 @@ namespace ngfem
     ThreadRegionTimer reg(t, tid);
     
     elmat = 0;
+    HeapUsageRecorder record(*this, lh);
     
     const MixedFiniteElement * mixedfe = dynamic_cast<const MixedFiniteElement*> (&fel1);
     const FiniteElement & fel_trial = mixedfe ? mixedfe->FETrial() : fel1;
@@ -2657,6 +2944,7 @@ namespace ngfem
                                                         LocalHeap & lh) const
   {
     auto save_userdata = trafo.PushUserData();
+    HeapUsageRecorder record(*this, lh);
     
     if (element_vb != VOL)
       {
@@ -2794,6 +3082,7 @@ namespace ngfem
     // ThreadRegionTimer reg(t, tid);
     
     ely = 0;
+    HeapUsageRecorder record(*this, lh);
 
     auto eltype = trafo.GetElementType();
 
@@ -4186,7 +4475,7 @@ namespace ngfem
     auto et = fel.ElementType();
     if (et == ET_TRIG || et == ET_TET)
       intorder -= 2*trial_difforder;
-    return SelectIntegrationRule (et, intorder);
+    return SelectIntegrationRule (et, intorder, intrule_type);
   }
 
   const SIMD_IntegrationRule& SymbolicEnergy ::
@@ -4203,7 +4492,7 @@ namespace ngfem
     auto et = fel.ElementType();
     if (et == ET_TRIG || et == ET_TET)
       intorder -= 2*trial_difforder;
-    return SIMD_SelectIntegrationRule (et, intorder);
+    return SIMD_SelectIntegrationRule (et, intorder, intrule_type);
   }
 
   
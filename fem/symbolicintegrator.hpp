@@ -663,9 +663,26 @@ public:
     
     virtual int GetDimension() const override { return trial_proxies[0]->Evaluator()->BlockDim(); }
 
-    NGS_DLL_HEADER virtual void 
+    // factorization of element matrices on affine elements:
+    // elmat = B_y^T (I \otimes D_T) B_x with reference operators B_x, B_y
+    // and element-wise coefficient matrix D_T
+    NGS_DLL_HEADER bool SupportsAffineFactorization () const;
+    int GetAffineTrialDim () const { return trial_cum.Last(); }
+    int GetAffineTestDim () const { return test_cum.Last(); }
+    // stacked operators on the reference element, (nip*dim) x ndof
+    // integration weights are included in bmaty
+    NGS_DLL_HEADER void CalcReferenceOperators (const FiniteElement & fel,
+                                                FlatMatrix<double> bmatx, FlatMatrix<double> bmaty,
+                                                LocalHeap & lh) const;
+    // coefficient matrix D_T, trialdim x testdim
+    NGS_DLL_HEADER void CalcAffineCoefficients (const FiniteElement & fel,
+                                                const ElementTransformation & trafo,
+                                                FlatMatrix<double> coefs,
+                                                LocalHeap & lh) const;
+
+    NGS_DLL_HEADER virtual void
     CalcElementMatrix (const FiniteElement & fel,
-		       const ElementTransformation & trafo, 
+		       const ElementTransformation & trafo,
 		       FlatMatrix<double> elmat,
 		       LocalHeap & lh) const override;
 
@@ -689,6 +706,12 @@ public:
                           bool & symmetric_so_far,                          
                           LocalHeap & lh) const override;    
 
+    NGS_DLL_HEADER virtual void 
+    CalcElementMatrixSymmetricAdd (const FiniteElement & fel,
+                                   const ElementTransformation & trafo, 
+                                   FlatSymmetricMatrix<double> elmat,
+                                   LocalHeap & lh) const override;
+
     
     template <typename SCAL, typename SCAL_SHAPES, typename SCAL_RES>
     void T_CalcElementMatrixAdd (const FiniteElement & fel,
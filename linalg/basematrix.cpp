@@ -306,6 +306,7 @@ namespace ngla
       case MUMPS:           return "mumps";
       case MASTERINVERSE:   return "masterinverse";
       case UMFPACK:         return "umfpack";
+      case AGGLOMERATEDINVERSE: return "agglomeratedinverse";
       }
     return "";
   }
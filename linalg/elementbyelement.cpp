@@ -672,6 +672,89 @@ namespace ngla
   template class ElementByElementMatrix<Complex>;
 
   
+  // greedy coloring of element dof-blocks, such that blocks of the same
+  // color do not share dofs and can be scattered concurrently
+  static Table<int> ColorDofBlocks (const Table<int> & dnums, size_t ndof)
+  {
+    Array<MyMutex> locks(ndof);
+    size_t nblocks = dnums.Size();
+    Array<int> col(nblocks);
+    col = -1;
+
+    int maxcolor = 0;
+    int basecol = 0;
+    Array<unsigned int> mask(ndof);
+
+    atomic<int> found(0);
+    size_t cnt = dnums.Size();
+
+    while (found < cnt)
+      {
+        ParallelForRange
+          (mask.Size(),
+           [&] (IntRange myrange) { mask[myrange] = 0; });
+
+        ParallelForRange
+          (nblocks, [&] (IntRange myrange)
+           {
+             Array<size_t> dofs;
+             size_t myfound = 0;
+             
+             for (size_t nr : myrange)
+               {
+                 if (col[nr] >= 0) continue;
+                 
+                 unsigned check = 0;
+                 dofs = dnums[nr];
+                 
+                 QuickSort (dofs);   // sort to avoid dead-locks
+                 
+                 for (auto d : dofs) 
+                   locks[d].lock();
+                 
+                 for (auto d : dofs) 
+                   check |= mask[d];
+                 
+                 if (check != UINT_MAX) // 0xFFFFFFFF)
+                   {
+                     myfound++;
+                     unsigned checkbit = 1;
+                     int color = basecol;
+                     while (check & checkbit)
+                       {
+                         color++;
+                         checkbit *= 2;
+                       }
+                     
+                     col[nr] = color;
+                     if (color > maxcolor) maxcolor = color;
+                     
+                     for (auto d : dofs) 
+                       mask[d] |= checkbit;
+                   }
+                 
+                 for (auto d : dofs) 
+                   locks[d].unlock();
+               }
+             found += myfound;
+           });
+        
+        basecol += 8*sizeof(unsigned int); // 32;
+      }
+
+    Array<int> cntcol(maxcolor+1);
+    cntcol = 0;
+    
+    for (auto nr : Range(nblocks))
+      cntcol[col[nr]]++;
+    Table<int> coloring(cntcol);
+
+    cntcol = 0;
+    for (auto nr : Range(nblocks))        
+      coloring[col[nr]][cntcol[col[nr]]++] = nr;
+    return coloring;
+  }
+
   ConstantElementByElementMatrix ::
   ConstantElementByElementMatrix (size_t ah, size_t aw, Matrix<> amatrix,
                                   Table<int> acol_dnums, Table<int> arow_dnums)
@@ -700,172 +783,11 @@ namespace ngla
     
     // cout << "disjoint_rows = " << disjoint_rows << ", disjoint_cols = " << disjoint_cols << endl;
 
-
-
     if (!disjoint_rows)
-      {
-        Array<MyMutex> locks(w);
-        size_t nblocks = row_dnums.Size();
-        Array<int> col(nblocks);
-        col = -1;
-
-        int maxcolor = 0;
-        int basecol = 0;
-        Array<unsigned int> mask(w);
-
-        atomic<int> found(0);
-        size_t cnt = row_dnums.Size();
-
-        while (found < cnt)
-          {
-            ParallelForRange
-              (mask.Size(),
-               [&] (IntRange myrange) { mask[myrange] = 0; });
-
-            ParallelForRange
-              (nblocks, [&] (IntRange myrange)
-               {
-                 Array<size_t> dofs;
-                 size_t myfound = 0;
-                 
-                 for (size_t nr : myrange)
-                   {
-                     if (col[nr] >= 0) continue;
-                     
-                     unsigned check = 0;
-                     dofs = row_dnums[nr];
-                     
-                     QuickSort (dofs);   // sort to avoid dead-locks
-                     
-                     for (auto d : dofs) 
-                       locks[d].lock();
-                     
-                     for (auto d : dofs) 
-                       check |= mask[d];
-                     
-                     if (check != UINT_MAX) // 0xFFFFFFFF)
-                       {
-                         myfound++;
-                         unsigned checkbit = 1;
-                         int color = basecol;
-                         while (check & checkbit)
-                           {
-                             color++;
-                             checkbit *= 2;
-                           }
-                         
-                         col[nr] = color;
-                         if (color > maxcolor) maxcolor = color;
-                         
-                         for (auto d : dofs) 
-                           mask[d] |= checkbit;
-                       }
-                     
-                     for (auto d : dofs) 
-                       locks[d].unlock();
-                   }
-                 found += myfound;
-               });
-            
-            basecol += 8*sizeof(unsigned int); // 32;
-          }
-
-        Array<int> cntcol(maxcolor+1);
-        cntcol = 0;
-        
-        for (auto nr : Range(nblocks))
-          cntcol[col[nr]]++;
-        // cout << "cntcol = " << cntcol << endl;
-        row_coloring = Table<int> (cntcol);
-
-	cntcol = 0;
-        for (auto nr : Range(nblocks))        
-          row_coloring[col[nr]][cntcol[col[nr]]++] = nr;
-      }
-
-
+      row_coloring = ColorDofBlocks (row_dnums, w);
 
     if (!disjoint_cols)
-      {
-        Array<MyMutex> locks(h);
-        size_t nblocks = row_dnums.Size();
-        Array<int> col(nblocks);
-        col = -1;
-
-        int maxcolor = 0;
-        int basecol = 0;
-        Array<unsigned int> mask(h);
-
-        atomic<int> found(0);
-        size_t cnt = row_dnums.Size();
-
-        while (found < cnt)
-          {
-            ParallelForRange
-              (mask.Size(),
-               [&] (IntRange myrange) { mask[myrange] = 0; });
-
-            ParallelForRange
-              (nblocks, [&] (IntRange myrange)
-               {
-                 Array<size_t> dofs;
-                 size_t myfound = 0;
-                 
-                 for (size_t nr : myrange)
-                   {
-                     if (col[nr] >= 0) continue;
-                     
-                     unsigned check = 0;
-                     dofs = col_dnums[nr];
-                     
-                     QuickSort (dofs);   // sort to avoid dead-locks
-                     
-                     for (auto d : dofs) 
-                       locks[d].lock();
-                     
-                     for (auto d : dofs) 
-                       check |= mask[d];
-                     
-                     if (check != UINT_MAX) // 0xFFFFFFFF)
-                       {
-                         myfound++;
-                         unsigned checkbit = 1;
-                         int color = basecol;
-                         while (check & checkbit)
-                           {
-                             color++;
-                             checkbit *= 2;
-                           }
-                         
-                         col[nr] = color;
-                         if (color > maxcolor) maxcolor = color;
-                         
-                         for (auto d : dofs) 
-                           mask[d] |= checkbit;
-                       }
-                     
-                     for (auto d : dofs) 
-                       locks[d].unlock();
-                   }
-                 found += myfound;
-               });
-            
-            basecol += 8*sizeof(unsigned int); // 32;
-          }
-
-        Array<int> cntcol(maxcolor+1);
-        cntcol = 0;
-        
-        for (auto nr : Range(nblocks))
-          cntcol[col[nr]]++;
-        col_coloring = Table<int> (cntcol);
-
-	cntcol = 0;
-        for (auto nr : Range(nblocks))        
-          col_coloring[col[nr]][cntcol[col[nr]]++] = nr;
-      }
-
-    
+      col_coloring = ColorDofBlocks (col_dnums, h);
   }
 
   AutoVector ConstantElementByElementMatrix :: CreateRowVector () const
@@ -1044,4 +966,163 @@ namespace ngla
 
 
   
+  FactorizedElementByElementMatrix ::
+  FactorizedElementByElementMatrix (size_t ah, size_t aw, size_t anip,
+                                    Matrix<> abmatx, Matrix<> abmaty, Matrix<> acoefs,
+                                    Table<int> acol_dnums, Table<int> arow_dnums)
+    : h(ah), w(aw), nip(anip),
+      bmatx(move(abmatx)), bmaty(move(abmaty)), coefs(move(acoefs)),
+      col_dnums(move(acol_dnums)), row_dnums(move(arow_dnums))
+  {
+    dimx = bmatx.Height() / nip;
+    dimy = bmaty.Height() / nip;
+    if (dimx*nip != bmatx.Height() || dimy*nip != bmaty.Height())
+      throw Exception ("FactorizedElementByElementMatrix: reference operators don't fit to number of integration points");
+    if (coefs.Width() != dimx*dimy || coefs.Height() != row_dnums.Size())
+      throw Exception ("FactorizedElementByElementMatrix: coefficient matrix has wrong size");
+
+    auto disjoint = [] (const Table<int> & dnums, size_t ndof)
+      {
+        BitArray used(ndof);
+        used.Clear();
+        for (auto el : dnums)
+          for (auto d : el)
+            {
+              if (used.Test(d)) return false;
+              used.SetBit(d);
+            }
+        return true;
+      };
+
+    // disjoint blocks form a single color
+    auto single_color = [] (size_t nel)
+      {
+        Array<int> cnt(1);
+        cnt[0] = nel;
+        Table<int> coloring(cnt);
+        for (size_t i = 0; i < nel; i++)
+          coloring[0][i] = i;
+        return coloring;
+      };
+
+    size_t nel = row_dnums.Size();
+    row_coloring = disjoint(row_dnums, w) ? single_color(nel) : ColorDofBlocks (row_dnums, w);
+    col_coloring = disjoint(col_dnums, h) ? single_color(nel) : ColorDofBlocks (col_dnums, h);
+  }
+
+  AutoVector FactorizedElementByElementMatrix :: CreateRowVector () const
+  {
+    return make_unique<VVector<>> (w);
+  }
+  
+  AutoVector FactorizedElementByElementMatrix :: CreateColVector () const 
+  {
+    return make_unique<VVector<>> (h);
+  }
+
+  Array<MemoryUsage> FactorizedElementByElementMatrix :: GetMemoryUsage () const
+  {
+    return { MemoryUsage ("FactorizedEBE ref", (bmatx.Height()*bmatx.Width()+bmaty.Height()*bmaty.Width())*sizeof(double), 2),
+             MemoryUsage ("FactorizedEBE coefs", coefs.Height()*coefs.Width()*sizeof(double), 1) };
+  }
+  
+  void FactorizedElementByElementMatrix :: MultAdd (double s, const BaseVector & x, BaseVector & y) const
+  {
+    static Timer t("FactorizedEBE mult");
+    static Timer tpmult("FactorizedEBE mult parallel mult");
+    RegionTimer reg(t);
+
+    auto fx = x.FV<double>();
+    auto fy = y.FV<double>();
+
+    for (auto col : col_coloring)
+      ParallelForRange
+        (col.Size(), [&] (IntRange r)
+         {
+           constexpr size_t BS = 128;
+           Matrix<> hx(BS, bmatx.Width());
+           Matrix<> hu(BS, bmatx.Height());
+           Matrix<> hv(BS, bmaty.Height());
+           Matrix<> hy(BS, bmaty.Width());
+           
+           for (size_t bi = r.First(); bi < r.Next(); bi+= BS)
+             {
+               size_t li = min2(bi+BS, r.Next());
+               size_t num = li-bi;
+               
+               for (size_t i = 0; i < num; i++)
+                 hx.Row(i) = fx(row_dnums[col[bi+i]]);
+               
+               {
+                 NgProfiler::AddThreadFlops(tpmult, TaskManager::GetThreadId(),
+                                            num*(bmatx.Height()*bmatx.Width()+bmaty.Height()*bmaty.Width()+nip*dimx*dimy));
+                 ThreadRegionTimer reg(tpmult, TaskManager::GetThreadId());
+                 RegionTracer rt(TaskManager::GetThreadId(), tpmult);
+                 
+                 hu.Rows(0, num) = hx.Rows(0, num) * Trans(bmatx);
+                 for (size_t i = 0; i < num; i++)
+                   {
+                     FlatMatrix<> ui(nip, dimx, &hu(i,0));
+                     FlatMatrix<> vi(nip, dimy, &hv(i,0));
+                     vi = ui * FlatMatrix<> (dimx, dimy, &coefs(col[bi+i],0));
+                   }
+                 hy.Rows(0, num) = hv.Rows(0, num) * bmaty;
+               }
+               
+               for (size_t i = 0; i < num; i++)
+                 fy(col_dnums[col[bi+i]]) += s * hy.Row(i);
+             }
+         });
+  }
+  
+  void FactorizedElementByElementMatrix :: MultTransAdd (double s, const BaseVector & x, BaseVector & y) const
+  {
+    static Timer t("FactorizedEBE mult trans");
+    static Timer tpmult("FactorizedEBE mult trans mult");
+    RegionTimer reg(t);
+
+    auto fx = x.FV<double>();
+    auto fy = y.FV<double>();
+
+    for (auto col : row_coloring)
+      ParallelForRange
+        (col.Size(), [&] (IntRange r)
+         {
+           constexpr size_t BS = 128;
+           Matrix<> hx(BS, bmaty.Width());
+           Matrix<> hu(BS, bmaty.Height());
+           Matrix<> hv(BS, bmatx.Height());
+           Matrix<> hy(BS, bmatx.Width());
+           
+           for (size_t bi = r.First(); bi < r.Next(); bi+= BS)
+             {
+               size_t li = min2(bi+BS, r.Next());
+               size_t num = li-bi;
+               
+               for (size_t i = 0; i < num; i++)
+                 hx.Row(i) = fx(col_dnums[col[bi+i]]);
+               
+               {
+                 NgProfiler::AddThreadFlops(tpmult, TaskManager::GetThreadId(),
+                                            num*(bmatx.Height()*bmatx.Width()+bmaty.Height()*bmaty.Width()+nip*dimx*dimy));
+                 ThreadRegionTimer reg(tpmult, TaskManager::GetThreadId());
+                 RegionTracer rt(TaskManager::GetThreadId(), tpmult);
+                 
+                 hu.Rows(0, num) = hx.Rows(0, num) * Trans(bmaty);
+                 for (size_t i = 0; i < num; i++)
+                   {
+                     FlatMatrix<> ui(nip, dimy, &hu(i,0));
+                     FlatMatrix<> vi(nip, dimx, &hv(i,0));
+                     vi = ui * Trans(FlatMatrix<> (dimx, dimy, &coefs(col[bi+i],0)));
+                   }
+                 hy.Rows(0, num) = hv.Rows(0, num) * bmatx;
+               }
+               
+               for (size_t i = 0; i < num; i++)
+                 fy(row_dnums[col[bi+i]]) += s * hy.Row(i);
+             }
+         });
+  }
+  
+
 }
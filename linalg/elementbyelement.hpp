@@ -140,7 +140,42 @@ namespace ngla
     virtual AutoVector CreateRowVector () const override;
     virtual AutoVector CreateColVector () const override;
   };
-  
+
+
+  /*
+    Element matrices of affine elements in one class:
+      A_T = B_y^T  (I_nip \otimes D_T)  B_x
+    the reference operators B_x, B_y (integration weights included in B_y)
+    are shared by all elements, only the small coefficient matrices D_T
+    of size dimx * dimy are stored per element.
+   */
+  class NGS_DLL_HEADER FactorizedElementByElementMatrix : public BaseMatrix
+  {
+    size_t h, w;
+    size_t nip, dimx, dimy;
+    Matrix<> bmatx;   // (nip*dimx) x ndofx
+    Matrix<> bmaty;   // (nip*dimy) x ndofy
+    Matrix<> coefs;   // nel x (dimx*dimy)
+    Table<int> col_dnums;
+    Table<int> row_dnums;
+    Table<int> row_coloring, col_coloring;
+  public:
+    FactorizedElementByElementMatrix (size_t ah, size_t aw, size_t anip,
+                                      Matrix<> abmatx, Matrix<> abmaty, Matrix<> acoefs,
+                                      Table<int> acol_dnums, Table<int> arow_dnums);
+
+    virtual int VHeight() const override { return h; }
+    virtual int VWidth() const override { return w; }
+
+    virtual void MultAdd (double s, const BaseVector & x, BaseVector & y) const override;
+    virtual void MultTransAdd (double s, const BaseVector & x, BaseVector & y) const override;
+
+    virtual AutoVector CreateRowVector () const override;
+    virtual AutoVector CreateColVector () const override;
+
+    virtual Array<MemoryUsage> GetMemoryUsage () const override;
+  };
+
 }
 
 #endif
@@ -1,9 +1,17 @@
 #include <la.hpp>
+#include <parallelngs.hpp>
 using namespace ngla;
 
 
 
 namespace ngla {
+
+  // for parallel vectors, all products are reduced by one single allreduce
+  static bool IsParallel (const BaseVector & v)
+  {
+    auto pv = dynamic_cast_ParallelBaseVector (&v);
+    return pv && pv->IsParallelVector();
+  }
   
   // template <class T>
   // MultiVector<T> :: MultiVector(shared_ptr<BaseVector> v, size_t cnt)
@@ -275,6 +283,9 @@ namespace ngla {
     static Timer t("MultiVector::InnerProductD");
     RegionTimer reg(t);
 
+    if (Size() && y.Size() && (IsParallel(*vecs[0]) || IsParallel(*y[0])))
+      return BatchedInnerProducts().AddInnerProducts(*this, y).Get();
+    
     Matrix<double> res(Size(), y.Size());
     for (int i = 0; i < Size(); i++)
       for (int j = 0; j < y.Size(); j++)
@@ -288,6 +299,9 @@ namespace ngla {
     static Timer t("MultiVector::InnerProductC");
     RegionTimer reg(t);
 
+    if (Size() && y.Size() && (IsParallel(*vecs[0]) || IsParallel(*y[0])))
+      return BatchedInnerProducts().AddInnerProductsC(*this, y, conjugate).Get();
+
     Matrix<Complex> res(Size(), y.Size());
     for (int i = 0; i < Size(); i++)
       for (int j = 0; j < y.Size(); j++)
@@ -344,6 +358,18 @@ namespace ngla {
   InnerProductD (const BaseVector & y) const
   {
     Vector<double> res(Size());
+    if (IsParallel(y))
+      {
+        BatchedInnerProducts batch;
+        Array<BatchedInnerProducts::Future<double>> futures;
+        for (int i = 0; i < Size(); i++)
+          futures.Append (batch.AddInnerProduct(*vecs[i], y));
+        batch.Start();
+        for (int i = 0; i < Size(); i++)
+          res(i) = futures[i].Get();
+        return res;
+      }
+    
     for (int i = 0; i < Size(); i++)
       res(i) = vecs[i]->InnerProductD(y);
     return res;
@@ -353,6 +379,18 @@ namespace ngla {
   InnerProductC (const BaseVector & y, bool conjugate) const
   {
     Vector<Complex> res(Size());
+    if (IsParallel(y))
+      {
+        BatchedInnerProducts batch;
+        Array<BatchedInnerProducts::Future<Complex>> futures;
+        for (int i = 0; i < Size(); i++)
+          futures.Append (batch.AddInnerProductC(*vecs[i], y, conjugate));
+        batch.Start();
+        for (int i = 0; i < Size(); i++)
+          res(i) = futures[i].Get();
+        return res;
+      }
+    
     for (int i = 0; i < Size(); i++)
       res(i) = vecs[i]->InnerProductC(y, conjugate);
     return res;
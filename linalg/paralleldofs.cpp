@@ -163,6 +163,37 @@ namespace ngla
 
   }
 
+
+  ParallelDofsStatistics ParallelDofs :: GetStatistics () const
+  {
+    ParallelDofsStatistics stat;
+    stat.ndof = ndof;
+    for (size_t i = 0; i < ndof; i++)
+      {
+        if (IsMasterDof(i)) stat.nmaster++;
+        if (GetDistantProcs(i).Size()) stat.nshared++;
+      }
+    stat.nneighbors = all_dist_procs.Size();
+    size_t entrybytes = es * (complex ? sizeof(Complex) : sizeof(double));
+    for (auto p : all_dist_procs)
+      stat.cumulate_bytes += GetExchangeDofs(p).Size() * entrybytes;
+
+    size_t maxvals[] = { stat.nmaster, stat.nshared, stat.nneighbors, stat.cumulate_bytes };
+    size_t sumvals[] = { stat.nmaster, stat.nneighbors, stat.cumulate_bytes };
+    size_t maxres[4], sumres[3];
+    MPI_Allreduce (maxvals, maxres, 4, GetMPIType<size_t>(), MPI_MAX, comm);
+    MPI_Allreduce (sumvals, sumres, 3, GetMPIType<size_t>(), MPI_SUM, comm);
+    stat.min_master = comm.AllReduce (stat.nmaster, MPI_MIN);
+    stat.max_master = maxres[0];
+    stat.max_shared = maxres[1];
+    stat.max_neighbors = maxres[2];
+    stat.max_bytes = maxres[3];
+    stat.avg_master = double(sumres[0]) / comm.Size();
+    stat.total_messages = sumres[1];
+    stat.total_bytes = sumres[2];
+    return stat;
+  }
+
 }
 
 
@@ -177,6 +208,14 @@ namespace ngla
     return ismaster;
   }
   
+  ParallelDofsStatistics ParallelDofs :: GetStatistics () const
+  {
+    ParallelDofsStatistics stat;
+    stat.ndof = stat.nmaster = stat.min_master = stat.max_master = ndof;
+    stat.avg_master = ndof;
+    return stat;
+  }
+  
   void ParallelDofs ::
   EnumerateGlobally (shared_ptr<BitArray> freedofs, Array<int> & globnum, int & num_glob_dofs) const
   {
@@ -200,3 +239,19 @@ namespace ngla
   
 }
 #endif
+
+
+namespace ngla
+{
+  ostream & operator<< (ostream & ost, const ParallelDofsStatistics & stat)
+  {
+    ost << "local dofs:        " << stat.ndof << endl
+        << "master dofs:       " << stat.nmaster << ", min/avg/max " << stat.min_master << "/"
+        << stat.avg_master << "/" << stat.max_master << ", imbalance " << stat.Imbalance() << endl
+        << "shared dofs:       " << stat.nshared << ", max " << stat.max_shared << endl
+        << "neighbors:         " << stat.nneighbors << ", max " << stat.max_neighbors << endl
+        << "bytes / Cumulate:  " << stat.cumulate_bytes << ", max " << stat.max_bytes
+        << ", total " << stat.total_bytes << " in " << stat.total_messages << " messages" << endl;
+    return ost;
+  }
+}
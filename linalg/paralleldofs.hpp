@@ -12,6 +12,28 @@
 namespace ngla
 {
 
+  /// load balance and communication volume of a dof distribution
+  struct ParallelDofsStatistics
+  {
+    /// local dofs, dofs I am master of, dofs shared with other ranks
+    size_t ndof = 0, nmaster = 0, nshared = 0;
+    /// neighbor ranks, which is the number of messages sent by one Cumulate
+    size_t nneighbors = 0;
+    /// bytes sent by one Cumulate
+    size_t cumulate_bytes = 0;
+
+    /// over all ranks
+    size_t min_master = 0, max_master = 0, max_shared = 0, max_neighbors = 0;
+    size_t total_messages = 0, total_bytes = 0, max_bytes = 0;
+    double avg_master = 0;
+
+    /// maximal over average number of master dofs
+    double Imbalance () const { return (avg_master > 0) ? max_master / avg_master : 1; }
+  };
+
+  NGS_DLL_HEADER ostream & operator<< (ostream & ost, const ParallelDofsStatistics & stat);
+  
+
 #ifdef PARALLEL
 
   /**
@@ -101,6 +123,8 @@ namespace ngla
 
     void EnumerateGlobally (shared_ptr<BitArray> freedofs, Array<int> & globnum, int & num_glob_dofs) const;
 
+    /// halo sizes, neighbors and Cumulate volume, collective over comm
+    ParallelDofsStatistics GetStatistics () const;
 
     template <typename T>
     void ReduceDofData (FlatArray<T> data, MPI_Op op) const;
@@ -131,7 +155,7 @@ namespace ngla
   public:
     ParallelDofs (MPI_Comm acomm, Table<int> && adist_procs, 
 		  int dim = 1, bool iscomplex = false)
-      : es(dim), complex(iscomplex)
+      : ndof(adist_procs.Size()), es(dim), complex(iscomplex)
     { ; }
     
     int GetNDofLocal () const { return ndof; }
@@ -154,6 +178,7 @@ namespace ngla
 
     shared_ptr<BitArray> MasterDofs () const;
     void EnumerateGlobally (shared_ptr<BitArray> freedofs, Array<int> & globnum, int & num_glob_dofs) const;
+    ParallelDofsStatistics GetStatistics () const;
     
     template <typename T>
     void ReduceDofData (FlatArray<T> data, MPI_Op op) const { ; }
@@ -195,6 +195,12 @@ void NGS_DLL_HEADER ExportNgla(py::module &m) {
 	  }
 	  return new ParallelDofs(comm, ct.MoveTable());
 	}), py::arg("dist_procs"), py::arg("comm"))
+    .def("Redistribute", [](shared_ptr<ParallelDofs> self, py::list new_owner)
+         {
+           Array<int> owner = makeCArray<int> (new_owner);
+           return make_shared<DofRedistribution> (self, owner);
+         }, py::arg("new_owner"),
+         "operator moving vectors to the layout given by a new owner rank per local dof")
 #endif
     .def_property_readonly ("ndoflocal", [](const ParallelDofs & self) 
 			    { return self.GetNDofLocal(); },
@@ -217,6 +223,26 @@ void NGS_DLL_HEADER ExportNgla(py::module &m) {
         return tuple ( py::cast(globnum), py::cast(num_glob_dofs) );
       }, py::arg("freedofs")=nullptr)
     .def("MasterDofs", &ParallelDofs::MasterDofs)
+    .def("Statistics", [] (const ParallelDofs & self)
+         {
+           auto stat = self.GetStatistics();
+           py::dict res;
+           res["ndof"] = stat.ndof;
+           res["nmaster"] = stat.nmaster;
+           res["nshared"] = stat.nshared;
+           res["nneighbors"] = stat.nneighbors;
+           res["cumulate_bytes"] = stat.cumulate_bytes;
+           res["min_master"] = stat.min_master;
+           res["max_master"] = stat.max_master;
+           res["avg_master"] = stat.avg_master;
+           res["imbalance"] = stat.Imbalance();
+           res["max_shared"] = stat.max_shared;
+           res["max_neighbors"] = stat.max_neighbors;
+           res["max_bytes"] = stat.max_bytes;
+           res["total_messages"] = stat.total_messages;
+           res["total_bytes"] = stat.total_bytes;
+           return res;
+         }, "load balance, halo sizes and bytes moved by one Cumulate, collective")
     ;
 
     m.def("CreateVVector",
@@ -501,6 +527,16 @@ void NGS_DLL_HEADER ExportNgla(py::module &m) {
     .def("SetRandom", &BaseVector::SetRandom)
     .def("Distribute", [] (BaseVector & self) { self.Distribute(); } ) 
     .def("Cumulate", [] (BaseVector & self) { self.Cumulate(); } ) 
+    .def("StartCumulate", [] (BaseVector & self)
+         {
+           if (auto pv = dynamic_cast_ParallelBaseVector (&self))
+             pv->StartCumulate();
+         }, "start the exchange for Cumulate, complete with FinishCumulate")
+    .def("FinishCumulate", [] (BaseVector & self)
+         {
+           if (auto pv = dynamic_cast_ParallelBaseVector (&self))
+             pv->FinishCumulate();
+         })
     .def("GetParallelStatus", [] (BaseVector & self) { return self.GetParallelStatus(); } )
     .def("SetParallelStatus", [] (BaseVector & self, PARALLEL_STATUS stat) { self.SetParallelStatus(stat); }, py::arg("stat"));
 
@@ -673,6 +709,45 @@ void NGS_DLL_HEADER ExportNgla(py::module &m) {
     */
   
 
+  py::class_<BatchedInnerProducts::Future<double>> (m, "InnerProductFuture")
+    .def("Get", &BatchedInnerProducts::Future<double>::Get,
+         "wait for the reduction, and return the value");
+  py::class_<BatchedInnerProducts::Future<Complex>> (m, "InnerProductFutureC")
+    .def("Get", &BatchedInnerProducts::Future<Complex>::Get,
+         "wait for the reduction, and return the value");
+  py::class_<BatchedInnerProducts::MatrixFuture<double>> (m, "InnerProductsFuture")
+    .def("Get", &BatchedInnerProducts::MatrixFuture<double>::Get,
+         "wait for the reduction, and return the matrix");
+  py::class_<BatchedInnerProducts::MatrixFuture<Complex>> (m, "InnerProductsFutureC")
+    .def("Get", &BatchedInnerProducts::MatrixFuture<Complex>::Get,
+         "wait for the reduction, and return the matrix");
+
+  py::class_<BatchedInnerProducts> (m, "BatchedInnerProducts",
+                                    "a batch of inner products and norms, reduced by one single non-blocking allreduce")
+    .def(py::init<>())
+    .def("InnerProduct", [](BatchedInnerProducts & self, BaseVector & x, BaseVector & y, bool conjugate)
+         {
+           if (!x.IsComplex())
+             return py::cast(self.AddInnerProduct(x, y));
+           else
+             return py::cast(self.AddInnerProductC(x, y, conjugate));
+         }, py::arg("x"), py::arg("y"), py::arg("conjugate")=false,
+         "add the inner product of x and y, returns a future")
+    .def("InnerProduct", [](BatchedInnerProducts & self, MultiVector & x, MultiVector & y, bool conjugate)
+         {
+           if (!x.IsComplex())
+             return py::cast(self.AddInnerProducts(x, y));
+           else
+             return py::cast(self.AddInnerProductsC(x, y, conjugate));
+         }, py::arg("x"), py::arg("y"), py::arg("conjugate")=false,
+         "add the matrix of inner products of x and y, returns a future")
+    .def("Norm", &BatchedInnerProducts::AddNorm, py::arg("x"),
+         "add the l2-norm of x, returns a future")
+    .def("Start", &BatchedInnerProducts::Start,
+         "start the reduction, the futures wait for it in Get")
+    ;
+  
+
   typedef BaseMatrix BM;
   // typedef BaseVector BV;
 
@@ -866,6 +941,13 @@ void NGS_DLL_HEADER ExportNgla(py::module &m) {
                            { return self.Width(); }, "Width of the matrix" )
     .def_property_readonly("nze", [] ( BaseMatrix & self)
                            { return self.NZE(); }, "number of non-zero elements")
+    .def_property_readonly("__memory__", [] (const BaseMatrix & self)
+                           {
+                             std::vector<tuple<string,size_t, size_t>> ret;
+                             for (auto mui : self.GetMemoryUsage())
+                               ret.push_back ( make_tuple(mui.Name(), mui.NBytes(), mui.NBlocks()));
+                             return ret;
+                           }, "list of (name, bytes, blocks) of the memory used by the matrix")
     .def_property_readonly("local_mat", [](shared_ptr<BaseMatrix> & mat) { return mat; })
     // .def("CreateMatrix", &BaseMatrix::CreateMatrix)
     .def("CreateMatrix", [] ( BaseMatrix & self)
@@ -1125,8 +1207,56 @@ inverse : string
     .def_property_readonly("col_pardofs", [](ParallelMatrix & mat) { return mat.GetColParallelDofs(); })
     .def_property_readonly("local_mat", [](ParallelMatrix & mat) { return mat.GetMatrix(); })
     .def_property_readonly("op_type", [](ParallelMatrix & mat) { return mat.GetOpType(); })
+    .def("ToDistributedCSR", [](ParallelMatrix & mat) -> shared_ptr<BaseMatrix>
+         {
+           if (mat.IsComplex())
+             return make_shared<DistributedCSRMatrix<Complex>> (mat);
+           return make_shared<DistributedCSRMatrix<double>> (mat);
+         }, "row-distributed CSR matrix with global column numbers, for scalar sparse matrices")
     ;
 
+  auto ExportDistributedCSR = [&m] (auto dummy, string name)
+    {
+      typedef decltype(dummy) TSCAL;
+      typedef DistributedCSRMatrix<TSCAL> TMAT;
+      py::class_<TMAT, shared_ptr<TMAT>, BaseMatrix> (m, name.c_str(),
+                                                      "row-distributed CSR matrix in global numbering")
+        .def_property_readonly("nglobal", &TMAT::NGlobal)
+        .def_property_readonly("first_row", &TMAT::FirstRow, "global number of the first owned row")
+        .def_property_readonly("owned_dofs", [](TMAT & self)
+                               {
+                                 py::list dofs;
+                                 for (auto d : self.OwnedDofs()) dofs.append (d);
+                                 return dofs;
+                               }, "local dofs of the owned rows")
+        .def("CSR", [](shared_ptr<TMAT> self)
+             {
+               // copies, the tuple may outlive the matrix
+               auto hvals = self->Values();
+               auto hcols = self->GlobalColumns();
+               auto hrowptr = self->RowPtr();
+               Vector<TSCAL> vals(hvals.Size());
+               Array<int> cols(hcols.Size());
+               Array<size_t> rowptr(hrowptr.Size());
+               for (size_t i = 0; i < hvals.Size(); i++) vals(i) = hvals[i];
+               for (size_t i = 0; i < hcols.Size(); i++) cols[i] = hcols[i];
+               for (size_t i = 0; i < hrowptr.Size(); i++) rowptr[i] = hrowptr[i];
+               return py::make_tuple (move(vals), move(cols), move(rowptr));
+             }, "copies of the owned rows as (values, global column numbers, row pointer)")
+        .def("Ghosts", [](shared_ptr<TMAT> self)
+             {
+               auto hcols = self->GhostColumns();
+               auto howners = self->GhostOwners();
+               Array<int> cols(hcols.Size()), owners(howners.Size());
+               for (size_t i = 0; i < hcols.Size(); i++) cols[i] = hcols[i];
+               for (size_t i = 0; i < howners.Size(); i++) owners[i] = howners[i];
+               return py::make_tuple (move(cols), move(owners));
+             }, "copies of the global numbers and owner ranks of the ghost columns")
+        ;
+    };
+  ExportDistributedCSR (double(0), "DistributedCSRMatrixD");
+  ExportDistributedCSR (Complex(0), "DistributedCSRMatrixC");
+
 
   py::class_<FETI_Jump_Matrix, shared_ptr<FETI_Jump_Matrix>, BaseMatrix>
     (m, "FETI_Jump", "B-matrix of the FETI-system")
@@ -1137,7 +1267,35 @@ inverse : string
     .def_property_readonly("row_pardofs", [](FETI_Jump_Matrix & mat) { return mat.GetRowParallelDofs(); })
     .def_property_readonly("col_pardofs", [](FETI_Jump_Matrix & mat) { return mat.GetColParallelDofs(); })
     ;
+
+  py::class_<DofRedistribution, shared_ptr<DofRedistribution>, BaseMatrix>
+    (m, "DofRedistribution", "moves vectors to a new dof layout, MultTrans moves them back")
+    .def(py::init([](shared_ptr<ParallelDofs> pardofs, py::list new_owner)
+                  {
+                    Array<int> owner = makeCArray<int> (new_owner);
+                    return make_shared<DofRedistribution> (pardofs, owner);
+                  }), py::arg("pardofs"), py::arg("new_owner"))
+    .def_property_readonly("old_pardofs", [](DofRedistribution & mat) { return mat.GetOldParallelDofs(); })
+    .def_property_readonly("new_pardofs", [](DofRedistribution & mat) { return mat.GetNewParallelDofs(); })
+    ;
+
+  m.def("SetAgglomerationRanks", [](int n) { agglomeration_ranks = n; }, py::arg("n"),
+        "number of ranks factoring for inverse='agglomeratedinverse', 0 .. about sqrt(ntasks)");
+  m.def("GetAgglomerationStatistics", [] ()
+        {
+          py::dict stat;
+          stat["matrix_entries"] = agglomeration_statistics.matrix_entries;
+          stat["factor_dofs"] = agglomeration_statistics.factor_dofs;
+          stat["apply_values"] = agglomeration_statistics.apply_values;
+          return stat;
+        }, "work of this rank in the last setup and application of an 'agglomeratedinverse'");
 #endif
+
+  m.def("StartMPIProgressThread", [](int max_sleep_us) { MPIProgressThread::Start(max_sleep_us); },
+        py::arg("max_sleep_us")=50,
+        "start a thread driving non-blocking MPI communication, requires MPI_THREAD_MULTIPLE");
+  m.def("StopMPIProgressThread", [] () { MPIProgressThread::Stop(); });
+  m.def("MPIProgressThreadRunning", [] () { return MPIProgressThread::IsRunning(); });
   
 
   
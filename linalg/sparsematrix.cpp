@@ -1270,10 +1270,11 @@ namespace ngla
     else if (ainversetype == "masterinverse") SetInverseType ( MASTERINVERSE );
     else if (ainversetype == "sparsecholesky") SetInverseType ( SPARSECHOLESKY );
     else if (ainversetype == "umfpack")       SetInverseType ( UMFPACK );
+    else if (ainversetype == "agglomeratedinverse") SetInverseType ( AGGLOMERATEDINVERSE );
     else
       {
         throw Exception (ToString("undefined inverse ")+ainversetype+
-                         "\nallowed is: 'sparsecholesky', 'pardiso', 'pardisospd', 'mumps', 'masterinverse', 'umfpack'");
+                         "\nallowed is: 'sparsecholesky', 'pardiso', 'pardisospd', 'mumps', 'masterinverse', 'agglomeratedinverse', 'umfpack'");
       }
     return old_invtype;
   }
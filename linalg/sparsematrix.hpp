@@ -257,6 +257,14 @@ namespace ngla
     void SetSPD (bool aspd = true) { spd = aspd; }
     bool IsSPD () const { return spd; }
     virtual size_t NZE () const override { return nze; }
+
+    /**
+       y += s A x for the given rows only.
+       Returns false if not supported (e.g. for symmetric storage).
+     */
+    virtual bool MultAddRows (double s, const BaseVector & x, BaseVector & y,
+                              FlatArray<int> rows) const
+    { return false; }
   };
 
   /// A general, sparse matrix
@@ -358,6 +366,10 @@ namespace ngla
     virtual void AddElementMatrixSymmetric(FlatArray<int> dnums,
                                            BareSliceMatrix<TSCAL> elmat,
                                            bool use_atomic = false);
+    /// element matrix in packed lower triangular storage
+    virtual void AddElementMatrixSymmetric(FlatArray<int> dnums,
+                                           FlatSymmetricMatrix<TSCAL> elmat,
+                                           bool use_atomic = false);
     
     virtual BaseVector & AsVector() override
     {
@@ -517,6 +529,9 @@ namespace ngla
     virtual void MultAdd1 (double s, const BaseVector & x, BaseVector & y,
 			   const BitArray * ainner = NULL,
 			   const Array<int> * acluster = NULL) const override;
+
+    virtual bool MultAddRows (double s, const BaseVector & x, BaseVector & y,
+                              FlatArray<int> rows) const override;
     
     virtual void DoArchive (Archive & ar) override;
   };
@@ -673,6 +688,11 @@ namespace ngla
       MultAdd (s, x, y);
     }
 
+    /// a row of the symmetric storage is not a full row
+    virtual bool MultAddRows (double s, const BaseVector & x, BaseVector & y,
+                              FlatArray<int> rows) const override
+    { return false; }
+
 
     /*
       y += s L * x
@@ -149,8 +149,12 @@ namespace ngla
              
              auto myrange = balance[mypart].Split (num_in_part, tasks_per_part);
 
-             for (auto row : myrange) 
-               fy(row) += s * RowTimesVector (row, fx);
+             if constexpr (is_same<TM,double>::value && is_same<TVX,double>::value)
+               // kernel of the runtime selected instruction set
+               MultAddCSR (s, myrange, firsti.Data(), colnr.Addr(0), data.Addr(0), fx.Data(), fy.Data());
+             else
+               for (auto row : myrange) 
+                 fy(row) += s * RowTimesVector (row, fx);
 
            });
 	return;
@@ -161,6 +165,11 @@ namespace ngla
     FlatVector<TVY> fy = y.FV<TVY>(); 
 
     int h = this->Height();
+    if constexpr (is_same<TM,double>::value && is_same<TVX,double>::value)
+      {
+        MultAddCSR (s, IntRange(0, h), firsti.Data(), colnr.Addr(0), data.Addr(0), fx.Data(), fy.Data());
+        return;
+      }
     for (int i = 0; i < h; i++)
       fy(i) += s * RowTimesVector (i, fx);
 
@@ -190,6 +199,24 @@ namespace ngla
               fy(row) += s * RowTimesVector (row, fx);
         });
   }
+
+  template <class TM, class TV_ROW, class TV_COL>
+  bool SparseMatrix<TM,TV_ROW,TV_COL> ::
+  MultAddRows (double s, const BaseVector & x, BaseVector & y,
+               FlatArray<int> rows) const
+  {
+    static Timer t("SparseMatrix::MultAddRows"); RegionTimer reg(t);
+
+    FlatVector<TVX> fx = x.FV<TVX>(); 
+    FlatVector<TVY> fy = y.FV<TVY>(); 
+
+    ParallelForRange (rows.Size(), [&] (IntRange r)
+                      {
+                        for (auto i : r)
+                          fy(rows[i]) += s * RowTimesVector (rows[i], fx);
+                      });
+    return true;
+  }
   
   
 
@@ -697,6 +724,60 @@ namespace ngla
   }
   
   
+  template <class TM>
+  void SparseMatrixTM<TM> ::
+  AddElementMatrixSymmetric(FlatArray<int> dnums, FlatSymmetricMatrix<TSCAL> elmat1, bool use_atomic)
+  {
+    static Timer timer_addelmat("SparseMatrixSymmetric::AddElementMatrix packed");
+    ThreadRegionTimer reg (timer_addelmat, TaskManager::GetThreadId());
+    NgProfiler::AddThreadFlops (timer_addelmat, TaskManager::GetThreadId(), dnums.Size()*(dnums.Size()+1)/2);    
+
+    STACK_ARRAY(int, hmap, dnums.Size());
+    FlatArray<int> map(dnums.Size(), hmap);
+    for (int i = 0; i < dnums.Size(); i++) map[i] = i;
+    QuickSortI (dnums, map);
+
+    STACK_ARRAY(int, dnumsmap, dnums.Size());
+    for (int i = 0; i < dnums.Size(); i++)
+      dnumsmap[i] = dnums[map[i]];
+
+    // only the lower triangle is stored, after sorting the
+    // row of the element matrix can be smaller than the column
+    PackedScalar2ElemMatrix<TM, TSCAL> elmat (elmat1);
+    
+    int first_used = 0;
+    while (first_used < dnums.Size() && !IsRegularIndex(dnums[map[first_used]]) ) first_used++;
+
+    if (!use_atomic && first_used+1 < dnums.Size())
+      this->PrefetchRow(dnums[map[first_used+1]]);
+    
+    for (int i1 = first_used; i1 < dnums.Size(); i1++)
+      {
+        if (!use_atomic && i1+2 < dnums.Size())
+          this->PrefetchRow(dnums[map[i1+2]]);
+        
+        FlatArray<int> rowind = this->GetRowIndices(dnumsmap[i1]);
+        FlatVector<TM> rowvals = this->GetRowValues(dnumsmap[i1]);
+        int mi = map[i1];
+        
+        size_t k = 0;
+        for (int j1 = first_used; j1 <= i1; j1++, k++)
+          {
+            while (rowind[k] != dnumsmap[j1])
+              {
+                k++;
+                if (unlikely(k >= rowind.Size()))
+                  throw Exception ("SparseMatrixSymmetricTM::AddElementMatrix: illegal dnums");
+              }
+            if (use_atomic)
+              AtomicAdd (rowvals(k), elmat(mi, map[j1]));
+            else
+              rowvals(k) += elmat(mi, map[j1]);
+          }
+      }
+  }
+  
+  
   template <class TM, class TV>
   SparseMatrixSymmetric<TM,TV> :: 
   SparseMatrixSymmetric (const MatrixGraph & agraph, bool stealgraph)
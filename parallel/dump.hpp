@@ -115,11 +115,18 @@ namespace ngstd
     return 1;
   }
 
+  // local numbers on a non-distributed mesh
+  inline int GetGlobalVertexNum (const MeshAccess & ma, int v)
+  {
+    if (ma.GetCommunicator().Size() == 1) return v;
+    return ma.GetGlobalNodeNum (Node(NT_VERTEX, v));
+  }
+
   template <>
   inline auto GetGlobalNodeId<NT_VERTEX> (const MeshAccess & ma, int nr) 
     -> typename key_trait<NT_VERTEX>::TKEY 
   { 
-    return ma.GetGlobalNodeNum (Node(NT_VERTEX, nr));
+    return GetGlobalVertexNum (ma, nr);
   }
 
   template <>
@@ -130,8 +137,8 @@ namespace ngstd
     auto pts = ma.GetEdgePNums(nr);
     int pi1 = pts[0], pi2 = pts[1];
     
-    return INT<2> (ma.GetGlobalNodeNum (Node(NT_VERTEX, pi1)),
-		   ma.GetGlobalNodeNum (Node(NT_VERTEX, pi2)));
+    return INT<2> (GetGlobalVertexNum (ma, pi1),
+		   GetGlobalVertexNum (ma, pi2));
   }
 
   template <>
@@ -153,6 +160,8 @@ namespace ngstd
 	if(verts.Contains(p2)==0)
 	  verts.Append(p2);
       }
+    for (auto & v : verts)
+      v = GetGlobalVertexNum (ma, v);
     QuickSort(verts);
     return INT<3> (verts[0], verts[1], verts[2]);
   }
@@ -182,6 +191,8 @@ namespace ngstd
 	      verts.Append(p2);
 	  }
       }
+    for (auto & v : verts)
+      v = GetGlobalVertexNum (ma, v);
     QuickSort(verts);
     return INT<4> (verts[0], verts[1], verts[2], verts[3]);
   }
@@ -904,18 +915,16 @@ namespace ngstd
 
 
 
-  template <NODE_TYPE NT, typename T, typename TSIZEFUNC, typename TFUNC>
-  void GatherNodalData (const MeshAccess & ma, FlatArray<T> data, 
-			TSIZEFUNC sf, TFUNC f)
+  // data and global keys of the nodes I am master of
+  template <NODE_TYPE NT, typename T>
+  void GetMasterNodalData (const MeshAccess & ma, FlatArray<T> data,
+                           Array<typename key_trait<NT>::TKEY> & global_keys,
+                           Array<T> & local_data)
   {
-    typedef typename key_trait<NT>::TKEY TKEY;
-
-    Array<T> local_data;
-    Array<TKEY> global_keys;
-      
-    // gather local data where I am master
     auto comm = ma.GetCommunicator();
     int myid = comm.Rank();
+    global_keys.SetSize0();
+    local_data.SetSize0();
     for (int i = 0; i < ma.GetNNodes(NT); i++)
       {
 	bool ismaster = true;
@@ -925,24 +934,265 @@ namespace ngstd
 	if (ismaster)
 	  {
 	    local_data.Append (data[i]);
-	    TKEY key1 = GetGlobalNodeId<NT>(ma,i);
-	    global_keys.Append (key1);
+	    global_keys.Append (GetGlobalNodeId<NT>(ma,i));
 	  }
       }
-  
-    Array<int> index (local_data.Size());
+  }
+
+  template <typename TKEY, typename T>
+  void SortByKey (Array<TKEY> & keys, Array<T> & data)
+  {
+    Array<int> index (keys.Size());
     for (int k = 0; k < index.Size(); k++) index[k] = k;
 
-    MyQuickSortI (global_keys, index);
+    MyQuickSortI (keys, index);
 
-    local_data = Array<T> (local_data[index]);
-    global_keys = Array<TKEY> (global_keys[index]);
-    
+    data = Array<T> (data[index]);
+    keys = Array<TKEY> (keys[index]);
+  }
+
+
+  template <NODE_TYPE NT, typename T, typename TSIZEFUNC, typename TFUNC>
+  void GatherNodalData (const MeshAccess & ma, FlatArray<T> data, 
+			TSIZEFUNC sf, TFUNC f)
+  {
+    typedef typename key_trait<NT>::TKEY TKEY;
+
+    Array<T> local_data;
+    Array<TKEY> global_keys;
+      
+    // gather local data where I am master
+    GetMasterNodalData<NT> (ma, data, global_keys, local_data);
+    SortByKey (global_keys, local_data);
 
     streamed_key_merge_templated<T,NT> (&local_data[0], &global_keys[0], local_data.Size(), 10000, sf, f);
   }
 
 
 
+  // MPI datatype for one trivially copyable item, free with MPI_Type_free
+  template <typename T>
+  MPI_Datatype CreateItemType ()
+  {
+    MPI_Datatype type;
+    MPI_Type_contiguous (sizeof(T), MPI_BYTE, &type);
+    MPI_Type_commit (&type);
+    return type;
+  }
+
+  /*
+    all-to-all of trivially copyable items, counts are items per rank.
+    Counts and displacements are in items, if the displacements do not
+    fit into an int the exchange falls back to point-to-point messages.
+  */
+  template <typename T>
+  Array<T> ExchangeByCounts (NgMPI_Comm comm, FlatArray<T> send,
+                             FlatArray<int> send_cnt, FlatArray<int> recv_cnt)
+  {
+    int np = comm.Size();
+    Array<size_t> sdispl(np+1), rdispl(np+1);
+    sdispl[0] = rdispl[0] = 0;
+    for (int p = 0; p < np; p++)
+      {
+        sdispl[p+1] = sdispl[p] + send_cnt[p];
+        rdispl[p+1] = rdispl[p] + recv_cnt[p];
+      }
+    Array<T> recv(rdispl[np]);
+
+    MPI_Datatype type = CreateItemType<T>();
+    int small = max(sdispl[np], rdispl[np]) <= size_t(numeric_limits<int>::max());
+    MPI_Allreduce (MPI_IN_PLACE, &small, 1, MPI_INT, MPI_MIN, comm);
+    if (small)
+      {
+        Array<int> isdispl(np), irdispl(np);
+        for (int p = 0; p < np; p++)
+          {
+            isdispl[p] = sdispl[p];
+            irdispl[p] = rdispl[p];
+          }
+        MPI_Alltoallv (send.Data(), &send_cnt[0], &isdispl[0], type,
+                       recv.Data(), &recv_cnt[0], &irdispl[0], type, comm);
+      }
+    else
+      {
+        Array<MPI_Request> requests;
+        for (int p = 0; p < np; p++)
+          {
+            MPI_Request request;
+            if (recv_cnt[p])
+              {
+                MPI_Irecv (recv.Data()+rdispl[p], recv_cnt[p], type, p, MPI_TAG_SOLVE, comm, &request);
+                requests.Append (request);
+              }
+            if (send_cnt[p])
+              {
+                MPI_Isend (send.Data()+sdispl[p], send_cnt[p], type, p, MPI_TAG_SOLVE, comm, &request);
+                requests.Append (request);
+              }
+          }
+        MPI_Waitall (requests.Size(), requests.Data(), MPI_STATUSES_IGNORE);
+      }
+    MPI_Type_free (&type);
+    return recv;
+  }
+
+
+  /*
+    Distributed sample sort, the distributed-memory version of SampleSortI:
+    every rank sorts locally and contributes a regular sample of its keys,
+    the gathered samples define np-1 splitters, and one all-to-all moves
+    every item to its bucket rank. On return, keys and data are sorted
+    locally, and all keys on rank p are smaller than those on rank p+1.
+    Keys must be unique.
+  */
+  template <typename TKEY, typename T>
+  void ParallelSampleSort (NgMPI_Comm comm, Array<TKEY> & keys, Array<T> & data,
+                           int over_sample = 16)
+  {
+    static Timer t("ParallelSampleSort");
+    static Timer tsplit("ParallelSampleSort - splitters");
+    static Timer texchange("ParallelSampleSort - exchange");
+    RegionTimer reg(t);
+
+    SortByKey (keys, data);
+
+    int np = comm.Size();
+    if (np == 1) return;
+
+    tsplit.Start();
+    int nsample = min (size_t(over_sample), keys.Size());
+    Array<TKEY> sample(nsample);
+    for (int i = 0; i < nsample; i++)
+      sample[i] = keys[ (2*i+1)*keys.Size() / (2*nsample) ];
+
+    Array<int> sample_cnt(np);
+    MPI_Allgather (&nsample, 1, MPI_INT, &sample_cnt[0], 1, MPI_INT, comm);
+    Array<int> sample_displ(np);
+    int total = 0;
+    for (int p = 0; p < np; p++)
+      {
+        sample_displ[p] = total;
+        total += sample_cnt[p];
+      }
+    if (total == 0) { tsplit.Stop(); return; }
+
+    Array<TKEY> all_samples(total);
+    MPI_Datatype keytype = CreateItemType<TKEY>();
+    MPI_Allgatherv (sample.Data(), nsample, keytype,
+                    all_samples.Data(), &sample_cnt[0], &sample_displ[0], keytype, comm);
+    MPI_Type_free (&keytype);
+    Array<TKEY> dummy(total);
+    SortByKey (all_samples, dummy);
+
+    Array<TKEY> splitters(np-1);
+    for (int i = 0; i < np-1; i++)
+      splitters[i] = all_samples[ size_t(i+1)*total / np ];
+    tsplit.Stop();
+
+    // keys are sorted, buckets are contiguous
+    RegionTimer rex(texchange);
+    Array<int> send_cnt(np), recv_cnt(np);
+    send_cnt = 0;
+    int p = 0;
+    for (auto & k : keys)
+      {
+        while (p < np-1 && !(k < splitters[p])) p++;
+        send_cnt[p]++;
+      }
+    MPI_Alltoall (&send_cnt[0], 1, MPI_INT, &recv_cnt[0], 1, MPI_INT, comm);
+
+    keys = ExchangeByCounts (comm, FlatArray<TKEY>(keys), send_cnt, recv_cnt);
+    data = ExchangeByCounts (comm, FlatArray<T>(data), send_cnt, recv_cnt);
+
+    // merge the np sorted runs
+    SortByKey (keys, data);
+  }
+
+
+  /*
+    Writes nodal data sorted by global node key into one binary file.
+    After a parallel sample sort every rank writes its bucket at its
+    offset with one collective MPI-IO call, nothing passes through rank 0.
+
+    file layout: 
+      char[8] "NGSNODAL", int64 n, int32 sizeof(key), int32 sizeof(value),
+      n records of (key, value), or only the values if with_keys is false.
+
+    returns the number of records
+  */
+  template <NODE_TYPE NT, typename T>
+  size_t WriteNodalData (const MeshAccess & ma, FlatArray<T> data,
+                         const string & filename, bool with_keys = true)
+  {
+    typedef typename key_trait<NT>::TKEY TKEY;
+    static Timer t("WriteNodalData");
+    RegionTimer reg(t);
+
+    auto comm = ma.GetCommunicator();
+
+    Array<T> local_data;
+    Array<TKEY> global_keys;
+    GetMasterNodalData<NT> (ma, data, global_keys, local_data);
+    ParallelSampleSort (comm, global_keys, local_data);
+
+    int keysize = with_keys ? sizeof(TKEY) : 0;
+    int recsize = keysize + sizeof(T);
+    long long nlocal = local_data.Size(), first = 0, nglob = nlocal;
+    if (comm.Size() > 1)
+      {
+        MPI_Exscan (&nlocal, &first, 1, MPI_LONG_LONG, MPI_SUM, comm);
+        if (comm.Rank() == 0) first = 0;
+        MPI_Allreduce (&nlocal, &nglob, 1, MPI_LONG_LONG, MPI_SUM, comm);
+      }
+
+    Array<char> buffer(nlocal*recsize);
+    for (size_t i = 0; i < local_data.Size(); i++)
+      {
+        if (with_keys)
+          memcpy (&buffer[i*recsize], &global_keys[i], keysize);
+        memcpy (&buffer[i*recsize+keysize], &local_data[i], sizeof(T));
+      }
+
+    struct { char magic[8]; long long n; int keysize, valsize; } header
+      = { { 'N','G','S','N','O','D','A','L' }, nglob, keysize, int(sizeof(T)) };
+
+    // a single task does not need an initialized MPI
+    if (comm.Size() == 1)
+      {
+        ofstream out(filename, ios::binary | ios::trunc);
+        if (!out)
+          throw Exception ("WriteNodalData: cannot open file '" + filename + "'");
+        out.write ((const char*)&header, sizeof(header));
+        out.write (buffer.Data(), buffer.Size());
+        return nglob;
+      }
+
+    MPI_File fh;
+    if (MPI_File_open (comm, const_cast<char*>(filename.c_str()),
+                       MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+      throw Exception ("WriteNodalData: cannot open file '" + filename + "'");
+    MPI_File_set_size (fh, 0);
+    if (comm.Rank() == 0)
+      MPI_File_write_at (fh, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+
+    // collective writes in chunks of at most INT_MAX records
+    MPI_Datatype rectype;
+    MPI_Type_contiguous (recsize, MPI_BYTE, &rectype);
+    MPI_Type_commit (&rectype);
+    const long long maxchunk = numeric_limits<int>::max();
+    long long nchunks = (nlocal + maxchunk-1) / maxchunk;
+    MPI_Allreduce (MPI_IN_PLACE, &nchunks, 1, MPI_LONG_LONG, MPI_MAX, comm);
+    for (long long c = 0; c < nchunks; c++)
+      {
+        long long begin = min(c*maxchunk, nlocal);
+        int cnt = min(maxchunk, nlocal-begin);
+        MPI_File_write_at_all (fh, sizeof(header) + MPI_Offset(first+begin)*recsize,
+                               buffer.Data()+size_t(begin)*recsize, cnt, rectype, MPI_STATUS_IGNORE);
+      }
+    MPI_Type_free (&rectype);
+    MPI_File_close (&fh);
+    return nglob;
+  }
+
 }
 #endif
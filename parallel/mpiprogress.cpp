@@ -0,0 +1,177 @@
+/* ************************************************************************/
+/* File:   mpiprogress.cpp                                                */
+/* Date:   Oct. 2026                                                      */
+/* ************************************************************************/
+
+#include <parallelngs.hpp>
+#include <thread>
+#include <mutex>
+
+namespace ngla
+{
+  namespace
+  {
+    struct ProgressState
+    {
+      thread worker;
+      atomic<bool> running{false};
+      mutex mtx;         // protects incoming
+      Array<shared_ptr<CommTask>> incoming;
+      int max_sleep_us = 50;
+
+      ~ProgressState ()
+      {
+        running = false;
+        if (worker.joinable()) worker.join();
+      }
+    };
+
+    ProgressState & GetProgressState ()
+    {
+      static ProgressState state;
+      return state;
+    }
+  }
+
+
+  void CommTask :: Wait ()
+  {
+    if (local && !done)
+      {
+        MyMPI_WaitAll (requests);
+        if (on_completion) on_completion();
+        done = true;
+      }
+    while (!done)
+      this_thread::yield();
+  }
+
+
+  void MPIProgressThread :: Start (int max_sleep_us)
+  {
+#ifdef PARALLEL
+    auto & state = GetProgressState();
+    if (state.running) return;
+
+    int provided;
+    MPI_Query_thread (&provided);
+    if (provided < MPI_THREAD_MULTIPLE)
+      throw Exception ("MPI progress thread requires MPI_THREAD_MULTIPLE");
+
+    state.max_sleep_us = max_sleep_us;
+    state.running = true;
+    state.worker = thread(Run);
+#endif
+  }
+
+  void MPIProgressThread :: Stop ()
+  {
+    auto & state = GetProgressState();
+    if (!state.running) return;
+    state.running = false;
+    state.worker.join();
+  }
+
+  bool MPIProgressThread :: IsRunning ()
+  {
+    return GetProgressState().running;
+  }
+
+
+  shared_ptr<CommTask> MPIProgressThread ::
+  Submit (FlatArray<MPI_Request> requests, function<void()> on_completion)
+  {
+    auto task = make_shared<CommTask>();
+    task->requests.SetSize (requests.Size());
+    for (size_t i = 0; i < requests.Size(); i++)
+      task->requests[i] = requests[i];
+    task->on_completion = on_completion;
+
+    auto & state = GetProgressState();
+    lock_guard<mutex> guard(state.mtx);
+    if (state.running)
+      state.incoming.Append (task);
+    else
+      task->local = true;
+    return task;
+  }
+
+  shared_ptr<CommTask> MPIProgressThread ::
+  Submit (function<void(Array<MPI_Request>&)> start, function<void()> on_completion)
+  {
+    auto task = make_shared<CommTask>();
+    task->on_completion = on_completion;
+
+    auto & state = GetProgressState();
+    {
+      lock_guard<mutex> guard(state.mtx);
+      if (state.running)
+        {
+          task->start = start;
+          state.incoming.Append (task);
+          return task;
+        }
+    }
+    task->local = true;
+    start (task->requests);
+    return task;
+  }
+
+
+  void MPIProgressThread :: Run ()
+  {
+#ifdef PARALLEL
+    auto & state = GetProgressState();
+    Array<shared_ptr<CommTask>> active;
+    int sleep_us = 0;
+
+    while (true)
+      {
+        bool stopping = !state.running;
+        {
+          lock_guard<mutex> guard(state.mtx);
+          for (auto & task : state.incoming)
+            active.Append (task);
+          state.incoming.SetSize0();
+        }
+        // on stop, outstanding tasks are completed first
+        if (stopping && active.Size() == 0) break;
+
+        for (size_t i = 0; i < active.Size(); )
+          {
+            CommTask & task = *active[i];
+            if (task.start)
+              {
+                task.start (task.requests);
+                task.start = nullptr;
+              }
+
+            int flag = 1;
+            if (task.requests.Size())
+              MPI_Testall (task.requests.Size(), &task.requests[0], &flag, MPI_STATUSES_IGNORE);
+            if (flag)
+              {
+                if (task.on_completion) task.on_completion();
+                task.done = true;
+                active.DeleteElement (i);
+              }
+            else
+              i++;
+          }
+
+        if (active.Size())
+          {
+            sleep_us = 0;
+            this_thread::yield();
+          }
+        else
+          {
+            // idle: back off, not to compete with the compute threads
+            sleep_us = min(max(2*sleep_us, 1), state.max_sleep_us);
+            this_thread::sleep_for (chrono::microseconds(sleep_us));
+          }
+      }
+#endif
+  }
+
+}
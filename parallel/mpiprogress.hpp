@@ -0,0 +1,67 @@
+#ifndef FILE_NGS_MPIPROGRESS
+#define FILE_NGS_MPIPROGRESS
+
+/* ************************************************************************/
+/* File:   mpiprogress.hpp                                                */
+/* Date:   Oct. 2026                                                      */
+/* ************************************************************************/
+
+namespace ngla
+{
+
+  /**
+     Communication handed over to the progress thread.
+     It is done when all its requests are completed, and 
+     the completion callback has been called.
+  */
+  class NGS_DLL_HEADER CommTask
+  {
+    friend class MPIProgressThread;
+    Array<MPI_Request> requests;
+    function<void(Array<MPI_Request>&)> start;
+    function<void()> on_completion;
+    atomic<bool> done{false};
+    bool local = false;     // no progress thread, completed by Wait
+  public:
+    bool IsDone () const { return done; }
+    /// wait for completion of the task
+    void Wait ();
+  };
+
+
+  /**
+     A dedicated thread driving outstanding non-blocking MPI requests,
+     such that communication progresses while the TaskManager threads 
+     compute. It is not one of the TaskManager workers, so it does not
+     take work from their queues, and it backs off when there are no
+     requests. Requires MPI_THREAD_MULTIPLE.
+
+     Without a running progress thread, submitted tasks are completed
+     in CommTask::Wait.
+  */
+  class NGS_DLL_HEADER MPIProgressThread
+  {
+  public:
+    /// max_sleep_us .. longest sleep when idle
+    static void Start (int max_sleep_us = 50);
+    /// completes outstanding tasks, and joins the thread
+    static void Stop ();
+    static bool IsRunning ();
+
+    /// hand over already started requests, thread-safe
+    static shared_ptr<CommTask> Submit (FlatArray<MPI_Request> requests,
+                                        function<void()> on_completion = nullptr);
+    /**
+       Submit a communication task, thread-safe. The start function is 
+       called on the progress thread, and appends the requests it 
+       issued. Worker threads can communicate without calling MPI.
+    */
+    static shared_ptr<CommTask> Submit (function<void(Array<MPI_Request>&)> start,
+                                        function<void()> on_completion = nullptr);
+  private:
+    static void Run ();
+  };
+
+}
+
+#endif
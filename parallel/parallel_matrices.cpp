@@ -399,6 +399,533 @@ namespace ngla
 
 
 
+  int agglomeration_ranks = 0;
+  AgglomerationStatistics agglomeration_statistics;
+
+  template <typename TM> AutoVector AgglomeratedInverse<TM> :: CreateRowVector () const
+  { return make_unique<ParallelVVector<typename mat_traits<TM>::TV_ROW>> (paralleldofs->GetNDofLocal(), paralleldofs); }
+  template <typename TM> AutoVector AgglomeratedInverse<TM> :: CreateColVector () const
+  { return make_unique<ParallelVVector<typename mat_traits<TM>::TV_COL>> (paralleldofs->GetNDofLocal(), paralleldofs); }
+
+  template <typename TM>
+  AgglomeratedInverse<TM> :: AgglomeratedInverse (const SparseMatrixTM<TM> & mat, 
+                                                  shared_ptr<BitArray> subset, 
+                                                  shared_ptr<ParallelDofs> hpardofs,
+                                                  int nagg)
+    : BaseMatrix(hpardofs)
+  {
+    static Timer t("AgglomeratedInverse - setup"); RegionTimer reg(t);
+
+    auto & comm = paralleldofs->GetCommunicator();
+    int id = comm.Rank();
+    int ntasks = comm.Size();
+
+    if (nagg <= 0) nagg = max2(1, int(sqrt(double(ntasks))));
+    nagg = min2(nagg, ntasks);
+
+    // consistent enumeration
+    Array<int> global_nums(paralleldofs->GetNDofLocal());
+    paralleldofs -> EnumerateGlobally (subset, global_nums, num_glob_dofs);
+
+    // groups of consecutive ranks, the first one agglomerates
+    auto group_of = [&] (int rank) { return int( (size_t(rank)*nagg) / ntasks); };
+    Array<int> group_procs, agg_procs;
+    for (int p = 0; p < ntasks; p++)
+      {
+        if (group_of(p) == group_of(id))
+          group_procs.Append (p);
+        if (p == 0 || group_of(p) != group_of(p-1))
+          agg_procs.Append (p);
+      }
+    is_agg = (group_procs[0] == id);
+    group_comm = comm.SubCommunicator (group_procs);
+    if (is_agg)
+      agg_comm = comm.SubCommunicator (agg_procs);
+    
+    // local matrix in global numbering
+    Array<int> rows, cols;
+    Array<TM> vals;
+    Array<int> sel_globnums;
+
+    for (int row = 0; row < paralleldofs->GetNDofLocal(); row++)
+      if (global_nums[row] != -1)
+        {
+          select.Append (row);
+          sel_globnums.Append (global_nums[row]);
+        }
+    
+    for (int row = 0; row < mat.Height(); row++)
+      if (global_nums[row] != -1)
+        {
+          FlatArray<int> rcols = mat.GetRowIndices(row);
+          FlatVector<TM> rvals = mat.GetRowValues(row);
+          
+          for (int j = 0; j < rcols.Size(); j++)
+            if (global_nums[rcols[j]] != -1)
+              {
+                rows.Append (global_nums[row]);
+                cols.Append (global_nums[rcols[j]]);
+                vals.Append (rvals[j]);
+              }
+        }
+
+    // collect within the group
+    int nsel = select.Size();
+    group_counts.SetSize (group_comm.Size());
+    MPI_Gather (&nsel, 1, MPI_INT, group_counts.Data(), 1, MPI_INT, 0, group_comm);
+
+    if (!is_agg)
+      {
+	group_comm.Send (rows, 0, MPI_TAG_SOLVE);
+	group_comm.Send (cols, 0, MPI_TAG_SOLVE);
+	group_comm.Send (vals, 0, MPI_TAG_SOLVE);
+	group_comm.Send (sel_globnums, 0, MPI_TAG_SOLVE);
+        agglomeration_statistics = AgglomerationStatistics();
+        return;
+      }
+
+    group_offsets.SetSize (group_comm.Size()+1);
+    group_offsets[0] = 0;
+    for (int i = 0; i < group_comm.Size(); i++)
+      group_offsets[i+1] = group_offsets[i] + group_counts[i];
+    group_globnums.SetSize (group_offsets.Last());
+    for (int i = 0; i < nsel; i++)
+      group_globnums[i] = sel_globnums[i];
+
+    for (int src = 1; src < group_comm.Size(); src++)
+      {
+        Array<int> hrows, hcols, hglob;
+        Array<TM> hvals;
+        group_comm.Recv (hrows, src, MPI_TAG_SOLVE);
+        group_comm.Recv (hcols, src, MPI_TAG_SOLVE);
+        group_comm.Recv (hvals, src, MPI_TAG_SOLVE);
+        group_comm.Recv (hglob, src, MPI_TAG_SOLVE);
+        for (int i = 0; i < hrows.Size(); i++)
+          {
+            rows.Append (hrows[i]);
+            cols.Append (hcols[i]);
+            vals.Append (hvals[i]);
+          }
+        for (int i = 0; i < hglob.Size(); i++)
+          group_globnums[group_offsets[src]+i] = hglob[i];
+      }
+
+    // every agglomeration rank collects the matrices and dof numbers of all groups
+    int nent = rows.Size();
+    int ngroup = group_globnums.Size();
+    Array<int> ent_counts(agg_comm.Size()), ent_offsets(agg_comm.Size());
+    agg_counts.SetSize (agg_comm.Size());
+    agg_offsets.SetSize (agg_comm.Size());
+    MPI_Allgather (&nent, 1, MPI_INT, ent_counts.Data(), 1, MPI_INT, agg_comm);
+    MPI_Allgather (&ngroup, 1, MPI_INT, agg_counts.Data(), 1, MPI_INT, agg_comm);
+    int nall = 0, nglob = 0;
+    for (int i = 0; i < agg_comm.Size(); i++)
+      {
+        ent_offsets[i] = nall;
+        nall += ent_counts[i];
+        agg_offsets[i] = nglob;
+        nglob += agg_counts[i];
+      }
+    Array<int> allrows(nall), allcols(nall);
+    Array<TM> allvals(nall);
+    agg_globnums.SetSize (nglob);
+    MPI_Allgatherv (rows.Data(), nent, MPI_INT, allrows.Data(), ent_counts.Data(), ent_offsets.Data(), MPI_INT, agg_comm);
+    MPI_Allgatherv (cols.Data(), nent, MPI_INT, allcols.Data(), ent_counts.Data(), ent_offsets.Data(), MPI_INT, agg_comm);
+    MPI_Allgatherv (vals.Data(), nent, GetMPIType<TM>(), allvals.Data(), ent_counts.Data(), ent_offsets.Data(),
+                    GetMPIType<TM>(), agg_comm);
+    MPI_Allgatherv (group_globnums.Data(), ngroup, MPI_INT, agg_globnums.Data(), agg_counts.Data(), agg_offsets.Data(),
+                    MPI_INT, agg_comm);
+    agglomeration_statistics.matrix_entries = nall;
+    agglomeration_statistics.factor_dofs = num_glob_dofs;
+    agglomeration_statistics.apply_values = 0;
+
+    // build matrix
+    bool symmetric = (dynamic_cast<const SparseMatrixSymmetric<TM>*>(&mat) != NULL);
+
+    DynamicTable<int> graph(num_glob_dofs);
+    for (int i = 0; i < nall; i++)
+      {
+        int r = allrows[i], c = allcols[i];
+        if (symmetric && (r < c)) swap (r, c);
+        graph.AddUnique (r, c);
+      }
+
+    Array<int> els_per_row(num_glob_dofs);
+    for (int i = 0; i < num_glob_dofs; i++)
+      els_per_row[i] = graph[i].Size();
+
+    auto matrix = symmetric ? make_shared<SparseMatrixSymmetric<TM>> (els_per_row)
+      : make_shared<SparseMatrix<TM>> (els_per_row);
+
+    for (int i = 0; i < num_glob_dofs; i++)
+      for (auto c : graph[i])
+        matrix->CreatePosition(i, c);
+    matrix->AsVector() = 0.0;
+
+    for (int i = 0; i < nall; i++)
+      {
+        int r = allrows[i], c = allcols[i];
+        if (symmetric && (r < c)) swap (r, c);
+        (*matrix)(r,c) += allvals[i];
+      }
+
+    cout << IM(3) << "AgglomeratedInverse: factor n = " << num_glob_dofs 
+         << " on " << agg_comm.Size() << " ranks" << endl;
+    matrix->SetInverseType (SPARSECHOLESKY);
+    inv = matrix->InverseMatrix ();
+  }
+
+  template <typename TM>
+  AgglomeratedInverse<TM> :: ~AgglomeratedInverse ()
+  { ; }
+
+  template <typename TM>
+  void AgglomeratedInverse<TM> :: MultAdd (double s, const BaseVector & x, BaseVector & y) const
+  {
+    static Timer t("AgglomeratedInverse - MultAdd"); RegionTimer reg(t);
+    typedef typename mat_traits<TM>::TV_ROW TV;
+    
+    // sum up values of distributed vector, or take master values of cumulated one
+    bool is_x_cum = (dynamic_cast_ParallelBaseVector(x) . Status() == CUMULATED);
+    y.Cumulate();
+
+    FlatVector<TV> fx = x.FV<TV> ();
+    FlatVector<TV> fy = y.FV<TV> ();
+
+    Array<TV> lx (select.Size());
+    for (int i = 0; i < select.Size(); i++)
+      lx[i] = (!is_x_cum || paralleldofs->IsMasterDof(select[i])) ? fx(select[i]) : TV(0.0);
+
+    MPI_Datatype mpi_tv = GetMPIType<TV>();
+    Array<TV> gx (is_agg ? group_globnums.Size() : 0);
+    MPI_Gatherv (lx.Data(), lx.Size(), mpi_tv, 
+                 gx.Data(), group_counts.Data(), group_offsets.Data(), mpi_tv, 0, group_comm);
+
+    if (is_agg)
+      {
+        // every agglomeration rank solves the whole problem, no root
+        Array<TV> ax (agg_globnums.Size());
+        MPI_Allgatherv (gx.Data(), gx.Size(), mpi_tv,
+                        ax.Data(), agg_counts.Data(), agg_offsets.Data(), mpi_tv, agg_comm);
+        agglomeration_statistics.apply_values = ax.Size();
+
+        VVector<TV> hx(num_glob_dofs);
+        VVector<TV> hy(num_glob_dofs);
+        hx = 0.0;
+        for (size_t i = 0; i < ax.Size(); i++)
+          hx(agg_globnums[i]) += ax[i];
+        
+        hy = (*inv) * hx;
+        
+        for (size_t i = 0; i < gx.Size(); i++)
+          gx[i] = hy(group_globnums[i]);
+      }
+
+    MPI_Scatterv (gx.Data(), group_counts.Data(), group_offsets.Data(), mpi_tv,
+                  lx.Data(), lx.Size(), mpi_tv, 0, group_comm);
+    
+    for (int i = 0; i < select.Size(); i++)
+      fy(select[i]) += s * lx[i];
+  }
+
+  template class AgglomeratedInverse<double>;
+  template class AgglomeratedInverse<Complex>;
+
+#if MAX_SYS_DIM >= 1
+  template class AgglomeratedInverse<Mat<1,1,double> >;
+  template class AgglomeratedInverse<Mat<1,1,Complex> >;
+#endif
+#if MAX_SYS_DIM >= 2
+  template class AgglomeratedInverse<Mat<2,2,double> >;
+  template class AgglomeratedInverse<Mat<2,2,Complex> >;
+#endif
+#if MAX_SYS_DIM >= 3
+  template class AgglomeratedInverse<Mat<3,3,double> >;
+  template class AgglomeratedInverse<Mat<3,3,Complex> >;
+#endif
+#if MAX_SYS_DIM >= 4
+  template class AgglomeratedInverse<Mat<4,4,double> >;
+  template class AgglomeratedInverse<Mat<4,4,Complex> >;
+#endif
+#if MAX_SYS_DIM >= 5
+  template class AgglomeratedInverse<Mat<5,5,double> >;
+  template class AgglomeratedInverse<Mat<5,5,Complex> >;
+#endif
+#if MAX_SYS_DIM >= 6
+  template class AgglomeratedInverse<Mat<6,6,double> >;
+  template class AgglomeratedInverse<Mat<6,6,Complex> >;
+#endif
+#if MAX_SYS_DIM >= 7
+  template class AgglomeratedInverse<Mat<7,7,double> >;
+  template class AgglomeratedInverse<Mat<7,7,Complex> >;
+#endif
+#if MAX_SYS_DIM >= 8
+  template class AgglomeratedInverse<Mat<8,8,double> >;
+  template class AgglomeratedInverse<Mat<8,8,Complex> >;
+#endif
+
+
+  template <typename TSCAL> AutoVector DistributedCSRMatrix<TSCAL> :: CreateRowVector () const
+  { return make_unique<ParallelVVector<TSCAL>> (paralleldofs->GetNDofLocal(), paralleldofs); }
+  template <typename TSCAL> AutoVector DistributedCSRMatrix<TSCAL> :: CreateColVector () const
+  { return make_unique<ParallelVVector<TSCAL>> (paralleldofs->GetNDofLocal(), paralleldofs); }
+
+  template <typename TSCAL>
+  DistributedCSRMatrix<TSCAL> :: DistributedCSRMatrix (const ParallelMatrix & pmat)
+    : BaseMatrix(pmat.GetRowParallelDofs())
+  {
+    static Timer t("DistributedCSRMatrix - setup"); RegionTimer reg(t);
+
+    auto spmat = dynamic_pointer_cast<SparseMatrixTM<TSCAL>> (pmat.GetMatrix());
+    if (!spmat || pmat.GetRowParallelDofs() != pmat.GetColParallelDofs())
+      throw Exception ("DistributedCSRMatrix needs a square ParallelMatrix of a scalar sparse matrix");
+    bool symmetric = dynamic_pointer_cast<SparseMatrixSymmetric<TSCAL>> (spmat) != nullptr;
+
+    auto & comm = paralleldofs->GetCommunicator();
+    int ntasks = comm.Size();
+    int id = comm.Rank();
+    size_t ndof = paralleldofs->GetNDofLocal();
+
+    Array<int> globnums(ndof);
+    int hnglob;
+    paralleldofs -> EnumerateGlobally (nullptr, globnums, hnglob);
+    nglob = hnglob;
+
+    for (size_t i = 0; i < ndof; i++)
+      if (paralleldofs->IsMasterDof(i))
+        owned_dofs.Append (i);
+    int nowned = owned_dofs.Size();
+    first_row = nowned ? globnums[owned_dofs[0]] : 0;
+
+    // the global rows owned by rank p are row_start[p] .. row_start[p+1]
+    Array<int> nowned_all(ntasks), row_start(ntasks+1);
+    MPI_Allgather (&nowned, 1, MPI_INT, nowned_all.Data(), 1, MPI_INT, comm);
+    row_start[0] = 0;
+    for (int p = 0; p < ntasks; p++)
+      row_start[p+1] = row_start[p] + nowned_all[p];
+    auto owner_of = [&] (int g)
+      {
+        int l = 0, r = ntasks;
+        while (r-l > 1)
+          {
+            int m = (l+r)/2;
+            if (row_start[m] <= g) l = m; else r = m;
+          }
+        return l;
+      };
+
+    // entries in global numbering, rows of shared dofs go to their masters
+    Array<Array<int>> srows(ntasks), scols(ntasks);
+    Array<Array<TSCAL>> svals(ntasks);
+    auto add = [&] (int row, int col, TSCAL val)
+      {
+        int p = paralleldofs->GetMasterProc(row);
+        srows[p].Append (globnums[row]);
+        scols[p].Append (globnums[col]);
+        svals[p].Append (val);
+      };
+    for (int row = 0; row < spmat->Height(); row++)
+      {
+        FlatArray<int> rcols = spmat->GetRowIndices(row);
+        FlatVector<TSCAL> rvals = spmat->GetRowValues(row);
+        for (int j = 0; j < rcols.Size(); j++)
+          {
+            add (row, rcols[j], rvals[j]);
+            if (symmetric && rcols[j] != row)
+              add (rcols[j], row, rvals[j]);
+          }
+      }
+
+    auto procs = paralleldofs->GetDistantProcs();
+    Array<MPI_Request> requests;
+    for (auto p : procs)
+      {
+        requests.Append (comm.ISend (srows[p], p, MPI_TAG_SOLVE));
+        requests.Append (comm.ISend (scols[p], p, MPI_TAG_SOLVE+1));
+        requests.Append (comm.ISend (svals[p], p, MPI_TAG_SOLVE+2));
+      }
+    Array<int> rows, cols;
+    Array<TSCAL> vals;
+    for (size_t i = 0; i < srows[id].Size(); i++)
+      {
+        rows.Append (srows[id][i]);
+        cols.Append (scols[id][i]);
+        vals.Append (svals[id][i]);
+      }
+    for (auto p : procs)
+      {
+        Array<int> hrows, hcols;
+        Array<TSCAL> hvals;
+        comm.Recv (hrows, p, MPI_TAG_SOLVE);
+        comm.Recv (hcols, p, MPI_TAG_SOLVE+1);
+        comm.Recv (hvals, p, MPI_TAG_SOLVE+2);
+        for (size_t i = 0; i < hrows.Size(); i++)
+          {
+            rows.Append (hrows[i]);
+            cols.Append (hcols[i]);
+            vals.Append (hvals[i]);
+          }
+      }
+    MyMPI_WaitAll (requests);
+
+    // owned rows: sort by column, and sum up duplicates
+    Array<int> cnt(nowned);
+    cnt = 0;
+    for (auto r : rows)
+      cnt[r-first_row]++;
+    Table<int> row_entries(cnt);
+    cnt = 0;
+    for (size_t i = 0; i < rows.Size(); i++)
+      {
+        int r = rows[i]-first_row;
+        row_entries[r][cnt[r]++] = i;
+      }
+
+    rowptr.SetSize (nowned+1);
+    rowptr[0] = 0;
+    Array<int> hcols, index;
+    for (int r = 0; r < nowned; r++)
+      {
+        FlatArray<int> ents = row_entries[r];
+        hcols.SetSize (ents.Size());
+        index.SetSize (ents.Size());
+        for (size_t k = 0; k < ents.Size(); k++)
+          {
+            hcols[k] = cols[ents[k]];
+            index[k] = k;
+          }
+        QuickSortI (hcols, index);
+        for (auto k : index)
+          {
+            if (colglob.Size() > rowptr[r] && colglob.Last() == hcols[k])
+              values.Last() += vals[ents[k]];
+            else
+              {
+                colglob.Append (hcols[k]);
+                values.Append (vals[ents[k]]);
+              }
+          }
+        rowptr[r+1] = colglob.Size();
+      }
+
+    // ghost columns
+    Array<int> hghosts;
+    for (auto c : colglob)
+      if (c < int(first_row) || c >= int(first_row)+nowned)
+        hghosts.Append (c);
+    QuickSort (hghosts);
+    for (size_t i = 0; i < hghosts.Size(); i++)
+      if (i == 0 || hghosts[i] != hghosts[i-1])
+        {
+          ghost_cols.Append (hghosts[i]);
+          ghost_owners.Append (owner_of(hghosts[i]));
+        }
+
+    colind.SetSize (colglob.Size());
+    for (size_t i = 0; i < colglob.Size(); i++)
+      {
+        int c = colglob[i];
+        if (c >= int(first_row) && c < int(first_row)+nowned)
+          colind[i] = c-first_row;
+        else
+          {
+            size_t l = 0, r = ghost_cols.Size();
+            while (l < r)
+              {
+                size_t m = (l+r)/2;
+                if (ghost_cols[m] < c) l = m+1; else r = m;
+              }
+            colind[i] = nowned + l;
+          }
+      }
+
+    // ghosts are sorted, so ghosts of one owner are contiguous
+    Array<int> nrecv(ntasks), nsend(ntasks);
+    nrecv = 0;
+    for (auto p : ghost_owners)
+      nrecv[p]++;
+    ghost_range.SetSize (ntasks+1);
+    ghost_range[0] = 0;
+    for (int p = 0; p < ntasks; p++)
+      ghost_range[p+1] = ghost_range[p] + nrecv[p];
+
+    // tell the owners which of their rows are needed
+    MPI_Alltoall (nrecv.Data(), 1, MPI_INT, nsend.Data(), 1, MPI_INT, comm);
+    send_rows = Table<int> (nsend);
+    requests.SetSize0();
+    for (int p = 0; p < ntasks; p++)
+      {
+        if (nrecv[p])
+          requests.Append (comm.ISend (ghost_cols.Range(ghost_range[p], ghost_range[p+1]), p, MPI_TAG_SOLVE));
+        if (nsend[p])
+          requests.Append (comm.IRecv (send_rows[p], p, MPI_TAG_SOLVE));
+      }
+    MyMPI_WaitAll (requests);
+    for (int p = 0; p < ntasks; p++)
+      for (auto & r : send_rows[p])
+        r -= first_row;
+
+    cout << IM(5) << "DistributedCSRMatrix: " << nowned << " owned rows, "
+         << colglob.Size() << " entries, " << ghost_cols.Size() << " ghost columns" << endl;
+  }
+
+
+  template <typename TSCAL>
+  void DistributedCSRMatrix<TSCAL> :: MultAdd (double s, const BaseVector & x, BaseVector & y) const
+  {
+    static Timer t("DistributedCSRMatrix::MultAdd"); RegionTimer reg(t);
+
+    auto & comm = paralleldofs->GetCommunicator();
+    int ntasks = comm.Size();
+    size_t nowned = owned_dofs.Size();
+
+    x.Cumulate();
+    FlatVector<TSCAL> fx = x.FV<TSCAL>();
+    Vector<TSCAL> xall(nowned + ghost_cols.Size());
+    for (size_t i = 0; i < nowned; i++)
+      xall(i) = fx(owned_dofs[i]);
+
+    // exchange ghost values
+    Array<int> send_sizes(ntasks);
+    for (int p = 0; p < ntasks; p++)
+      send_sizes[p] = send_rows[p].Size();
+    Table<TSCAL> sendbuf(send_sizes);
+    Array<MPI_Request> requests;
+    for (int p = 0; p < ntasks; p++)
+      {
+        if (send_sizes[p])
+          {
+            for (size_t i = 0; i < send_rows[p].Size(); i++)
+              sendbuf[p][i] = xall(send_rows[p][i]);
+            requests.Append (comm.ISend (sendbuf[p], p, MPI_TAG_SOLVE));
+          }
+        if (int nr = ghost_range[p+1]-ghost_range[p])
+          requests.Append (comm.IRecv (FlatArray<TSCAL> (nr, &xall(nowned+ghost_range[p])),
+                                       p, MPI_TAG_SOLVE));
+      }
+    MyMPI_WaitAll (requests);
+
+    y.Distribute();
+    FlatVector<TSCAL> fy = y.FV<TSCAL>();
+    ParallelForRange (nowned, [&] (IntRange r)
+                      {
+                        for (auto i : r)
+                          {
+                            TSCAL sum = 0.0;
+                            for (size_t j = rowptr[i]; j < rowptr[i+1]; j++)
+                              sum += values[j] * xall(colind[j]);
+                            fy(owned_dofs[i]) += s * sum;
+                          }
+                      });
+  }
+
+  template class DistributedCSRMatrix<double>;
+  template class DistributedCSRMatrix<Complex>;
+
+
+
+
+
 
 
   
@@ -421,6 +948,22 @@ namespace ngla
 #else
       spmat->SetInverseType(MASTERINVERSE);
 #endif
+
+#ifdef PARALLEL
+      if (row_paralleldofs && row_paralleldofs == col_paralleldofs &&
+          row_paralleldofs->GetDistantProcs().Size())
+        for (int i = 0; i < spmat->Height(); i++)
+          {
+            bool interior = row_paralleldofs->GetDistantProcs(i).Size() == 0;
+            for (auto j : spmat->GetRowIndices(i))
+              if (row_paralleldofs->GetDistantProcs(j).Size())
+                interior = false;
+            if (interior)
+              interior_rows.Append(i);
+            else
+              halo_rows.Append(i);
+          }
+#endif
     }
   }
 
@@ -481,14 +1024,31 @@ namespace ngla
   {
     const auto & xpar = dynamic_cast_ParallelBaseVector(x);
     auto & ypar = dynamic_cast_ParallelBaseVector(y);
-    if (op & char(2))
-      x.Cumulate();
-    else
-      x.Distribute();
     if (op & char(1))
       y.Cumulate();
     else
       y.Distribute();
+
+    if ( (op & char(2)) && xpar.GetParallelStatus() == DISTRIBUTED &&
+         (interior_rows.Size() || halo_rows.Size()) )
+      {
+        // overlap multiplication of interior rows with the exchange
+        static Timer t("ParallelMatrix::MultAdd - overlapped"); RegionTimer reg(t);
+        auto & spmat = dynamic_cast<const BaseSparseMatrix&> (*mat);
+        xpar.StartCumulate();
+        bool rowwise = spmat.MultAddRows (s, *xpar.GetLocalVector(), *ypar.GetLocalVector(), interior_rows);
+        xpar.FinishCumulate();
+        if (rowwise)
+          spmat.MultAddRows (s, *xpar.GetLocalVector(), *ypar.GetLocalVector(), halo_rows);
+        else
+          mat->MultAdd (s, *xpar.GetLocalVector(), *ypar.GetLocalVector());
+        return;
+      }
+    
+    if (op & char(2))
+      x.Cumulate();
+    else
+      x.Distribute();
     mat->MultAdd (s, *xpar.GetLocalVector(), *ypar.GetLocalVector());
   }
 
@@ -583,7 +1143,9 @@ namespace ngla
 #endif
 
 #ifdef PARALLEL
-      return make_shared<MasterInverse<TM>> (*dmat, subset, paralleldofs);
+    if (mat->GetInverseType() == AGGLOMERATEDINVERSE)
+      return make_shared<AgglomeratedInverse<TM>> (*dmat, subset, paralleldofs);
+    return make_shared<MasterInverse<TM>> (*dmat, subset, paralleldofs);
 #endif
     throw Exception ("ParallelMatrix: don't know how to invert");
   }
@@ -703,6 +1265,158 @@ namespace ngla
     return make_unique<ParallelVVector<double>> (jump_paralleldofs->GetNDofLocal(),
 						 jump_paralleldofs);
   }
+
+
+
+  DofRedistribution :: DofRedistribution (shared_ptr<ParallelDofs> apardofs, FlatArray<int> new_owner)
+    : BaseMatrix(apardofs)
+  {
+    static Timer t("DofRedistribution - setup"); RegionTimer reg(t);
+
+    auto & comm = paralleldofs->GetCommunicator();
+    int ntasks = comm.Size();
+    size_t ndof = paralleldofs->GetNDofLocal();
+    if (new_owner.Size() != ndof)
+      throw Exception ("DofRedistribution: need one new owner per local dof");
+
+    Array<int> globnums(ndof);
+    int nglob;
+    paralleldofs -> EnumerateGlobally (nullptr, globnums, nglob);
+
+    Array<int> nsend(ntasks), nrecv(ntasks);
+    nsend = 0;
+    for (size_t i = 0; i < ndof; i++)
+      if (paralleldofs->IsMasterDof(i))
+        {
+          int p = new_owner[i];
+          if (p < 0 || p >= ntasks)
+            throw Exception ("DofRedistribution: invalid owner rank " + ToString(p));
+          nsend[p]++;
+        }
+    send_dofs = Table<int> (nsend);
+    nsend = 0;
+    for (size_t i = 0; i < ndof; i++)
+      if (paralleldofs->IsMasterDof(i))
+        {
+          int p = new_owner[i];
+          send_dofs[p][nsend[p]++] = i;
+        }
+
+    MPI_Alltoall (nsend.Data(), 1, MPI_INT, nrecv.Data(), 1, MPI_INT, comm);
+    Table<int> send_glob(nsend), recv_glob(nrecv);
+    for (int p = 0; p < ntasks; p++)
+      for (size_t j = 0; j < send_dofs[p].Size(); j++)
+        send_glob[p][j] = globnums[send_dofs[p][j]];
+
+    Array<MPI_Request> requests;
+    for (int p = 0; p < ntasks; p++)
+      {
+        if (nsend[p])
+          requests.Append (comm.ISend (send_glob[p], p, MPI_TAG_SOLVE));
+        if (nrecv[p])
+          requests.Append (comm.IRecv (recv_glob[p], p, MPI_TAG_SOLVE));
+      }
+    MyMPI_WaitAll (requests);
+
+    // new local numbering sorted by global number
+    FlatArray<int> allglob = recv_glob.AsArray();
+    Array<int> index(allglob.Size());
+    for (size_t k = 0; k < index.Size(); k++)
+      index[k] = k;
+    QuickSortI (allglob, index);
+    Array<int> newnum(allglob.Size());
+    for (size_t k = 0; k < index.Size(); k++)
+      newnum[index[k]] = k;
+
+    recv_dofs = Table<int> (nrecv);
+    size_t cnt = 0;
+    for (int p = 0; p < ntasks; p++)
+      for (auto & d : recv_dofs[p])
+        d = newnum[cnt++];
+
+    Array<int> nodistprocs(allglob.Size());
+    nodistprocs = 0;
+    new_paralleldofs = make_shared<ParallelDofs> (comm, Table<int>(nodistprocs),
+                                                  paralleldofs->GetEntrySize(),
+                                                  paralleldofs->IsComplex());
+  }
+
+  template <typename SCAL>
+  void DofRedistribution :: Transfer (double s, const BaseVector & x, const Table<int> & from_dofs,
+                                      BaseVector & y, const Table<int> & to_dofs) const
+  {
+    auto & comm = paralleldofs->GetCommunicator();
+    int ntasks = comm.Size();
+    size_t es = paralleldofs->GetEntrySize();
+
+    x.Cumulate();
+    FlatVector<SCAL> fx = x.FV<SCAL>();
+    Array<int> nsend(ntasks), nrecv(ntasks);
+    for (int p = 0; p < ntasks; p++)
+      {
+        nsend[p] = from_dofs[p].Size()*es;
+        nrecv[p] = to_dofs[p].Size()*es;
+      }
+    Table<SCAL> sendbuf(nsend), recvbuf(nrecv);
+    Array<MPI_Request> requests;
+    for (int p = 0; p < ntasks; p++)
+      {
+        if (nsend[p])
+          {
+            for (size_t j = 0; j < from_dofs[p].Size(); j++)
+              for (size_t k = 0; k < es; k++)
+                sendbuf[p][j*es+k] = fx(from_dofs[p][j]*es+k);
+            requests.Append (comm.ISend (sendbuf[p], p, MPI_TAG_SOLVE));
+          }
+        if (nrecv[p])
+          requests.Append (comm.IRecv (recvbuf[p], p, MPI_TAG_SOLVE));
+      }
+    MyMPI_WaitAll (requests);
+
+    // only master dofs get values
+    y.Distribute();
+    FlatVector<SCAL> fy = y.FV<SCAL>();
+    for (int p = 0; p < ntasks; p++)
+      for (size_t j = 0; j < to_dofs[p].Size(); j++)
+        for (size_t k = 0; k < es; k++)
+          fy(to_dofs[p][j]*es+k) += s * recvbuf[p][j*es+k];
+  }
+
+  void DofRedistribution :: MultAdd (double s, const BaseVector & x, BaseVector & y) const
+  {
+    static Timer t("DofRedistribution::MultAdd"); RegionTimer reg(t);
+    if (IsComplex())
+      Transfer<Complex> (s, x, send_dofs, y, recv_dofs);
+    else
+      Transfer<double> (s, x, send_dofs, y, recv_dofs);
+  }
+
+  void DofRedistribution :: MultTransAdd (double s, const BaseVector & x, BaseVector & y) const
+  {
+    static Timer t("DofRedistribution::MultTransAdd"); RegionTimer reg(t);
+    if (IsComplex())
+      Transfer<Complex> (s, x, recv_dofs, y, send_dofs);
+    else
+      Transfer<double> (s, x, recv_dofs, y, send_dofs);
+  }
+
+  AutoVector DofRedistribution :: CreateRowVector () const
+  {
+    if (IsComplex())
+      return make_unique<S_ParallelBaseVectorPtr<Complex>> (paralleldofs->GetNDofLocal(), paralleldofs->GetEntrySize(),
+                                                            paralleldofs, DISTRIBUTED);
+    return make_unique<S_ParallelBaseVectorPtr<double>> (paralleldofs->GetNDofLocal(), paralleldofs->GetEntrySize(),
+                                                         paralleldofs, DISTRIBUTED);
+  }
+
+  AutoVector DofRedistribution :: CreateColVector () const
+  {
+    if (IsComplex())
+      return make_unique<S_ParallelBaseVectorPtr<Complex>> (new_paralleldofs->GetNDofLocal(), new_paralleldofs->GetEntrySize(),
+                                                            new_paralleldofs, DISTRIBUTED);
+    return make_unique<S_ParallelBaseVectorPtr<double>> (new_paralleldofs->GetNDofLocal(), new_paralleldofs->GetEntrySize(),
+                                                         new_paralleldofs, DISTRIBUTED);
+  }
   
 #endif
   
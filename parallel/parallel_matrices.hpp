@@ -25,6 +25,10 @@ namespace ngla
     shared_ptr<ParallelDofs> row_paralleldofs, col_paralleldofs;
 
     PARALLEL_OP op;
+
+    /// rows coupling only to non-shared dofs, and the others:
+    /// the interior rows are multiplied while cumulating x
+    Array<int> interior_rows, halo_rows;
     
   public:
     ParallelMatrix (shared_ptr<BaseMatrix> amat, shared_ptr<ParallelDofs> apardofs,
@@ -100,6 +104,113 @@ namespace ngla
   };
 
 
+  /// number of ranks used by AgglomeratedInverse, 0 .. about sqrt(ntasks)
+  extern NGS_DLL_HEADER int agglomeration_ranks;
+
+  /// work of this rank in the last AgglomeratedInverse setup and application
+  struct AgglomerationStatistics
+  {
+    size_t matrix_entries = 0;   // entries of the collected matrix
+    size_t factor_dofs = 0;      // size of the factored matrix
+    size_t apply_values = 0;     // right hand side values received per application
+  };
+  extern NGS_DLL_HEADER AgglomerationStatistics agglomeration_statistics;
+
+  /**
+     Distributed alternative to MasterInverse.
+     The ranks are split into groups of consecutive ranks, the first rank
+     of each group is an agglomeration rank. The agglomeration ranks collect
+     the matrix of their group, exchange the group matrices among each other
+     and factor the whole problem redundantly with the built-in SparseCholesky.
+     An application gathers the right hand side within the groups, exchanges
+     the group parts among the agglomeration ranks, solves on each of them,
+     and scatters the solution back to the groups. There is no single root.
+   */
+  template <typename TM>
+  class AgglomeratedInverse : public BaseMatrix
+  {
+    /// the factorization, on every agglomeration rank
+    shared_ptr<BaseMatrix> inv;
+    /// my agglomeration rank (rank 0) and its clients
+    NgMPI_Comm group_comm;
+    /// all agglomeration ranks, only on agglomeration ranks
+    NgMPI_Comm agg_comm;
+    bool is_agg;
+    /// local dofs in the subset, and their global numbers
+    Array<int> select;
+    /// on agglomeration ranks: global numbers of all dofs of the group
+    Array<int> group_globnums;
+    Array<int> group_counts, group_offsets;
+    /// on agglomeration ranks: global numbers of the dofs of all groups
+    Array<int> agg_globnums;
+    Array<int> agg_counts, agg_offsets;
+    int num_glob_dofs;
+  public:
+    AgglomeratedInverse (const SparseMatrixTM<TM> & mat, shared_ptr<BitArray> asubset, 
+                         shared_ptr<ParallelDofs> apardofs, int nagg = agglomeration_ranks);
+    virtual ~AgglomeratedInverse () override;
+    virtual bool IsComplex() const override { return mat_traits<TM>::IS_COMPLEX; } 
+    virtual void MultAdd (double s, const BaseVector & x, BaseVector & y) const override;
+
+    virtual int VHeight() const override { return paralleldofs->GetNDofLocal(); }
+    virtual int VWidth() const override { return paralleldofs->GetNDofLocal(); }
+
+    AutoVector CreateRowVector() const override;
+    AutoVector CreateColVector() const override;
+  };
+
+
+
+  /**
+     Row-distributed global CSR matrix, the format of external packages.
+     Every rank owns the rows of its master dofs, numbered consecutively 
+     by ParallelDofs::EnumerateGlobally, and stores them with global 
+     column numbers. Columns owned by other ranks are ghost columns.
+     Built from the local matrices of a ParallelMatrix by one exchange 
+     of the rows of shared dofs to their masters. 
+     MultAdd receives the ghost values from their owners only, and adds
+     the owned rows to the master dofs of y.
+  */
+  template <typename TSCAL>
+  class DistributedCSRMatrix : public BaseMatrix
+  {
+    size_t nglob;
+    /// global number of the first owned row
+    size_t first_row;
+    /// local dofs of the owned rows
+    Array<int> owned_dofs;
+    Array<size_t> rowptr;
+    /// global column numbers
+    Array<int> colglob;
+    /// owned columns 0..nowned, then the ghost columns
+    Array<int> colind;
+    Array<TSCAL> values;
+    /// global numbers of the ghost columns, sorted, and their owners
+    Array<int> ghost_cols, ghost_owners;
+    /// ghost columns owned by rank p: ghost_range[p] .. ghost_range[p+1]
+    Array<int> ghost_range;
+    /// owned rows needed by other ranks
+    Table<int> send_rows;
+  public:
+    DistributedCSRMatrix (const ParallelMatrix & pmat);
+    virtual bool IsComplex() const override { return is_same<TSCAL,Complex>::value; } 
+    virtual void MultAdd (double s, const BaseVector & x, BaseVector & y) const override;
+
+    virtual int VHeight() const override { return paralleldofs->GetNDofLocal(); }
+    virtual int VWidth() const override { return paralleldofs->GetNDofLocal(); }
+    AutoVector CreateRowVector() const override;
+    AutoVector CreateColVector() const override;
+
+    size_t NGlobal () const { return nglob; }
+    size_t FirstRow () const { return first_row; }
+    FlatArray<int> OwnedDofs () const { return owned_dofs; }
+    FlatArray<size_t> RowPtr () const { return rowptr; }
+    FlatArray<int> GlobalColumns () const { return colglob; }
+    FlatArray<TSCAL> Values () const { return values; }
+    FlatArray<int> GhostColumns () const { return ghost_cols; }
+    FlatArray<int> GhostOwners () const { return ghost_owners; }
+  };
+
   
   class FETI_Jump_Matrix : public BaseMatrix
   {
@@ -126,6 +237,41 @@ namespace ngla
 
   };
 
+
+  /**
+     Moves vectors to a new dof layout given by a new owner rank for every
+     local dof, where only the entries of master dofs are used. On the new
+     owner the dofs are ordered by their global number and are not shared.
+     Mult maps from the old to the new layout, MultTrans maps back.
+  */
+  class DofRedistribution : public BaseMatrix
+  {
+    shared_ptr<ParallelDofs> new_paralleldofs;
+    /// my master dofs moving to rank p
+    Table<int> send_dofs;
+    /// new local dofs coming from rank p
+    Table<int> recv_dofs;
+  public:
+    DofRedistribution (shared_ptr<ParallelDofs> pardofs, FlatArray<int> new_owner);
+
+    virtual bool IsComplex() const override { return paralleldofs->IsComplex(); }
+    virtual void MultAdd (double s, const BaseVector & x, BaseVector & y) const override;
+    virtual void MultTransAdd (double s, const BaseVector & x, BaseVector & y) const override;
+
+    virtual int VHeight() const override { return new_paralleldofs->GetNDofLocal(); }
+    virtual int VWidth() const override { return paralleldofs->GetNDofLocal(); }
+    virtual AutoVector CreateRowVector () const override;
+    virtual AutoVector CreateColVector () const override;
+
+    shared_ptr<ParallelDofs> GetOldParallelDofs () const { return paralleldofs; }
+    shared_ptr<ParallelDofs> GetNewParallelDofs () const { return new_paralleldofs; }
+
+  protected:
+    template <typename SCAL>
+    void Transfer (double s, const BaseVector & x, const Table<int> & from_dofs,
+                   BaseVector & y, const Table<int> & to_dofs) const;
+  };
+
 #endif
 }
 
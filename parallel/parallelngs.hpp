@@ -11,6 +11,7 @@ namespace ngparallel
 }
 
 
+#include "mpiprogress.hpp"
 #include "parallelvector.hpp"
 #include "parallel_matrices.hpp"
 
@@ -26,6 +26,8 @@ namespace ngla
     
     Array<MPI_Request> sreqs;
     Array<MPI_Request> rreqs;
+    /// StartCumulate has been called, FinishCumulate not yet
+    mutable bool cumulate_pending = false;
 
   public:
     ParallelBaseVector ()
@@ -75,6 +77,15 @@ namespace ngla
     { return local_vec; }
     
     virtual void Cumulate () const; 
+
+    /** 
+        Start the exchange of shared dofs for cumulating the vector.
+        Until FinishCumulate, only values of non-shared dofs may be used.
+    */
+    virtual void StartCumulate () const;
+    /// wait for the exchange and add up the received values
+    virtual void FinishCumulate () const;
+    bool IsCumulatePending () const { return cumulate_pending; }
     
     virtual void Distribute() const = 0;
     // { cerr << "ERROR -- Distribute called for BaseVector, is not parallel" << endl; }
@@ -175,6 +186,10 @@ namespace ngla
     using ParallelBaseVector :: rreqs;
 
     Table<SCAL> * recvvalues;
+    /// packed values of exchange dofs, sent by persistent requests
+    Table<SCAL> * sendvalues;
+    /// the pending cumulate, if driven by the progress thread
+    mutable shared_ptr<CommTask> progress_task;
 
     using S_BaseVectorPtr<TSCAL> :: pdata;
     using ParallelBaseVector :: local_vec;
@@ -187,6 +202,8 @@ namespace ngla
     virtual void SetParallelDofs (shared_ptr<ParallelDofs> aparalleldofs, const Array<int> * procs=0 );
 
     virtual void Distribute() const;
+    virtual void StartCumulate () const;
+    virtual void FinishCumulate () const;
     virtual ostream & Print (ostream & ost) const;
 
     virtual void  IRecvVec ( int dest, MPI_Request & request );
@@ -195,6 +212,9 @@ namespace ngla
     virtual AutoVector CreateVector () const;
 
     virtual double L2Norm () const;
+  protected:
+    void CreateRequests ();
+    void FreeRequests ();
   };
  
 
@@ -257,6 +277,98 @@ namespace ngla
     virtual ~ParallelVFlatVector() throw()
     { ; }
   };
+
+
+
+  /**
+     A batch of inner products and norms of (parallel) vectors, 
+     reduced by one single non-blocking allreduce.
+
+     The local contributions are computed when a product is added,
+     Start issues the reduction, and the returned futures wait for it 
+     on first access. Work between Start and Get hides the latency
+     of the reduction. Vectors are not modified, except that 
+     for two distributed vectors one of them is cumulated.
+  */
+  class NGS_DLL_HEADER BatchedInnerProducts
+  {
+  public:
+    class State
+    {
+      Array<double> values;
+      NgMPI_Comm comm;
+      bool parallel = false;
+      bool started = false;
+      bool pending = false;
+      MPI_Request request;
+      shared_ptr<CommTask> progress_task;
+    public:
+      ~State ();
+      size_t Add (size_t n, NgMPI_Comm acomm, bool aparallel);
+      FlatArray<double> Values () { return values; }
+      bool Started () const { return started; }
+      void Start ();
+      void Wait ();
+    };
+
+    /// a scalar result (double or Complex)
+    template <typename TSCAL>
+    class Future
+    {
+      shared_ptr<State> state;
+      size_t first = 0;
+      bool is_norm = false;
+    public:
+      Future () = default;
+      Future (shared_ptr<State> astate, size_t afirst, bool ais_norm = false)
+        : state(astate), first(afirst), is_norm(ais_norm) { ; }
+      TSCAL Get () const
+      {
+        state->Wait();
+        auto vals = state->Values();
+        if constexpr (is_same<TSCAL,Complex>::value)
+          return Complex (vals[first], vals[first+1]);
+        else
+          return is_norm ? sqrt(vals[first]) : vals[first];
+      }
+    };
+
+    /// a matrix of results, from a pair of MultiVectors
+    template <typename TSCAL>
+    class MatrixFuture
+    {
+      shared_ptr<State> state;
+      size_t first = 0, h = 0, w = 0;
+    public:
+      MatrixFuture () = default;
+      MatrixFuture (shared_ptr<State> astate, size_t afirst, size_t ah, size_t aw)
+        : state(astate), first(afirst), h(ah), w(aw) { ; }
+      Matrix<TSCAL> Get () const
+      {
+        state->Wait();
+        Matrix<TSCAL> res(h, w);
+        if (h*w)
+          res = FlatMatrix<TSCAL> (h, w, (TSCAL*)&state->Values()[first]);
+        return res;
+      }
+    };
+
+  private:
+    shared_ptr<State> state;
+    
+  public:
+    BatchedInnerProducts () : state(make_shared<State>()) { ; }
+
+    Future<double> AddInnerProduct (const BaseVector & x, const BaseVector & y);
+    Future<Complex> AddInnerProductC (const BaseVector & x, const BaseVector & y,
+                                      bool conjugate = false);
+    Future<double> AddNorm (const BaseVector & x);
+    MatrixFuture<double> AddInnerProducts (const MultiVector & x, const MultiVector & y);
+    MatrixFuture<Complex> AddInnerProductsC (const MultiVector & x, const MultiVector & y,
+                                             bool conjugate = false);
+    /// issue the reduction, no more products can be added
+    void Start () { state->Start(); }
+  };
 }
 
 // #endif
@@ -107,36 +107,47 @@ namespace ngla
   
 
   void ParallelBaseVector :: Cumulate () const
+  {
+    StartCumulate();
+    FinishCumulate();
+  }
+
+  void ParallelBaseVector :: StartCumulate () const
   {
 #ifdef PARALLEL
-    if (status != DISTRIBUTED) return;
+    if (status != DISTRIBUTED || cumulate_pending) return;
     
-    // int ntasks = paralleldofs->GetNTasks();
     auto exprocs = paralleldofs->GetDistantProcs();
-    
     int nexprocs = exprocs.Size();
     
     ParallelBaseVector * constvec = const_cast<ParallelBaseVector * > (this);
     
     for (int idest = 0; idest < nexprocs; idest ++ ) 
-      constvec->ISend (exprocs[idest], sreqs[idest] );
+      constvec->ISend (exprocs[idest], constvec->sreqs[idest] );
     for (int isender=0; isender < nexprocs; isender++)
-      constvec -> IRecvVec (exprocs[isender], rreqs[isender] );
-    
-    // if (rreqs.Size()) { // apparently Startall with 0 requests fails b/c invalid request ??
-    //   MPI_Startall(rreqs.Size(), &rreqs[0]);
-    //   MPI_Startall(sreqs.Size(), &sreqs[0]);
-    // }
+      constvec -> IRecvVec (exprocs[isender], constvec->rreqs[isender] );
+
+    cumulate_pending = true;
+#endif
+  }
+
+  void ParallelBaseVector :: FinishCumulate () const
+  {
+#ifdef PARALLEL
+    if (!cumulate_pending) return;
+
+    auto exprocs = paralleldofs->GetDistantProcs();
+    ParallelBaseVector * constvec = const_cast<ParallelBaseVector * > (this);
 
-    MyMPI_WaitAll (sreqs);
-    
     // cumulate
-    for (int cntexproc=0; cntexproc < nexprocs; cntexproc++)
+    for (int cntexproc=0; cntexproc < exprocs.Size(); cntexproc++)
       {
-	int isender = MyMPI_WaitAny (rreqs);
+	int isender = MyMPI_WaitAny (constvec->rreqs);
 	constvec->AddRecvValues(exprocs[isender]);
       } 
+    MyMPI_WaitAll (constvec->sreqs);
 
+    cumulate_pending = false;
     SetStatus(CUMULATED);
 #endif
   }
@@ -237,6 +248,7 @@ namespace ngla
     : S_BaseVectorPtr<SCAL> (as, aes)
   { 
     recvvalues = NULL;
+    sendvalues = NULL;
     if ( apd != 0 )
       {
 	this -> SetParallelDofs ( apd );
@@ -253,7 +265,36 @@ namespace ngla
   template <class SCAL>
   S_ParallelBaseVectorPtr<SCAL> :: ~S_ParallelBaseVectorPtr ()
   {
+#ifdef PARALLEL
+    // vectors held by python may be released after MPI_Finalize
+    int finalized = 0;
+    MPI_Finalized (&finalized);
+    if (!finalized)
+#endif
+      {
+        FinishCumulate();
+        FreeRequests();
+      }
     delete recvvalues;
+    delete sendvalues;
+  }
+
+  template <class SCAL>
+  void S_ParallelBaseVectorPtr<SCAL> :: FreeRequests ()
+  {
+#ifdef PARALLEL
+    int finalized = 0;
+    MPI_Finalized (&finalized);
+    if (!finalized)
+      {
+        for (auto & req : sreqs)
+          if (req != MPI_REQUEST_NULL) MPI_Request_free (&req);
+        for (auto & req : rreqs)
+          if (req != MPI_REQUEST_NULL) MPI_Request_free (&req);
+      }
+#endif
+    sreqs.SetSize0();
+    rreqs.SetSize0();
   }
 
 
@@ -263,6 +304,8 @@ namespace ngla
   {
     if (this->paralleldofs == aparalleldofs) return;
 
+    FinishCumulate();
+    FreeRequests();
     this -> paralleldofs = aparalleldofs;
     if ( this -> paralleldofs == 0 ) return;
     
@@ -272,18 +315,101 @@ namespace ngla
       exdofs[i] = this->es * this->paralleldofs->GetExchangeDofs(i).Size();
     delete this->recvvalues;
     this -> recvvalues = new Table<TSCAL> (exdofs);
+    delete this->sendvalues;
+    this -> sendvalues = new Table<TSCAL> (exdofs);
+  }
 
-    // Initiate persistent send/recv requests for vector cumulate operation
+  /*
+    Persistent send/recv requests for the cumulate operation, exchange dofs
+    are packed into contiguous buffers. They are created by the first
+    StartCumulate, vectors which are never cumulated do not hold any.
+  */
+  template <typename SCAL>
+  void S_ParallelBaseVectorPtr<SCAL> :: CreateRequests ()
+  {
+#ifdef PARALLEL
     auto dps = paralleldofs->GetDistantProcs();
     this->sreqs.SetSize(dps.Size());
     this->rreqs.SetSize(dps.Size());
-    // for (auto k : Range(dps)) {
-    //   auto p = dps[k];
-    //   MPI_Datatype mpi_t = this->paralleldofs->MyGetMPI_Type(p);
-    //   MPI_Send_init( this->Memory(), 1, mpi_t, p, MPI_TAG_SOLVE, this->paralleldofs->GetCommunicator(), &sreqs[k]);
-    //   MPI_Recv_init( &( (*recvvalues)[p][0]), (*recvvalues)[p].Size(), MyGetMPIType<TSCAL> (),
-    // 		     p, MPI_TAG_SOLVE, this->paralleldofs->GetCommunicator(), &rreqs[k]);
-    // }
+    MPI_Datatype MPI_TS = GetMPIType<TSCAL> ();
+    for (auto k : Range(dps)) {
+      auto p = dps[k];
+      MPI_Send_init( &( (*sendvalues)[p][0]), (*sendvalues)[p].Size(), MPI_TS,
+                     p, MPI_TAG_SOLVE, this->paralleldofs->GetCommunicator(), &sreqs[k]);
+      MPI_Recv_init( &( (*recvvalues)[p][0]), (*recvvalues)[p].Size(), MPI_TS,
+                     p, MPI_TAG_SOLVE, this->paralleldofs->GetCommunicator(), &rreqs[k]);
+    }
+#endif
+  }
+
+
+  template <typename SCAL>
+  void S_ParallelBaseVectorPtr<SCAL> :: StartCumulate () const
+  {
+#ifdef PARALLEL
+    if (status != DISTRIBUTED || this->cumulate_pending) return;
+
+    auto dps = paralleldofs->GetDistantProcs();
+    FlatMatrix<SCAL> fv (this->size, this->es, pdata);
+    for (auto p : dps)
+      {
+        FlatArray<int> exdofs = paralleldofs->GetExchangeDofs(p);
+        FlatMatrix<SCAL> send (exdofs.Size(), this->es, &(*sendvalues)[p][0]);
+        for (size_t i = 0; i < exdofs.Size(); i++)
+          send.Row(i) = fv.Row(exdofs[i]);
+      }
+
+    if (sreqs.Size() != dps.Size())
+      const_cast<S_ParallelBaseVectorPtr<SCAL>*> (this) -> CreateRequests();
+
+    // apparently Startall with 0 requests fails b/c invalid request
+    auto & hrreqs = const_cast<Array<MPI_Request>&> (rreqs);
+    auto & hsreqs = const_cast<Array<MPI_Request>&> (sreqs);
+    if (dps.Size())
+      {
+        MPI_Startall (hrreqs.Size(), &hrreqs[0]);
+        MPI_Startall (hsreqs.Size(), &hsreqs[0]);
+        if (MPIProgressThread::IsRunning())
+          {
+            // persistent requests stay valid, the thread only completes them
+            Array<MPI_Request> reqs;
+            for (auto req : hrreqs) reqs.Append (req);
+            for (auto req : hsreqs) reqs.Append (req);
+            progress_task = MPIProgressThread::Submit (reqs);
+          }
+      }
+    this->cumulate_pending = true;
+#endif
+  }
+
+  template <typename SCAL>
+  void S_ParallelBaseVectorPtr<SCAL> :: FinishCumulate () const
+  {
+#ifdef PARALLEL
+    if (!this->cumulate_pending) return;
+
+    auto dps = paralleldofs->GetDistantProcs();
+    auto constvec = const_cast<S_ParallelBaseVectorPtr<SCAL>*> (this);
+    if (progress_task)
+      {
+        progress_task->Wait();
+        progress_task = nullptr;
+        for (auto p : dps)
+          constvec->AddRecvValues(p);
+      }
+    else
+      {
+        for (size_t cnt = 0; cnt < dps.Size(); cnt++)
+          {
+            int isender = MyMPI_WaitAny (constvec->rreqs);
+            constvec->AddRecvValues(dps[isender]);
+          } 
+        MyMPI_WaitAll (constvec->sreqs);
+      }
+
+    this->cumulate_pending = false;
+    this->SetStatus(CUMULATED);
+#endif
   }
 
 
@@ -406,6 +532,200 @@ namespace ngla
 
   template class S_ParallelBaseVectorPtr<double>;
   template class S_ParallelBaseVectorPtr<Complex>;
+
+
+
+  namespace
+  {
+    const ParallelBaseVector * GetParallelVector (const BaseVector & x)
+    {
+      auto px = dynamic_cast_ParallelBaseVector (&x);
+      return (px && px->IsParallelVector()) ? px : nullptr;
+    }
+    
+    inline double MaybeConj (double x, bool conjugate) { return x; }
+    inline Complex MaybeConj (Complex x, bool conjugate) { return conjugate ? conj(x) : x; }
+
+    /*
+      Local contribution to the inner product, no communication 
+      except cumulating x if both vectors are distributed.
+      Two cumulated vectors are summed up over master dofs only.
+    */
+    template <typename SCAL>
+    SCAL LocalInnerProduct (const BaseVector & x, const BaseVector & y, bool conjugate,
+                            shared_ptr<ParallelDofs> & pardofs)
+    {
+      auto px = GetParallelVector(x);
+      auto py = GetParallelVector(y);
+      pardofs = px ? px->GetParallelDofs() : (py ? py->GetParallelDofs() : nullptr);
+
+      PARALLEL_STATUS sx = px ? px->Status() : CUMULATED;
+      PARALLEL_STATUS sy = py ? py->Status() : CUMULATED;
+      if (sx == DISTRIBUTED && sy == DISTRIBUTED)
+        {
+          x.Cumulate();
+          sx = CUMULATED;
+        }
+
+      FlatVector<SCAL> fx = x.FV<SCAL>();
+      FlatVector<SCAL> fy = y.FV<SCAL>();
+
+      if (!pardofs || sx != sy)
+        {
+          if (!conjugate)
+            return ngbla::InnerProduct (fx, fy);
+          SCAL sum = 0.0;
+          for (size_t k = 0; k < fx.Size(); k++)
+            sum += MaybeConj(fx(k), conjugate) * fy(k);
+          return sum;
+        }
+
+      size_t ndof = x.Size();
+      size_t es = ndof ? fx.Size() / ndof : 0;
+      SCAL sum = 0.0;
+      for (size_t dof = 0; dof < ndof; dof++)
+        if (pardofs->IsMasterDof(dof))
+          for (size_t k = dof*es; k < (dof+1)*es; k++)
+            sum += MaybeConj(fx(k), conjugate) * fy(k);
+      return sum;
+    }
+  }
+  
+  BatchedInnerProducts::State :: ~State ()
+  {
+    if (started) Wait();
+  }
+
+  size_t BatchedInnerProducts::State :: Add (size_t n, NgMPI_Comm acomm, bool aparallel)
+  {
+    if (started)
+      throw Exception ("BatchedInnerProducts: reduction already started");
+    if (aparallel)
+      {
+        comm = acomm;
+        parallel = true;
+      }
+    size_t first = values.Size();
+    for (size_t i = 0; i < n; i++)
+      values.Append (0.0);
+    return first;
+  }
+
+  void BatchedInnerProducts::State :: Start ()
+  {
+    if (started) return;
+    started = true;
+#ifdef PARALLEL
+    if (parallel && comm.Size() > 1)
+      {
+        MPI_Iallreduce (MPI_IN_PLACE, values.Data(), values.Size(), MPI_DOUBLE, MPI_SUM,
+                        comm, &request);
+        pending = true;
+        if (MPIProgressThread::IsRunning())
+          progress_task = MPIProgressThread::Submit (FlatArray<MPI_Request> (1, &request));
+      }
+#endif
+  }
+
+  void BatchedInnerProducts::State :: Wait ()
+  {
+    if (!started) Start();
+#ifdef PARALLEL
+    if (pending)
+      {
+        if (progress_task)
+          progress_task->Wait();
+        else
+          MPI_Wait (&request, MPI_STATUS_IGNORE);
+        progress_task = nullptr;
+        pending = false;
+      }
+#endif
+  }
+
+  
+  auto BatchedInnerProducts :: AddInnerProduct (const BaseVector & x, const BaseVector & y)
+    -> Future<double>
+  {
+    shared_ptr<ParallelDofs> pardofs;
+    double local = LocalInnerProduct<double> (x, y, false, pardofs);
+    size_t first = state->Add (1, pardofs ? pardofs->GetCommunicator() : NgMPI_Comm(), pardofs != nullptr);
+    state->Values()[first] = local;
+    return Future<double> (state, first);
+  }
+
+  auto BatchedInnerProducts :: AddInnerProductC (const BaseVector & x, const BaseVector & y,
+                                                 bool conjugate) -> Future<Complex>
+  {
+    shared_ptr<ParallelDofs> pardofs;
+    Complex local = LocalInnerProduct<Complex> (x, y, conjugate, pardofs);
+    size_t first = state->Add (2, pardofs ? pardofs->GetCommunicator() : NgMPI_Comm(), pardofs != nullptr);
+    state->Values()[first] = local.real();
+    state->Values()[first+1] = local.imag();
+    return Future<Complex> (state, first);
+  }
+
+  auto BatchedInnerProducts :: AddNorm (const BaseVector & x) -> Future<double>
+  {
+    auto px = GetParallelVector(x);
+    shared_ptr<ParallelDofs> pardofs = px ? px->GetParallelDofs() : nullptr;
+    if (px && px->Status() == DISTRIBUTED)
+      x.Cumulate();
+
+    FlatVector<double> fx = x.FVDouble();
+    double local = 0;
+    if (!pardofs)
+      local = L2Norm2 (fx);
+    else
+      {
+        size_t ndof = x.Size();
+        size_t es = ndof ? fx.Size() / ndof : 0;
+        for (size_t dof = 0; dof < ndof; dof++)
+          if (pardofs->IsMasterDof(dof))
+            local += L2Norm2 (fx.Range(dof*es, (dof+1)*es));
+      }
+    
+    size_t first = state->Add (1, pardofs ? pardofs->GetCommunicator() : NgMPI_Comm(), pardofs != nullptr);
+    state->Values()[first] = local;
+    return Future<double> (state, first, true);
+  }
+
+  auto BatchedInnerProducts :: AddInnerProducts (const MultiVector & x, const MultiVector & y)
+    -> MatrixFuture<double>
+  {
+    size_t h = x.Size(), w = y.Size();
+    Matrix<double> local(h, w);
+    shared_ptr<ParallelDofs> pardofs;
+    for (size_t i = 0; i < h; i++)
+      for (size_t j = 0; j < w; j++)
+        local(i,j) = LocalInnerProduct<double> (*x[i], *y[j], false, pardofs);
+
+    size_t first = state->Add (h*w, pardofs ? pardofs->GetCommunicator() : NgMPI_Comm(), pardofs != nullptr);
+    for (size_t i = 0; i < h; i++)
+      for (size_t j = 0; j < w; j++)
+        state->Values()[first+i*w+j] = local(i,j);
+    return MatrixFuture<double> (state, first, h, w);
+  }
+
+  auto BatchedInnerProducts :: AddInnerProductsC (const MultiVector & x, const MultiVector & y,
+                                                  bool conjugate) -> MatrixFuture<Complex>
+  {
+    size_t h = x.Size(), w = y.Size();
+    Matrix<Complex> local(h, w);
+    shared_ptr<ParallelDofs> pardofs;
+    for (size_t i = 0; i < h; i++)
+      for (size_t j = 0; j < w; j++)
+        local(i,j) = LocalInnerProduct<Complex> (*x[i], *y[j], conjugate, pardofs);
+
+    size_t first = state->Add (2*h*w, pardofs ? pardofs->GetCommunicator() : NgMPI_Comm(), pardofs != nullptr);
+    for (size_t i = 0; i < h; i++)
+      for (size_t j = 0; j < w; j++)
+        {
+          state->Values()[first+2*(i*w+j)] = local(i,j).real();
+          state->Values()[first+2*(i*w+j)+1] = local(i,j).imag();
+        }
+    return MatrixFuture<Complex> (state, first, h, w);
+  }
 }
 
 
@@ -106,12 +106,12 @@ def PINVIT(mata, matm, pre, num=1, maxit=20, printrates=True, GramSchmidt=False)
         asmall = InnerProduct (vecs, mata * vecs)
         msmall = InnerProduct (vecs, matm * vecs)
     
-        ev,evec = scipy.linalg.eigh(a=asmall, b=msmall)
-        lams = Vector(ev[0:num])
+        ev,evec = asmall.SymmetricEigenSystem(msmall)
+        lams = ev[0:num]
         if printrates:
             print (i, ":", list(lams))
 
-        uvecs[:] = vecs * Matrix(evec[:,0:num])
+        uvecs[:] = vecs * evec[:,0:num]
     return lams, uvecs
 
 
@@ -28,6 +28,31 @@ void SetRandom (SliceVector<Complex> vec)
     vec(i) = Complex(5+ sin(3*i), cos(2*i) );
 }
 
+// P^{-1} L U from LUFactor, row i was exchanged with row p[i] in step i
+Matrix<> ExpandLU (SliceMatrix<> lu, FlatArray<int> p)
+{
+  int n = lu.Height();
+  Matrix<> l(n), u(n);
+  l = 0.0; u = 0.0;
+  for (int i = 0; i < n; i++)
+    {
+      for (int j = 0; j < i; j++)
+        l(i,j) = lu(i,j);
+      l(i,i) = 1;
+      for (int j = i; j < n; j++)
+        u(i,j) = lu(i,j);
+    }
+  Matrix<> a = l*u;
+  for (int i = n-1; i >= 0; i--)
+    if (p[i] != i)
+      {
+        Vector<> tmp = a.Row(i);
+        a.Row(i) = a.Row(p[i]);
+        a.Row(p[i]) = tmp;
+      }
+  return a;
+}
+
 
 TEST_CASE ("MatVec", "[ngblas]") {
     for (int n = 1; n < 20; n++) {
@@ -220,6 +245,324 @@ TEST_CASE ("SubAtDB", "[ngblas]") {
     }
 }
 
+
+TEST_CASE ("BatchedMultMatMat", "[ngblas]") {
+    for (int n : { 1, 3, 7, 15, 16, 20 }) {
+        SECTION ("n = "+to_string(n)) {
+            for (int nb : { 1, 5, 13 }) {
+                SECTION ("nb = "+to_string(nb)) {
+                    int m = n+1, k = max(n-1,1);
+                    Matrix<> a(nb*n,m), b(nb*m,k), c(nb*n,k);
+                    SetRandom(a);
+                    SetRandom(b);
+                    BatchedMultMatMat (BatchedSliceMatrix<>(nb, n, m, a.Data()),
+                                       BatchedSliceMatrix<>(nb, m, k, b.Data()),
+                                       BatchedSliceMatrix<>(nb, n, k, c.Data()));
+                    double err = 0;
+                    for (int l = 0; l < nb; l++)
+                        err += L2Norm (c.Rows(l*n, (l+1)*n) - a.Rows(l*n, (l+1)*n) * b.Rows(l*m, (l+1)*m));
+                    CHECK(err < 1e-12);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE ("BatchedAddABt", "[ngblas]") {
+    for (int n : { 1, 3, 7, 15, 16, 20 }) {
+        SECTION ("n = "+to_string(n)) {
+            for (int nb : { 1, 5, 13 }) {
+                SECTION ("nb = "+to_string(nb)) {
+                    int m = n+2;
+                    Matrix<> a(nb*n,m), b(nb*n,m), c(nb*n,n);
+                    SetRandom(a);
+                    SetRandom(b);
+                    SetRandom(c);
+                    Matrix<> c2 = c;
+                    Array<SliceMatrix<>> pa, pb, pc;
+                    for (int l = 0; l < nb; l++) {
+                        pa.Append (a.Rows(l*n, (l+1)*n));
+                        pb.Append (b.Rows(l*n, (l+1)*n));
+                        pc.Append (c.Rows(l*n, (l+1)*n));
+                    }
+                    BatchedAddABt (pa, pb, pc);
+                    double err = 0;
+                    for (int l = 0; l < nb; l++)
+                        err += L2Norm (pc[l] - c2.Rows(l*n, (l+1)*n) - pa[l] * Trans(pb[l]));
+                    CHECK(err < 1e-12);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE ("BatchedLU", "[ngblas]") {
+    for (int n : { 1, 3, 7, 15, 16, 20 }) {
+        SECTION ("n = "+to_string(n)) {
+            for (int nb : { 1, 5, 13 }) {
+                SECTION ("nb = "+to_string(nb)) {
+                    Matrix<> a(nb*n,n), x(nb*n,2);
+                    SetRandom(a);
+                    SetRandom(x);
+                    for (int l = 0; l < nb; l++)
+                        a.Rows(l*n, (l+1)*n) += 2*n*Identity(n);
+                    Matrix<> a2 = a, x2 = x, ainv = a;
+                    Array<int> pivots(nb*n);
+                    BatchedSliceMatrix<> ba(nb, n, n, a.Data()), bx(nb, n, 2, x.Data());
+                    BatchedLUFactor (ba, pivots);
+                    BatchedLUSolve (ba, pivots, bx);
+                    BatchedCalcInverse (BatchedSliceMatrix<>(nb, n, n, ainv.Data()));
+                    double err = 0, errinv = 0;
+                    for (int l = 0; l < nb; l++) {
+                        auto al = a2.Rows(l*n, (l+1)*n);
+                        err += L2Norm (al * bx[l] - x2.Rows(l*n, (l+1)*n));
+                        Matrix<> id = al * ainv.Rows(l*n, (l+1)*n);
+                        for (int i = 0; i < n; i++) id(i,i) -= 1;
+                        errinv += L2Norm (id);
+                    }
+                    CHECK(err < 1e-8);
+                    CHECK(errinv < 1e-8);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE ("BatchedLUPivoting", "[ngblas]") {
+    for (int n : { 2, 3, 7, 15, 16, 20, 40 }) {
+        SECTION ("n = "+to_string(n)) {
+            // zero leading entry, the pivot of the first column is in a different row per lane
+            int nb = 13;
+            Matrix<> a(nb*n,n);
+            SetRandom(a);
+            a *= 0.1;
+            for (int l = 0; l < nb; l++) {
+                int shift = 1 + l % (n-1);
+                for (int i = 0; i < n; i++)
+                    a(l*n+i, (i+shift)%n) += n;
+                a(l*n, 0) = 0;
+            }
+            Matrix<> a2 = a;
+            Array<int> pivots(nb*n);
+            BatchedLUFactor (BatchedSliceMatrix<>(nb, n, n, a.Data()), pivots);
+            double err = 0;
+            for (int l = 0; l < nb; l++)
+                CHECK(pivots[l*n] == n - 1 - l % (n-1));
+            for (int l = 0; l < nb; l++)
+                err += L2Norm (ExpandLU (a.Rows(l*n, (l+1)*n), pivots.Range(l*n, (l+1)*n))
+                               - a2.Rows(l*n, (l+1)*n));
+            CHECK(err < 1e-10 * n);
+        }
+    }
+}
+
+TEST_CASE ("BatchedCholesky", "[ngblas]") {
+    for (int n : { 1, 3, 7, 15, 16, 20 }) {
+        SECTION ("n = "+to_string(n)) {
+            for (int nb : { 1, 5, 13 }) {
+                SECTION ("nb = "+to_string(nb)) {
+                    Matrix<> b(nb*n,n), a(nb*n,n), x(nb*n,3);
+                    SetRandom(b);
+                    SetRandom(x);
+                    for (int l = 0; l < nb; l++) {
+                        auto bl = b.Rows(l*n, (l+1)*n);
+                        a.Rows(l*n, (l+1)*n) = bl * Trans(bl) + Identity(n);
+                    }
+                    Matrix<> a2 = a, x2 = x;
+                    Array<SliceMatrix<>> pa, px;
+                    for (int l = 0; l < nb; l++) {
+                        pa.Append (a.Rows(l*n, (l+1)*n));
+                        px.Append (x.Rows(l*n, (l+1)*n));
+                    }
+                    BatchedCholeskyFactor (pa);
+                    BatchedCholeskySolve (pa, px);
+                    double err = 0;
+                    for (int l = 0; l < nb; l++)
+                        err += L2Norm (a2.Rows(l*n, (l+1)*n) * px[l] - x2.Rows(l*n, (l+1)*n));
+                    CHECK(err < 1e-8);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE ("DenseFactor", "[ngblas]") {
+    for (int n : { 1, 5, 17, 50, 130, 300 }) {
+        SECTION ("n = "+to_string(n)) {
+            Matrix<> a(n), x(n,3);
+            SetRandom(a);
+            SetRandom(x);
+            a += 2*n*Identity(n);
+            Matrix<> x2 = x;
+
+            SECTION ("LU") {
+                Matrix<> lu = a, inv = a;
+                Array<int> p(n);
+                LUFactor (lu, p);
+                LUSolve (lu, p, x);
+                CHECK(L2Norm (a*x-x2) < 1e-10);
+
+                LUInverse (inv);
+                Matrix<> id = a*inv - Identity(n);
+                CHECK(L2Norm (id) < 1e-10);
+            }
+
+            SECTION ("Cholesky") {
+                Matrix<> spd = a * Trans(a);
+                Matrix<> l = spd;
+                CholeskyFactor (l);
+                CholeskySolve (l, x);
+                CHECK(L2Norm (spd*x-x2) < 1e-8 * L2Norm(x2));
+            }
+        }
+    }
+}
+
+TEST_CASE ("DenseFactorPivoting", "[ngblas]") {
+    for (int n : { 64, 130, 300 }) {
+        SECTION ("n = "+to_string(n)) {
+            // random with a small diagonal: rows are exchanged across the recursion splits
+            Matrix<> a(n), x(n,3);
+            unsigned int seed = 1;
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++) {
+                    seed = 1103515245*seed + 12345;
+                    a(i,j) = double((seed >> 16) & 0x7fff) / 0x7fff - 0.5;
+                }
+            for (int i = 0; i < n; i++)
+                a(i,i) *= 1e-3;
+            SetRandom(x);
+            Matrix<> x2 = x, lu = a;
+            Array<int> p(n);
+            LUFactor (lu, p);
+
+            bool crossing = false;
+            for (int i = 0; i < n/2; i++)
+                if (p[i] >= n/2) crossing = true;
+            CHECK(crossing);
+            CHECK(L2Norm (ExpandLU (lu, p) - a) < 1e-12 * n * L2Norm(a));
+
+            LUSolve (lu, p, x);
+            CHECK(L2Norm (a*x-x2) < 1e-12 * n * L2Norm(a) * L2Norm(x));
+        }
+    }
+}
+
+TEST_CASE ("SymmetricEigenSystem", "[ngblas]") {
+    for (int n : { 1, 7, 31, 33, 100, 257 }) {
+        SECTION ("n = "+to_string(n)) {
+            Matrix<> a(n,n), b(n,n), ha(n,n), hb(n,n), evecs(n,n);
+            Vector<> lami(n);
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j <= i; j++) {
+                    a(i,j) = a(j,i) = sin(1+3*i+5*j) + sin(2+5*i+3*j);
+                    b(i,j) = b(j,i) = (i == j) ? 4 : (i == j+1) ? 1 : 0;
+                }
+
+            ha = a;
+            SymmetricEigenSystem (ha, lami, evecs);
+            for (int i = 1; i < n; i++)
+                CHECK(lami(i-1) <= lami(i));
+            Matrix<> res = a*evecs;
+            for (int i = 0; i < n; i++)
+                res.Col(i) -= lami(i) * evecs.Col(i);
+            CHECK(L2Norm (res) < 1e-12 * n);
+            CHECK(L2Norm (Trans(evecs)*evecs - Identity(n)) < 1e-12 * n);
+
+            // repeated eigenvalues
+            ha = 1.0;
+            SymmetricEigenSystem (ha, lami, evecs);
+            CHECK(fabs(lami(n-1)-n) < 1e-12 * n);
+            CHECK(L2Norm (Trans(evecs)*evecs - Identity(n)) < 1e-12 * n);
+
+            ha = a;
+            hb = b;
+            SymmetricEigenSystem (ha, hb, lami, evecs);
+            res = a*evecs;
+            Matrix<> bevecs = b*evecs;
+            for (int i = 0; i < n; i++)
+                res.Col(i) -= lami(i) * bevecs.Col(i);
+            CHECK(L2Norm (res) < 1e-11 * n);
+            CHECK(L2Norm (Trans(evecs)*b*evecs - Identity(n)) < 1e-12 * n);
+        }
+    }
+}
+
+TEST_CASE ("MultAddCSR", "[ngblas]") {
+    for (int n : { 1, 5, 17, 100 }) {
+        SECTION ("n = "+to_string(n)) {
+            // dense matrix, rows of different lengths in CSR format
+            Matrix<> a(n,n);
+            a = 0.0;
+            Array<size_t> firsti(n+1);
+            Array<int> colnr;
+            Array<double> val;
+            firsti[0] = 0;
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j += 1+i%4) {
+                    a(i,j) = sin(2+3*i+5*j);
+                    colnr.Append(j);
+                    val.Append(a(i,j));
+                }
+                firsti[i+1] = colnr.Size();
+            }
+            Vector<> x(n), y(n), y2(n);
+            SetRandom(x);
+            SetRandom(y);
+            y2 = y + 0.7 * a * x;
+            MultAddCSR (0.7, IntRange(0,n), firsti.Data(), colnr.Data(), val.Data(), x.Data(), y.Data());
+            CHECK(L2Norm (y-y2) < 1e-13 * n);
+            CHECK(GetKernelArch() != "");
+        }
+    }
+}
+
+// ctest runs this with NGS_BLAS_ARCH set to every arch in NGS_ARCH_KERNELS
+TEST_CASE ("KernelArch", "[ngblas]") {
+    const char * env = getenv ("NGS_BLAS_ARCH");
+    if (!env) return;
+    string arch = env;
+    int level = arch == "avx512" ? 2 : arch == "avx2" ? 1 : 0;
+    // the request is clamped to the instruction sets of the CPU
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (level == 2 && !(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                        __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw")))
+        level = 1;
+    if (level == 1 && !(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")))
+        level = 0;
+#endif
+    const char * names[] = { "default", "avx2", "avx512" };
+    // no module is loaded if the core library is built for the requested level
+#if defined(__AVX512F__)
+    int compiled = 2;
+#elif defined(__AVX2__)
+    int compiled = 1;
+#else
+    int compiled = 0;
+#endif
+    CHECK(GetKernelArch() == string(level > compiled ? names[level] : "default"));
+
+    for (int n : {1, 7, 31, 100}) {
+        SECTION ("n = "+to_string(n)) {
+            Matrix<> a(n,n+3), b(n+3,n), c(n,n), cref(n,n);
+            SetRandom(a);
+            SetRandom(b);
+            Matrix<> bt = Trans(b);
+            cref = 0.0;
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++)
+                    for (int k = 0; k < n+3; k++)
+                        cref(i,j) += a(i,k)*b(k,j);
+            MultMatMat (a, b, c);
+            CHECK(L2Norm(c-cref) < 1e-12 * n*n);
+            c = 0.0;
+            AddABt (a, bt, c);
+            CHECK(L2Norm(c-cref) < 1e-12 * n*n);
+        }
+    }
+}
+
 template <int N=SIMD<double>::Size()>
 void TestSIMD()
 {
@@ -0,0 +1,42 @@
+from ngsolve import *
+from ngsolve.la import SetAgglomerationRanks, GetAgglomerationStatistics
+
+
+def test_agglomerated_inverse():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=2, dirichlet=".*")
+    u,v = fes.TnT()
+    a = BilinearForm(fes, symmetric=True)
+    a += grad(u)*grad(v)*dx
+    a.Assemble()
+    f = LinearForm(fes)
+    f += v*dx
+    f.Assemble()
+
+    gfm = GridFunction(fes)
+    gfm.vec.data = a.mat.Inverse(fes.FreeDofs(), inverse="masterinverse") * f.vec
+
+    stats = {}
+    for nagg in [0, 2, comm.size]:
+        SetAgglomerationRanks(nagg)
+        gfa = GridFunction(fes)
+        gfa.vec.data = a.mat.Inverse(fes.FreeDofs(), inverse="agglomeratedinverse") * f.vec
+        gfa.vec.data -= gfm.vec
+        assert Norm(gfa.vec) < 1e-10 * Norm(gfm.vec)
+        stats[nagg] = GetAgglomerationStatistics()
+    SetAgglomerationRanks(0)
+
+    # all agglomeration ranks do the same work, rank 0 is no root collecting
+    # more with more agglomeration ranks
+    for nagg in [2, comm.size]:
+        st = stats[nagg]
+        for key in st:
+            maxval = comm.Max(st[key])
+            if st["factor_dofs"] > 0:
+                assert st[key] == maxval
+        if comm.rank == 0:
+            for key in st:
+                assert st[key] == stats[2][key]
+
+    comm.Barrier()
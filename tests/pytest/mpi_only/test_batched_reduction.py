@@ -0,0 +1,38 @@
+from ngsolve import *
+from ngsolve.la import BatchedInnerProducts
+
+
+def test_batched_inner_products():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=2)
+
+    u = GridFunction(fes)
+    v = GridFunction(fes)
+    u.Set(x*y+1)
+    v.Set(x-y)
+    ud = u.vec.CreateVector()
+    ud.data = u.vec
+    ud.Distribute()
+
+    batch = BatchedInnerProducts()
+    f1 = batch.InnerProduct(u.vec, v.vec)
+    f2 = batch.InnerProduct(ud, v.vec)
+    f3 = batch.Norm(ud)
+    batch.Start()
+    ref = InnerProduct(u.vec, v.vec)
+    assert abs(f1.Get() - ref) < 1e-12 * abs(ref)
+    assert abs(f2.Get() - ref) < 1e-12 * abs(ref)
+    assert abs(f3.Get() - Norm(u.vec)) < 1e-12 * Norm(u.vec)
+
+    # MultiVector products with a single reduction
+    mv = MultiVector(u.vec, 3)
+    mv[0].data = u.vec
+    mv[1].data = v.vec
+    mv[2].data = ud
+    ip = InnerProduct(mv, mv)
+    for i in range(3):
+        for j in range(3):
+            assert abs(ip[i,j] - InnerProduct(mv[i], mv[j])) < 1e-12 * Norm(mv[i]) * Norm(mv[j])
+
+    comm.Barrier()
@@ -0,0 +1,31 @@
+from ngsolve import *
+
+
+def test_checkpoint():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=3)
+    gf = GridFunction(fes)
+    gf.Set(x*x*y+sin(3*x))
+
+    stat = gf.SaveCheckpoint('gf_checkpoint.dat')
+    assert stat["bytes"] > 0
+
+    # restart on the same number of ranks
+    gf2 = GridFunction(fes)
+    gf2.LoadCheckpoint('gf_checkpoint.dat')
+    gf2.vec.data -= gf.vec
+    assert Norm(gf2.vec) < 1e-14 * Norm(gf.vec)
+
+    # restart on a single rank
+    if comm.rank == 0:
+        seqmesh = Mesh('square.vol.gz')
+        seqfes = H1(seqmesh, order=3)
+        seqgf = GridFunction(seqfes)
+        seqgf.LoadCheckpoint('gf_checkpoint.dat')
+        refgf = GridFunction(seqfes)
+        refgf.Set(x*x*y+sin(3*x))
+        refgf.vec.data -= seqgf.vec
+        assert Norm(refgf.vec) < 1e-10 * Norm(seqgf.vec)
+
+    comm.Barrier()
@@ -0,0 +1,38 @@
+from ngsolve import *
+
+
+def test_overlapped_cumulate():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=3)
+    u,v = fes.TnT()
+    a = BilinearForm(fes)
+    a += (grad(u)*grad(v) + u*v) * dx
+    a.Assemble()
+
+    gf = GridFunction(fes)
+    gf.Set(x*y+x)
+
+    # cumulated input: plain mat x vec
+    y1 = gf.vec.CreateVector()
+    y1.data = a.mat * gf.vec
+
+    # distributed input: exchange overlaps with interior rows
+    xd = gf.vec.CreateVector()
+    xd.data = gf.vec
+    xd.Distribute()
+    y2 = gf.vec.CreateVector()
+    y2.data = a.mat * xd
+    assert xd.GetParallelStatus() == PARALLEL_STATUS.CUMULATED
+
+    y1 -= y2
+    assert Norm(y1) < 1e-12 * Norm(y2)
+
+    # split-phase cumulate
+    xd.Distribute()
+    xd.StartCumulate()
+    xd.FinishCumulate()
+    xd -= gf.vec
+    assert Norm(xd) < 1e-12 * Norm(gf.vec)
+
+    comm.Barrier()
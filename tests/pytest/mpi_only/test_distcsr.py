@@ -0,0 +1,29 @@
+from ngsolve import *
+
+
+def test_distributed_csr():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=2)
+    u,v = fes.TnT()
+    for symmetric in [False, True]:
+        a = BilinearForm(fes, symmetric=symmetric)
+        a += (grad(u)*grad(v) + u*v) * dx
+        a.Assemble()
+
+        dmat = a.mat.ToDistributedCSR()
+        assert comm.Sum(len(dmat.owned_dofs)) == dmat.nglobal
+        vals, cols, rowptr = dmat.CSR()
+        assert len(rowptr) == len(dmat.owned_dofs)+1
+        assert len(vals) == len(cols) == rowptr[len(rowptr)-1]
+
+        gf = GridFunction(fes)
+        gf.Set(x*y+x)
+        y1 = gf.vec.CreateVector()
+        y2 = gf.vec.CreateVector()
+        y1.data = a.mat * gf.vec
+        y2.data = dmat * gf.vec
+        y1 -= y2
+        assert Norm(y1) < 1e-12 * Norm(y2)
+
+    comm.Barrier()
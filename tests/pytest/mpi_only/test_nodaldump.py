@@ -0,0 +1,29 @@
+import struct
+from ngsolve import *
+
+
+def test_nodaldump():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=1)
+    gf = GridFunction(fes)
+    gf.Set(x+2*y)
+
+    n = gf.WriteNodalValues('gf_nodal.dat')
+    assert n == fes.ndofglobal
+
+    # keys are global vertex numbers, compare with the sequential mesh
+    if comm.rank == 0:
+        seqmesh = Mesh('square.vol.gz')
+        with open('gf_nodal.dat', 'rb') as f:
+            magic, nfile, keysize, valsize = struct.unpack('<8sqii', f.read(24))
+            assert magic == b'NGSNODAL' and nfile == n
+            assert keysize == 4 and valsize == 8
+            records = [struct.unpack('<id', f.read(12)) for i in range(nfile)]
+        keys = [k for k,v in records]
+        assert keys == sorted(keys) and len(set(keys)) == n == seqmesh.nv
+        for k,v in records:
+            px,py = seqmesh.vertices[k].point
+            assert abs(v - (px+2*py)) < 1e-12
+
+    comm.Barrier()
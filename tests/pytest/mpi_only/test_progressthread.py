@@ -0,0 +1,40 @@
+from ngsolve import *
+from ngsolve.la import StartMPIProgressThread, StopMPIProgressThread, MPIProgressThreadRunning, BatchedInnerProducts
+
+
+def test_progress_thread():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=2)
+    u,v = fes.TnT()
+    a = BilinearForm(fes)
+    a += (grad(u)*grad(v) + u*v) * dx
+    a.Assemble()
+
+    gf = GridFunction(fes)
+    gf.Set(x*y+x)
+    xd = gf.vec.CreateVector()
+    xd.data = gf.vec
+    xd.Distribute()
+
+    y1 = gf.vec.CreateVector()
+    y1.data = a.mat * xd
+    xd.data = gf.vec
+    xd.Distribute()
+
+    StartMPIProgressThread()
+    assert MPIProgressThreadRunning()
+    try:
+        y2 = gf.vec.CreateVector()
+        y2.data = a.mat * xd
+        batch = BatchedInnerProducts()
+        f = batch.Norm(y2)
+        batch.Start()
+        assert abs(f.Get() - Norm(y1)) < 1e-12 * Norm(y1)
+    finally:
+        StopMPIProgressThread()
+    assert not MPIProgressThreadRunning()
+
+    y1 -= y2
+    assert Norm(y1) < 1e-12 * Norm(y2)
+    comm.Barrier()
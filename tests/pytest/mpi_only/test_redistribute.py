@@ -0,0 +1,43 @@
+from ngsolve import *
+
+
+def test_pardofs_statistics():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=2)
+    stat = fes.ParallelDofs().Statistics()
+    assert comm.Sum(stat["nmaster"]) == fes.ndofglobal
+    assert stat["total_messages"] == comm.Sum(stat["nneighbors"])
+    assert stat["total_bytes"] == comm.Sum(stat["cumulate_bytes"])
+    assert stat["imbalance"] >= 1
+    comm.Barrier()
+
+
+def test_redistribute():
+    comm = MPI_Init()
+    mesh = Mesh('square.vol.gz', comm)
+    fes = H1(mesh, order=2)
+    pardofs = fes.ParallelDofs()
+    globnums, nglob = pardofs.EnumerateGlobally()
+
+    # round robin by global number
+    redist = pardofs.Redistribute([g % comm.size for g in globnums])
+    newstat = redist.new_pardofs.Statistics()
+    assert newstat["nshared"] == 0 and newstat["total_messages"] == 0
+    assert newstat["max_master"] - newstat["min_master"] <= 1
+
+    gf = GridFunction(fes)
+    gf.Set(x*y+x)
+    vnew = redist.CreateColVector()
+    vnew.data = redist * gf.vec
+    assert abs(Norm(vnew) - Norm(gf.vec)) < 1e-12 * Norm(gf.vec)
+
+    vback = gf.vec.CreateVector()
+    vback.data = redist.T * vnew
+    vback -= gf.vec
+    assert Norm(vback) < 1e-12 * Norm(gf.vec)
+
+    # everything to rank 0
+    redist0 = pardofs.Redistribute([0] * pardofs.ndoflocal)
+    assert redist0.new_pardofs.ndoflocal == (nglob if comm.rank == 0 else 0)
+    comm.Barrier()
@@ -0,0 +1,51 @@
+import pytest
+from ngsolve import *
+from netgen.geom2d import unit_square
+from netgen.csg import unit_cube
+
+
+def _apply(mat, vec):
+    y = vec.CreateVector()
+    y.data = mat * vec
+    return y
+
+
+@pytest.mark.parametrize("symmetric", [False, True])
+def test_complex_element_matrices(symmetric):
+    # complex coefficients on complex spaces: real proxy values times complex
+    # D-matrices (real*complex kernels), on the element boundary the complex
+    # factor comes first (complex*real kernels)
+    for mesh in [Mesh(unit_square.GenerateMesh(maxh=0.3)), Mesh(unit_cube.GenerateMesh(maxh=0.5))]:
+        fes = H1(mesh, order=4)
+        u,v = fes.TnT()
+        forms = []
+        for integrand in [grad(u)*grad(v)*dx, u*v*dx, u*v*dx(element_boundary=True)]:
+            f = BilinearForm(fes, symmetric=symmetric)
+            f += integrand
+            f.Assemble()
+            forms.append(f)
+
+        gf = GridFunction(fes)
+        gf.vec.SetRandom()
+        kx, mx, ebx = [_apply(f.mat, gf.vec) for f in forms]
+
+        alpha, beta, gamma = 1+2j, 3-1j, -2+0.5j
+        fesc = H1(mesh, order=4, complex=True)
+        uc,vc = fesc.TnT()
+        gfc = GridFunction(fesc)
+        for i in range(len(gf.vec)):
+            gfc.vec[i] = gf.vec[i]
+        for cf in [alpha, CoefficientFunction(alpha)]:
+            a = BilinearForm(fesc, symmetric=symmetric)
+            a += cf*grad(uc)*grad(vc)*dx + beta*uc*vc*dx
+            a += gamma*uc*vc*dx(element_boundary=True)
+            a.Assemble()
+            y = _apply(a.mat, gfc.vec)
+            ref = [alpha*a1 + beta*b1 + gamma*c1 for a1,b1,c1 in zip(kx, mx, ebx)]
+            err = max(abs(y1-r1) for y1,r1 in zip(y, ref))
+            assert err < 1e-10 * max(abs(r1) for r1 in ref)
+
+
+if __name__ == "__main__":
+    test_complex_element_matrices(False)
+    test_complex_element_matrices(True)
@@ -99,9 +99,72 @@ def test_SurfaceGetFE(quads=False):
                         assert space.GetFE(el).ndof == len(space.GetDofNrs(el)), [spacename,vb,order]
     return
 
+def test_interpolation_operator():
+    mesh = Mesh(unit_square.GenerateMesh(maxh=0.2))
+    t = Parameter(0)
+    for fes, cf in [(H1(mesh, order=3), x**3+t*x*y),
+                    (VectorH1(mesh, order=2), CoefficientFunction((x*y, t*y*y))),
+                    (HCurl(mesh, order=2), CoefficientFunction((y*y, t*x)))]:
+        interpol = InterpolationOperator(fes)
+        gfu = GridFunction(fes)
+        gfref = GridFunction(fes)
+        for tval in [0, 1, 2]:
+            t.Set(tval)
+            interpol.Set(cf, gfu)
+            gfref.Set(cf)
+            gfref.vec.data -= gfu.vec
+            assert Norm(gfref.vec) < 1e-10
+            assert sqrt(Integrate(InnerProduct(gfu-cf, gfu-cf), mesh)) < 1e-10
+    # affine triangles share few inverse mass matrices
+    assert InterpolationOperator(H1(mesh, order=3)).ninverses <= 6
+
+def test_interpolation_operator_refined():
+    # refined elements have equal measures but differently mapped shapes
+    mesh = Mesh(unit_square.GenerateMesh(maxh=0.3))
+    mesh.Refine()
+    varorder = H1(mesh, order=2)
+    for el in mesh.Elements(VOL):
+        if el.nr % 2:
+            varorder.SetOrder(NodeId(FACE, el.nr), 3)
+    varorder.Update()
+    for fes, cf in [(HCurl(mesh, order=2), CoefficientFunction((y*y, x*y))),
+                    (HDiv(mesh, order=2), CoefficientFunction((x*x, x*y))),
+                    (varorder, x*x-y)]:
+        gfu = GridFunction(fes)
+        InterpolationOperator(fes).Set(cf, gfu)
+        assert sqrt(Integrate(InnerProduct(gfu-cf, gfu-cf), mesh)) < 1e-10
+
+def test_transfer_operator():
+    mesha = Mesh(unit_square.GenerateMesh(maxh=0.2))
+    meshb = Mesh(unit_square.GenerateMesh(maxh=0.13))
+    cf = x*x-2*x*y+y
+    fesa = H1(mesha, order=2)
+    gfa = GridFunction(fesa)
+    gfa.Set(cf)
+
+    # same mesh, compared to Set
+    fesl2 = L2(mesha, order=3)
+    gfl2 = GridFunction(fesl2)
+    gfref = GridFunction(fesl2)
+    gfref.Set(gfa)
+    gfl2.vec.data = TransferOperator(fesa, fesl2) * gfa.vec
+    gfref.vec.data -= gfl2.vec
+    assert Norm(gfref.vec) < 1e-10
+
+    # different meshes, quadratics are transferred exactly
+    fesb = H1(meshb, order=2)
+    gfb = GridFunction(fesb)
+    trans = TransferOperator(fesa, fesb)
+    assert trans.height == fesb.ndof and trans.width == fesa.ndof
+    assert sum(m[1] for m in trans.__memory__) > 0
+    gfb.vec.data = trans * gfa.vec
+    assert sqrt(Integrate((gfb-cf)**2, meshb)) < 1e-10
+
 if __name__ == "__main__":
     test_2DGetFE(quads=False)
     test_2DGetFE(quads=True)
     test_3DGetFE()
     test_SurfaceGetFE(quads=False)
     test_SurfaceGetFE(quads=True)
+    test_interpolation_operator()
+    test_transfer_operator()
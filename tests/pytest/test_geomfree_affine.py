@@ -0,0 +1,58 @@
+import pytest
+from ngsolve import *
+from netgen.geom2d import unit_square
+from netgen.csg import unit_cube
+
+
+def _compare(fes, form):
+    u,v = fes.TnT()
+
+    a = BilinearForm(fes)
+    a += form(u,v) * dx
+    a.Assemble()
+
+    agf = BilinearForm(fes, geom_free_affine=True)
+    agf += form(u,v) * dx
+    agf.Assemble()
+
+    gf = GridFunction(fes)
+    gf.vec.SetRandom()
+    y1 = gf.vec.CreateVector()
+    y2 = gf.vec.CreateVector()
+
+    y1.data = a.mat * gf.vec
+    y2.data = agf.mat * gf.vec
+    y1 -= y2
+    assert Norm(y1) < 1e-10 * Norm(y2)
+
+    y1.data = a.mat.T * gf.vec
+    y2.data = agf.mat.T * gf.vec
+    y1 -= y2
+    assert Norm(y1) < 1e-10 * Norm(y2)
+
+
+def test_geomfree_affine_laplace():
+    mesh = Mesh(unit_square.GenerateMesh(maxh=0.2))
+    b = CoefficientFunction((1,0.5))
+    for order in [1,3]:
+        fes = H1(mesh, order=order)
+        _compare(fes, lambda u,v : 2*grad(u)*grad(v) + (b*grad(u))*v + u*v)
+
+
+def test_geomfree_affine_elasticity():
+    mesh = Mesh(unit_cube.GenerateMesh(maxh=0.4))
+    fes = VectorH1(mesh, order=2)
+    eps = lambda u : 0.5*(Grad(u)+Grad(u).trans)
+    _compare(fes, lambda u,v : 2*InnerProduct(eps(u),eps(v)) + div(u)*div(v))
+
+
+def test_geomfree_affine_hcurl():
+    mesh = Mesh(unit_cube.GenerateMesh(maxh=0.4))
+    fes = HCurl(mesh, order=2)
+    _compare(fes, lambda u,v : curl(u)*curl(v) + u*v)
+
+
+if __name__ == "__main__":
+    test_geomfree_affine_laplace()
+    test_geomfree_affine_elasticity()
+    test_geomfree_affine_hcurl()
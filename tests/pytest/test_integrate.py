@@ -25,3 +25,24 @@ def test_integrate_xy():
     intC = Integrate(1j*x*y,mesh)
     assert abs(intR-1./4) < 1e-14
     assert abs(intC- 1j*1./4) < 1e-14
+
+def test_multi_linearform():
+    mesh = Mesh(unit_square.GenerateMesh(maxh=0.2))
+    fes = H1(mesh, order=3)
+    v = fes.TestFunction()
+    coefs = [x*i+y for i in range(5)]
+    gradcoefs = [CoefficientFunction((y, i*x)) for i in range(5)]
+    with TaskManager():
+        rhs = AssembleMultiLinearForm(fes, coefs)
+        gradrhs = AssembleMultiLinearForm(fes, gradcoefs, test=grad(v))
+        bndrhs = AssembleMultiLinearForm(fes, coefs, definedon=mesh.Boundaries("left|right"))
+    assert len(rhs) == 5
+    for i in range(5):
+        for res, lfi in [(rhs, coefs[i]*v*dx),
+                         (gradrhs, gradcoefs[i]*grad(v)*dx),
+                         (bndrhs, coefs[i]*v*ds(definedon=mesh.Boundaries("left|right")))]:
+            f = LinearForm(fes)
+            f += lfi
+            f.Assemble()
+            f.vec.data -= res[i]
+            assert Norm(f.vec) < 1e-12
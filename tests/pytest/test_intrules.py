@@ -0,0 +1,78 @@
+import pytest
+from math import factorial
+from ngsolve import *
+from ngsolve.fem import MaxSymmetricIntegrationOrder
+from netgen.geom2d import unit_square
+from netgen.csg import unit_cube
+
+
+def _exact(exps):
+    # integral of prod x_i^e_i over the reference simplex
+    val = 1.
+    for e in exps:
+        val *= factorial(e)
+    return val / factorial(sum(exps)+len(exps))
+
+
+def test_symmetric_trig_rules():
+    for order in range(MaxSymmetricIntegrationOrder(TRIG)+1):
+        ir = IntegrationRule(TRIG, order, IntegrationRuleType.SYMMETRIC)
+        if order >= 7:  # standard rules are collapsed Gauss-Jacobi rules
+            assert len(ir) < len(IntegrationRule(TRIG, order, IntegrationRuleType.STANDARD))
+        assert min(ir.weights) > 0
+        for i in range(order+1):
+            for j in range(order+1-i):
+                val = ir.Integrate(lambda x,y : x**i * y**j)
+                assert abs(val - _exact([i,j])) < 1e-12
+
+
+def test_symmetric_tet_rules():
+    for order in range(MaxSymmetricIntegrationOrder(TET)+1):
+        ir = IntegrationRule(TET, order, IntegrationRuleType.SYMMETRIC)
+        if order >= 6:
+            assert len(ir) < len(IntegrationRule(TET, order, IntegrationRuleType.STANDARD))
+        assert min(ir.weights) > 0
+        for i in range(order+1):
+            for j in range(order+1-i):
+                for k in range(order+1-i-j):
+                    val = ir.Integrate(lambda x,y,z : x**i * y**j * z**k)
+                    assert abs(val - _exact([i,j,k])) < 1e-12
+
+
+def _assemble(fes, **kwargs):
+    u,v = fes.TnT()
+    a = BilinearForm(fes)
+    a += (grad(u)*grad(v) + u*v) * dx(**kwargs)
+    a.Assemble()
+    return a.mat
+
+
+def test_symmetric_rules_assembly():
+    for mesh in [Mesh(unit_square.GenerateMesh(maxh=0.3)), Mesh(unit_cube.GenerateMesh(maxh=0.5))]:
+        fes = H1(mesh, order=3)
+        mstd = _assemble(fes)
+        msym = _assemble(fes, intrule_type=IntegrationRuleType.SYMMETRIC)
+
+        gf = GridFunction(fes)
+        gf.vec.SetRandom()
+        y1 = gf.vec.CreateVector()
+        y2 = gf.vec.CreateVector()
+        y1.data = mstd * gf.vec
+        y2.data = msym * gf.vec
+        y1 -= y2
+        assert Norm(y1) < 1e-10 * Norm(y2)
+
+        # global setting
+        SetIntegrationRuleType(IntegrationRuleType.SYMMETRIC)
+        try:
+            y1.data = _assemble(fes) * gf.vec
+        finally:
+            SetIntegrationRuleType(IntegrationRuleType.STANDARD)
+        y1 -= y2
+        assert Norm(y1) < 1e-10 * Norm(y2)
+
+
+if __name__ == "__main__":
+    test_symmetric_trig_rules()
+    test_symmetric_tet_rules()
+    test_symmetric_rules_assembly()
@@ -0,0 +1,73 @@
+import pytest
+from ngsolve import *
+from netgen.geom2d import unit_square
+from netgen.csg import CSGeometry, Sphere, Pnt
+
+
+def test_pooled_mapping():
+    # curved mesh: pooled rules must be re-mapped element by element
+    geo = CSGeometry()
+    geo.Add(Sphere(Pnt(0,0,0), 1))
+    mesh = Mesh(geo.GenerateMesh(maxh=0.5))
+    mesh.Curve(3)
+
+    fes = H1(mesh, order=2)
+    u,v = fes.TnT()
+    a = BilinearForm(fes)
+    a += u*v*dx + u*v*ds
+    a.Assemble()
+    f = LinearForm(fes)
+    f += v*dx
+    f.Assemble()
+
+    gf = GridFunction(fes)
+    gf.Set(1)
+    y = gf.vec.CreateVector()
+    y.data = a.mat * gf.vec
+    vol = Integrate(1, mesh, order=4)
+    surf = Integrate(1, mesh, BND, order=4)
+    assert abs(InnerProduct(y, gf.vec) - (vol+surf)) < 1e-10 * (vol+surf)
+    assert abs(InnerProduct(f.vec, gf.vec) - vol) < 1e-10 * vol
+
+
+def test_heap_highwater():
+    mesh = Mesh(unit_square.GenerateMesh(maxh=0.2))
+    fes = H1(mesh, order=4)
+    u,v = fes.TnT()
+    a = BilinearForm(fes)
+    a += grad(u)*grad(v)*dx
+    a.Assemble()
+    bfi = a.integrators[0]
+    used = bfi.heap_highwater
+    assert used > 0
+
+    bfi.ResetHeapHighWater()
+    assert bfi.heap_highwater == 0
+    a.Assemble()
+    assert bfi.heap_highwater == used
+
+
+def test_heap_highwater_all_paths():
+    # non-SIMD, boundary and element-boundary integrators record as well
+    mesh = Mesh(unit_square.GenerateMesh(maxh=0.2))
+    fes = H1(mesh, order=3)
+    u,v = fes.TnT()
+    for integrand, simd in [(grad(u)*grad(v)*dx, False),
+                            (u*v*ds, True), (u*v*ds, False),
+                            (u*v*dx(element_boundary=True), True)]:
+        a = BilinearForm(fes)
+        a += integrand
+        a.integrators[0].simd_evaluate = simd
+        a.Assemble()
+        assert a.integrators[0].heap_highwater > 0
+    f = LinearForm(fes)
+    f += v*ds
+    f.integrators[0].simd_evaluate = False
+    f.Assemble()
+    assert f.integrators[0].heap_highwater > 0
+
+
+if __name__ == "__main__":
+    test_pooled_mapping()
+    test_heap_highwater()
+    test_heap_highwater_all_paths()
@@ -99,7 +99,29 @@ def test_sparsematrix_access():
     a.Assemble()
     assert abs(a.mat[1,1][0,0] - (reference_values[3])) < 1e-8
 
+def test_parallel_matmat():
+    # above the thresholds of the multithreaded ngblas paths:
+    # n*k*m >= 1e7 for matmat, n*k >= 1e6 and n >= 512 for matvec
+    n, m, k = 2000, 200, 600
+    a = Matrix(n, k)
+    b = Matrix(k, m)
+    x = Vector(k)
+    a.NumPy()[:] = np.sin(np.arange(n*k)).reshape(n,k)
+    b.NumPy()[:] = np.cos(np.arange(k*m)).reshape(k,m)
+    x.NumPy()[:] = np.sin(np.arange(k))
+
+    c = a*b
+    y = a*x
+    with TaskManager():
+        cpar = a*b
+        ypar = a*x
+    assert np.linalg.norm(c.NumPy()-a.NumPy()@b.NumPy()) < 1e-10 * np.linalg.norm(c.NumPy())
+    assert np.linalg.norm(cpar.NumPy()-c.NumPy()) < 1e-12 * np.linalg.norm(c.NumPy())
+    assert np.linalg.norm(ypar.NumPy()-y.NumPy()) < 1e-12 * np.linalg.norm(y.NumPy())
+
+
 if __name__ == "__main__":
     test_matrix()
     test_matrix_numpy()
     test_sparsematrix_access()
+    test_parallel_matmat()
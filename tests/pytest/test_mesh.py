@@ -1,3 +1,4 @@
+import pytest
 from ngsolve import *
 from netgen.csg import *
 ngsglobals.msg_level = 0
@@ -18,3 +19,61 @@ def test_call_operator_with_vectorization():
     mesh = Mesh(unit_cube.GenerateMesh(maxh=1))
     p = mesh(0.5,0.5,0.5)
     p2 = mesh([0.5, 0.1],0.5,0.5)
+
+def test_geometry_cache():
+    geo = CSGeometry()
+    geo.Add(Sphere(Pnt(0,0,0),1))
+    mesh = Mesh(geo.GenerateMesh(maxh=0.5))
+    mesh.Curve(4)
+
+    fes = H1(mesh, order=3)
+    u,v = fes.TnT()
+    a = BilinearForm(fes, nonassemble=True)
+    a += grad(u)*grad(v)*dx
+    a.Assemble()
+
+    gfu = GridFunction(fes)
+    gfu.Set(x*y+z)
+    y1 = gfu.vec.CreateVector()
+    y2 = gfu.vec.CreateVector()
+    y1.data = a.mat * gfu.vec
+
+    mesh.SetGeometryCache()
+    for i in range(2):
+        y2.data = a.mat * gfu.vec
+        y2 -= y1
+        assert Norm(y2) < 1e-12 * Norm(y1)
+    assert mesh.geometrycache_memory > 0
+
+    mesh.InvalidateGeometryCache()
+    assert mesh.geometrycache_memory == 0
+    mesh.SetGeometryCache(0)
+
+def test_locate_points():
+    import numpy as np
+    mesh = Mesh(unit_cube.GenerateMesh(maxh=0.3))
+    fes = H1(mesh, order=2)
+    gfu = GridFunction(fes)
+    gfu.Set(x*x+y-z)
+
+    rng = np.random.default_rng(1)
+    pts = rng.uniform(0.01, 0.99, (5000,3))
+    pts[0] = (2,0.5,0.5)
+    mp = mesh.LocatePoints(pts)
+    assert mp["nr"][0] == -1
+    ref = mesh(pts[1:,0], pts[1:,1], pts[1:,2])
+    vals = gfu(mp)
+    assert vals[0,0] == 0
+    assert np.max(np.abs(vals[1:] - gfu(ref))) < 1e-10
+    exact = pts[1:,0]**2 + pts[1:,1] - pts[1:,2]
+    assert np.max(np.abs(vals[1:,0] - exact)) < 1e-10
+
+    # slightly moved points, starting the search from the previous elements
+    pts2 = np.clip(pts + 0.01, 0, 1)
+    mp2 = mesh.LocatePoints(pts2, hints=mp["nr"])
+    ref2 = mesh(pts2[1:,0], pts2[1:,1], pts2[1:,2])
+    assert np.max(np.abs(gfu(mp2)[1:] - gfu(ref2))) < 1e-10
+
+    # the points need all coordinates of the mesh
+    with pytest.raises(Exception):
+        mesh.LocatePoints(pts[:,:2])
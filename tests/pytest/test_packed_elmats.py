@@ -0,0 +1,112 @@
+import pytest
+from ngsolve import *
+from netgen.geom2d import unit_square
+from netgen.csg import unit_cube
+
+
+def CompareSymmetric (fes, form, **kwargs):
+    # symmetric forms assemble from packed element matrices,
+    # the non-symmetric ones from full element matrices
+    asym = BilinearForm(fes, symmetric=True, **kwargs)
+    asym += form
+    asym.Assemble()
+    afull = BilinearForm(fes, symmetric=False, **kwargs)
+    afull += form
+    afull.Assemble()
+
+    x = asym.mat.CreateColVector()
+    x.SetRandom()
+    y1 = x.CreateVector()
+    y2 = x.CreateVector()
+    y1.data = asym.mat * x
+    y2.data = afull.mat * x
+    y2.data -= y1
+    assert Norm(y2) < 1e-10 * Norm(y1)
+
+
+@pytest.mark.parametrize("order", [1, 3, 6])
+def test_packed_laplace(order):
+    mesh = Mesh(unit_cube.GenerateMesh(maxh=0.4))
+    fes = H1(mesh, order=order)
+    u,v = fes.TnT()
+    CompareSymmetric (fes, grad(u)*grad(v)*dx + u*v*dx + 3*u*v*ds)
+
+
+def test_packed_fallback():
+    # matrix valued coefficient, vector valued space, compound space:
+    # integrators fall back to the full element matrix
+    mesh = Mesh(unit_square.GenerateMesh(maxh=0.2))
+    fes = H1(mesh, order=3)
+    u,v = fes.TnT()
+    A = CoefficientFunction((2, 1, 1, 3), dims=(2,2))
+    CompareSymmetric (fes, (A*grad(u))*grad(v)*dx)
+
+    fes = H1(mesh, order=2, dim=2)
+    u,v = fes.TnT()
+    CompareSymmetric (fes, InnerProduct(grad(u),grad(v))*dx + u*v*dx)
+
+    fes = H1(mesh, order=3) * H1(mesh, order=2)
+    (u1,u2), (v1,v2) = fes.TnT()
+    CompareSymmetric (fes, grad(u1)*grad(v1)*dx + u2*v2*dx + (u1*v2+u2*v1)*dx)
+
+
+def CompareOperators (op1, op2):
+    x = op1.CreateColVector()
+    x.SetRandom()
+    y1 = op1.CreateRowVector()
+    y2 = op1.CreateRowVector()
+    y1.data = op1 * x
+    y2.data = op2 * x
+    y2.data -= y1
+    assert Norm(y2) < 1e-10 * Norm(y1)
+
+
+def test_packed_condense():
+    mesh = Mesh(unit_cube.GenerateMesh(maxh=0.4))
+    fes = H1(mesh, order=4)
+    u,v = fes.TnT()
+    form = grad(u)*grad(v)*dx + u*v*ds
+    CompareSymmetric (fes, form, condense=True)
+    CompareSymmetric (fes, form, eliminate_internal=True, keep_internal=False)
+
+    # harmonic extension, inner solve and the modified right hand side
+    forms = []
+    for sym in [True, False]:
+        a = BilinearForm(fes, symmetric=sym, condense=True)
+        a += form
+        c = Preconditioner(a, "bddc")
+        a.Assemble()
+        forms.append((a, c))
+    (a1, c1), (a2, c2) = forms
+    CompareOperators (a1.harmonic_extension, a2.harmonic_extension)
+    CompareOperators (a1.inner_solve, a2.inner_solve)
+    CompareOperators (c1.mat, c2.mat)
+
+    f = LinearForm(fes)
+    f += x*v*dx
+    f.Assemble()
+    gfu1 = GridFunction(fes)
+    gfu2 = GridFunction(fes)
+    for gfu, (a, c) in zip([gfu1, gfu2], forms):
+        rhs = f.vec.CreateVector()
+        rhs.data = f.vec + a.harmonic_extension_trans * f.vec
+        gfu.vec.data = a.mat.Inverse(fes.FreeDofs(True)) * rhs
+        gfu.vec.data += a.harmonic_extension * gfu.vec
+        gfu.vec.data += a.inner_solve * f.vec
+    gfu2.vec.data -= gfu1.vec
+    assert Norm(gfu2.vec) < 1e-10 * Norm(gfu1.vec)
+
+
+def test_packed_transform():
+    # hcurl high order: the element matrix is transformed
+    mesh = Mesh(unit_cube.GenerateMesh(maxh=0.4))
+    fes = HCurl(mesh, order=3)
+    u,v = fes.TnT()
+    CompareSymmetric (fes, curl(u)*curl(v)*dx + u*v*dx)
+
+
+if __name__ == "__main__":
+    test_packed_laplace(3)
+    test_packed_fallback()
+    test_packed_condense()
+    test_packed_transform()
@@ -0,0 +1,46 @@
+import pytest
+from ngsolve import *
+from ngsolve.meshes import MakeStructured2DMesh, MakeStructured3DMesh
+
+
+def _compare_apply(mesh, order):
+    fes_tp = L2(mesh, order=order, tp=True)
+    fes = L2(mesh, order=order)
+    u,v = fes.TnT()
+    utp,vtp = fes_tp.TnT()
+    b = CoefficientFunction( (1,0.5,0.25)[:mesh.dim] )
+
+    a = BilinearForm(fes)
+    a += (grad(u)*grad(v) + (b*grad(u))*v + u*v) * dx
+    a.Assemble()
+
+    atp = BilinearForm(fes_tp, nonassemble=True)
+    atp += (grad(utp)*grad(vtp) + (b*grad(utp))*vtp + utp*vtp) * dx
+    atp.Assemble()
+
+    gf = GridFunction(fes)
+    gf.Set (sin(3*x)*(1+y*y))
+    y1 = gf.vec.CreateVector()
+    y2 = gf.vec.CreateVector()
+    y1.data = a.mat * gf.vec
+    y2.data = atp.mat * gf.vec
+    y1 -= y2
+    assert Norm(y1) < 1e-10 * Norm(y2)
+
+
+def test_sumfactorization_quad():
+    mesh = MakeStructured2DMesh(quads=True, nx=4, ny=4,
+                                mapping = lambda x,y : (x+0.1*y, y))
+    for order in [1,4,8]:
+        _compare_apply(mesh, order)
+
+
+def test_sumfactorization_hex():
+    mesh = MakeStructured3DMesh(hexes=True, nx=2, ny=2, nz=2)
+    for order in [1,4]:
+        _compare_apply(mesh, order)
+
+
+if __name__ == "__main__":
+    test_sumfactorization_quad()
+    test_sumfactorization_hex()
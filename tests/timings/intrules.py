@@ -0,0 +1,56 @@
+#
+# Compares standard (collapsed Gauss-Jacobi) and fully symmetric
+# integration rules on triangles and tetrahedra:
+# number of integration points and bilinear-form assembly time
+#
+from netgen.csg import unit_cube
+from netgen.geom2d import unit_square
+from ngsolve import *
+from ngsolve.fem import MaxSymmetricIntegrationOrder
+import json
+import time
+ngsglobals.msg_level=0
+
+import argparse
+parser = argparse.ArgumentParser(description='Compare standard and symmetric integration rules on simplices')
+parser.add_argument('-o', '--output', default='results_intrules.json', help='json output file')
+parser.add_argument('-r', '--repetitions', type=int, default=3, help='number of assemblies to time')
+args = parser.parse_args()
+
+results = { "points" : [], "assembly" : [] }
+
+print ("number of integration points:")
+print ("%5s %5s %10s %10s" % ("et", "order", "standard", "symmetric"))
+for et in [TRIG, TET]:
+    for order in range(MaxSymmetricIntegrationOrder(et)+1):
+        nstd = len(IntegrationRule(et, order, IntegrationRuleType.STANDARD))
+        nsym = len(IntegrationRule(et, order, IntegrationRuleType.SYMMETRIC))
+        print ("%5s %5d %10d %10d" % (str(et).split('.')[-1], order, nstd, nsym))
+        results["points"].append({ "et" : str(et), "order" : order,
+                                   "standard" : nstd, "symmetric" : nsym })
+
+
+def TimeAssembly (fes, intrule_type):
+    u,v = fes.TnT()
+    a = BilinearForm(fes)
+    a += (grad(u)*grad(v) + u*v) * dx(intrule_type=intrule_type)
+    a.Assemble()
+    t = time.time()
+    for i in range(args.repetitions):
+        a.Assemble()
+    return (time.time()-t) / args.repetitions
+
+
+print ("assembly time:")
+print ("%5s %5s %12s %12s %8s" % ("dim", "order", "standard", "symmetric", "speedup"))
+meshes = [Mesh(unit_square.GenerateMesh(maxh=0.05)), Mesh(unit_cube.GenerateMesh(maxh=0.2))]
+for mesh in meshes:
+    for order in [2,4,6,8]:
+        fes = H1(mesh, order=order)
+        tstd = TimeAssembly (fes, IntegrationRuleType.STANDARD)
+        tsym = TimeAssembly (fes, IntegrationRuleType.SYMMETRIC)
+        print ("%5d %5d %12.4g %12.4g %8.2f" % (mesh.dim, order, tstd, tsym, tstd/tsym))
+        results["assembly"].append({ "dimension" : mesh.dim, "order" : order, "ndof" : fes.ndof,
+                                     "standard" : tstd, "symmetric" : tsym })
+
+json.dump(results, open(args.output,'w'))
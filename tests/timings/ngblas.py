@@ -0,0 +1,145 @@
+#
+# Throughput of the ngblas kernels, compared with a roofline estimate.
+# Results are written as json, and optionally compared to the json of
+# an earlier run to detect kernel regressions:
+#
+#   python3 ngblas.py -o new.json -c old.json
+#
+import ngsolve.bla as bla
+from ngsolve import ngsglobals
+import socket
+import multiprocessing
+import json
+import os
+import sys
+ngsglobals.msg_level=0
+
+import argparse
+parser = argparse.ArgumentParser(description='Time the ngblas kernels')
+parser.add_argument('-o', '--output', default='results_ngblas.json', help='json output file')
+parser.add_argument('-c', '--compare', help='json file of an earlier run')
+parser.add_argument('-t', '--tolerance', type=float, default=0.1, help='relative slowdown reported as regression')
+parser.add_argument('--peak', type=float, help='peak GFlop/s (fma per second), measured if not given')
+parser.add_argument('--bandwidth', type=float, help='memory bandwidth in GB/s, measured if not given')
+parser.add_argument('-q', '--quick', action="store_true", help='fewer sizes')
+args = parser.parse_args()
+
+
+def Run (what, n, m, k):
+    return bla.__timing__(what, n, m, k)
+
+
+# cases: (what, entry point, variant, bytes moved, number of fmas)
+# the flop counts of __timing__ are fused multiply-adds (complex: 4 real ones)
+def gemm_bytes (n,m,k):
+    return 8*(n*m+m*k+2*n*k)
+
+def abt_bytes (n,m,k):
+    return 8*(n*k+m*k+2*n*m)
+
+cases = [
+    (5,   "MultMatVec",        "real",          lambda n,m,k: 8*(n*m+n+m),          lambda n,m,k: n*m),
+    (6,   "MultMatTransVec",   "real",          lambda n,m,k: 8*(n*m+n+m),          lambda n,m,k: n*m),
+    (10,  "MultMatMat",        "real",          gemm_bytes,                         lambda n,m,k: n*m*k),
+    (11,  "AddAB",             "real",          gemm_bytes,                         lambda n,m,k: n*m*k),
+    (12,  "MultMatMat",        "complex",       lambda n,m,k: 2*gemm_bytes(n,m,k),  lambda n,m,k: 4*n*m*k),
+    (13,  "MultMatMat",        "colmajor",      gemm_bytes,                         lambda n,m,k: n*m*k),
+    (50,  "AddABt",            "real",          abt_bytes,                          lambda n,m,k: n*m*k),
+    (51,  "AddABt",            "aligned",       abt_bytes,                          lambda n,m,k: n*m*k),
+    (53,  "AddABt",            "complex simd",  lambda n,m,k: 2*abt_bytes(n,m,k),   lambda n,m,k: 4*n*m*k),
+    (54,  "AddABt",            "real-complex simd", lambda n,m,k: 8*(n*k+2*m*k+4*n*m), lambda n,m,k: 2*n*m*k),
+    (60,  "SubAtDB",           "real",          lambda n,m,k: 8*(n*k+n*m+n+2*k*m),  lambda n,m,k: n*m*k),
+    (61,  "MultAtB",           "real",          lambda n,m,k: 8*(n*k+n*m+2*k*m),    lambda n,m,k: n*m*k),
+    (70,  "AddABtSym",         "simd",          abt_bytes,                          lambda n,m,k: n*m*k),
+    (200, "CalcInverse",       "ngbla",         lambda n,m,k: 16*n*n,               lambda n,m,k: n*n*n),
+    (220, "LUFactor",          "real",          lambda n,m,k: 16*n*n,               lambda n,m,k: n*n*n/3),
+    (221, "CholeskyFactor",    "real",          lambda n,m,k: 16*n*n,               lambda n,m,k: n*n*n/6),
+    (222, "LUInverse",         "real",          lambda n,m,k: 16*n*n,               lambda n,m,k: n*n*n),
+    (230, "BatchedMultMatMat", "real",          lambda n,m,k: 24*m*n*n,             lambda n,m,k: m*n*n*n),
+    (231, "BatchedLUFactor",   "real",          lambda n,m,k: 16*m*n*n,             lambda n,m,k: m*n*n*n/3),
+]
+
+if args.quick:
+    sizes = { "vec" : [(100,100,1), (1000,1000,1)],
+              "mat" : [(16,16,16), (128,128,128)],
+              "fac" : [(64,1,1), (512,1,1)],
+              "batch" : [(4,1000,1), (12,1000,1)] }
+else:
+    sizes = { "vec" : [(n,n,1) for n in [10,30,100,300,1000,3000]],
+              "mat" : [(n,n,n) for n in [4,8,12,16,24,32,64,128,256,512]] + [(n,n,8) for n in [64,256]],
+              "fac" : [(n,1,1) for n in [16,32,64,128,256,512,1024,2048]],
+              "batch" : [(n,1000,1) for n in [2,3,4,6,8,10,12,15,20]] }
+
+def Sizes (what):
+    if what in [5,6]: return sizes["vec"]
+    if what >= 230: return sizes["batch"]
+    if what >= 200: return sizes["fac"]
+    SW = 8    # k must be a multiple of the SIMD width for the SIMD cases
+    return [(n,m,max(SW,(k+SW-1)//SW*SW)) for n,m,k in sizes["mat"]]
+
+
+# machine balance: fma throughput from independent fma chains in registers,
+# bandwidth from a matrix-vector product much larger than the caches.
+# A comparison uses the machine balance of the earlier run, such that
+# both runs have the same rooflines
+old = None
+if args.compare:
+    old = json.load(open(args.compare,'r'))
+peak = args.peak
+if peak is None and old is not None:
+    peak = old["peak"]
+if peak is None:
+    peak = max(Run(4, 1, 1, 1)[0][1], Run(4, 1, 1, 1)[0][1])
+bandwidth = args.bandwidth
+if bandwidth is None and old is not None:
+    bandwidth = old["bandwidth"]
+if bandwidth is None:
+    # one matrix entry is read per fma
+    bandwidth = 8 * Run(5, 5000, 5000, 1)[0][1]
+
+print ("peak = %.1f GFlop/s (fma),  bandwidth = %.1f GB/s" % (peak, bandwidth))
+
+
+results = { "peak" : peak, "bandwidth" : bandwidth, "timings" : [] }
+if "CI_BUILD_REF" in os.environ:
+    results['commit'] = os.environ["CI_BUILD_REF"]
+build = {}
+build['compiler'] = "@CMAKE_CXX_COMPILER_ID@-@CMAKE_CXX_COMPILER_VERSION@"
+build['cxx_flags'] = "@CMAKE_CXX_FLAGS@ @NGSOLVE_COMPILE_OPTIONS@".strip()
+build['hostname'] = socket.gethostname()
+build['ncpus'] = multiprocessing.cpu_count()
+results['build'] = build
+
+print ("%-20s %-18s %6s %6s %6s %10s %10s %6s" % ("kernel", "variant", "n", "m", "k", "GFlop/s", "roofline", "eff"))
+for what, name, variant, traffic, flops in cases:
+    for n,m,k in Sizes(what):
+        res = Run(what, n, m, k)
+        if len(res) == 0: continue
+        gflops = res[0][1]
+        roofline = min(peak, bandwidth * flops(n,m,k) / traffic(n,m,k))
+        print ("%-20s %-18s %6d %6d %6d %10.2f %10.2f %6.2f" % (name, variant, n, m, k, gflops, roofline, gflops/roofline))
+        results["timings"].append({ "what" : what, "name" : name, "variant" : variant,
+                                    "n" : n, "m" : m, "k" : k,
+                                    "gflops" : gflops, "roofline" : roofline })
+
+json.dump(results, open(args.output,'w'), indent=1)
+
+
+if old is not None:
+    oldtimings = { (t["what"],t["n"],t["m"],t["k"]) : t for t in old["timings"] }
+    regressions = []
+    for t in results["timings"]:
+        key = (t["what"],t["n"],t["m"],t["k"])
+        if key not in oldtimings: continue
+        # efficiencies w.r.t. the old roofline, i.e. the raw GFlop/s compared
+        roofline = oldtimings[key]["roofline"]
+        eff = t["gflops"] / roofline
+        oldeff = oldtimings[key]["gflops"] / roofline
+        if eff < (1-args.tolerance) * oldeff:
+            regressions.append((t, oldeff, eff))
+    for t, oldeff, eff in regressions:
+        print ("regression: %s %s n=%d m=%d k=%d   efficiency %.2f -> %.2f"
+               % (t["name"], t["variant"], t["n"], t["m"], t["k"], oldeff, eff))
+    if regressions:
+        sys.exit(1)
+    print ("no regressions compared to", args.compare)